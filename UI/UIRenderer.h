@@ -20,9 +20,30 @@ namespace ZE
 		virtual void* getWindowContext() = 0;
 		virtual UInt32 createRendererTexture(void* pAddress, UInt32 width, UInt32 height, UInt32 channelCount) = 0;
 		virtual void destroyTexture(UInt32 textureHandle) = 0;
+
+		// Replace area of texture from createRendererTexture with same channel count, return false if not supported
+		virtual bool updateRendererTexture(UInt32 /*textureHandle*/, void* /*pAddress*/, UInt32 /*x*/, UInt32 /*y*/, UInt32 /*width*/, UInt32 /*height*/, UInt32 /*channelCount*/) { return false; }
 		virtual void destroyTextures() = 0;
 		virtual void resizeWindow(int width, int height) = 0;
+
+		// Handle window events when frame is skipped. Default presents current draw list again, like renderers that poll while drawing.
+		virtual void pollEvents() { ProcessCurrentDrawList(); }
+
+		// Block until an event arrives or timeout (negative waits forever). Default returns immediately.
+		virtual void waitEvents(Float32 /*timeoutMS*/) {}
+
+		// Wake up waitEvents from another thread
+		virtual void postEmptyEvent() {}
+
+		// Offscreen render target, return texture handle usable in draw items or 0 if not supported
+		virtual UInt32 createRenderTarget(UInt32 /*width*/, UInt32 /*height*/) { return 0; }
+		virtual void destroyRenderTarget(UInt32 /*textureHandle*/) {}
+
+		// Render draw list into render target before current draw list. Rect is the screen area the target covers.
+		virtual void renderToTarget(UInt32 /*textureHandle*/, UIDrawList* /*drawList*/, const UIRect& /*rect*/) {}
+
 		void setDrawList(UIDrawList* _drawList) { m_drawList = _drawList; }
+		UIDrawList* getDrawList() const { return m_drawList; }
 
 	protected:
 		UIDrawList* m_drawList;
@@ -10,9 +10,28 @@
 
 #include "External/Image/stb_image.h"
 
+#include <algorithm>
+
+#include <atomic>
+
+#if defined(ZUI_USE_SIMD_CLIP) && (defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1))
+#include <xmmintrin.h>
+#define ZUI_CLIP_SSE
+#elif defined(ZUI_USE_SIMD_CLIP) && (defined(__ARM_NEON) || defined(__ARM_NEON__))
+#include <arm_neon.h>
+#define ZUI_CLIP_NEON
+#endif
+
+#if defined(ZUI_USE_ASYNC_LIST_LOADER) || defined(ZUI_USE_ASYNC_TABLE_SORT)
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#endif
+
 #define UIMEM_CPY(Dst, Src, _Size) memcpy(Dst, Src, _Size)
 #define UIMEM_MOVE(Dst, Src, _Size) memmove(Dst, Src, _Size)
 #define UIMEM_ZERO(Dst, _Size) memset(Dst, 0, _Size)
+#define UIMEM_SET(Dst, Value, _Size) memset(Dst, Value, _Size)
 #define UIMAX(a, b) (a > b ? (a) : (b))
 #define UIMIN(a, b) (a < b ? (a) : (b))
 #define UICLAMP(a, b, v) UIMAX( a, UIMIN(b, v) )
@@ -99,11 +118,35 @@ namespace ZE
 		return ComputeHashData(&pData, sizeof(void*), seed);
 	}
 
+	// Every draw call gets its own draw item, so items of a panel or layout node are a contiguous range of draw list.
+	// Needed by panel cache and by layout to move drawn widgets.
+#if !defined(ZUI_GROUP_PER_TEXTURE) && (!defined(ZUI_USE_FONT_INSTANCING) || defined(ZUI_USE_SINGLE_TEXT_ONLY))
+	#define ZUI_DRAW_ITEM_PER_DRAW_CALL
+#endif
+
 	// Cache Id : Basically just prev active id
 	UInt32 cacheId;
 
+	// Stop item list loader and destroy item caches of virtual list views
+	void DestroyItemListCaches();
+
+	// Stop and destroy sort jobs of tables
+	void DestroyTableSortJobs();
+
+	// Release textures and draw lists of cached panels
+	void DestroyPanelCaches();
+
+	// Layouts of widgets that weren't drawn for WidgetLayoutLifetime frames are removed
+	const UInt32 WidgetLayoutLifetime = 120;
+
+	// Remove some of widget states that weren't used for a while, called every frame
+	void CollectWidgetStates();
+
 	UIState UI::MainUIState;
 
+	// Set from any thread to force next frame to be rendered
+	static std::atomic<bool> RedrawRequested(false);
+
 	UIButtonStyle UI::DefaultButtonStyle;
 	UIImageButtonStyle UI::DefaultImageButtonStyle;
 	UIImageButtonStyle UI::DefaultCheckBoxStyle;
@@ -116,6 +159,9 @@ namespace ZE
 	UIMenuStyle UI::DefaultMenuStyle;
 	UIMenuStyle UI::DefaultSubMenuStyle;
 	UIScrollBarStyle UI::DefaultScrollBarStyle;
+	UITableStyle UI::DefaultTableStyle;
+	UITreeStyle UI::DefaultTreeStyle;
+	UILayoutStyle UI::DefaultLayoutStyle;
 
 	UIStack<UInt32> UI::StackIDs;
 
@@ -140,6 +186,133 @@ namespace ZE
 		return MainUIState.renderer;
 	}
 
+	namespace UI
+	{
+		// Helper function: Round to nearest 16 bit step, clamped to range
+		Int16 ToInt16(Float32 value)
+		{
+			const Float32 rounded = floorf(value + 0.5f);
+			return (Int16)(rounded < -32768.0f ? -32768.0f : (rounded > 32767.0f ? 32767.0f : rounded));
+		}
+
+		Int16 ToSNorm16(Float32 value)
+		{
+			return ToInt16((value < -1.0f ? -1.0f : (value > 1.0f ? 1.0f : value)) * 32767.0f);
+		}
+
+		UInt8 ToUNorm8(Float32 value)
+		{
+			return (UInt8)floorf((value < 0.0f ? 0.0f : (value > 1.0f ? 1.0f : value)) * 255.0f + 0.5f);
+		}
+	}
+
+	UIPackedDrawInstance::UIPackedDrawInstance(const UIDrawInstance& instance)
+	{
+		const Float32 scale = 1.0f / PositionUnit;
+		pos[0] = UI::ToInt16(instance.pos.x * scale);
+		pos[1] = UI::ToInt16(instance.pos.y * scale);
+		depth = instance.depth;
+		dimension[0] = UI::ToInt16(instance.dimension.x * scale);
+		dimension[1] = UI::ToInt16(instance.dimension.y * scale);
+		dimension[2] = UI::ToInt16(instance.radius * scale);
+		dimension[3] = 0;
+		color[0] = UI::ToUNorm8(instance.color.x);
+		color[1] = UI::ToUNorm8(instance.color.y);
+		color[2] = UI::ToUNorm8(instance.color.z);
+		color[3] = UI::ToUNorm8(instance.color.w);
+		uvDim[0] = UI::ToSNorm16(instance.uvDim.x);
+		uvDim[1] = UI::ToSNorm16(instance.uvDim.y);
+		uvDim[2] = UI::ToSNorm16(instance.uvDim.z);
+		uvDim[3] = UI::ToSNorm16(instance.uvDim.w);
+		clip[0] = UI::ToInt16(instance.clip.x * scale);
+		clip[1] = UI::ToInt16(instance.clip.y * scale);
+		clip[2] = UI::ToInt16(instance.clip.z * scale);
+		clip[3] = UI::ToInt16(instance.clip.w * scale);
+
+		// Tiny crop box must not turn into no crop
+		if (instance.clip.z > 0.0f && clip[2] == 0) { clip[2] = 1; }
+	}
+
+	UIPackedInstanceInsets::UIPackedInstanceInsets(const UIInstanceInsets& instanceInsets)
+	{
+		const Float32 scale = 1.0f / UIPackedDrawInstance::PositionUnit;
+		insets[0] = UI::ToInt16(instanceInsets.x * scale);
+		insets[1] = UI::ToInt16(instanceInsets.y * scale);
+		insets[2] = UI::ToInt16(instanceInsets.z * scale);
+		insets[3] = UI::ToInt16(instanceInsets.w * scale);
+	}
+
+	const ZE::UIRenderInstance* UI::GetRenderInstances(const UIArray<UIDrawInstance>& instances, UIArray<UIRenderInstance>& packBuffer)
+	{
+#if defined(ZUI_USE_PACKED_INSTANCES)
+		packBuffer.resize(instances.size());
+		for (size_t i = 0; i < instances.size(); i++)
+		{
+			packBuffer[i] = UIPackedDrawInstance(instances[i]);
+		}
+		return packBuffer.data();
+#else
+		// Full size instances are already in render format
+		(void)packBuffer;
+		return instances.data();
+#endif
+	}
+
+	const ZE::UIRenderInstanceInsets* UI::GetRenderInstanceInsets(const UIArray<UIInstanceInsets>& instanceInsets, size_t instanceCount, UIArray<UIRenderInstanceInsets>& packBuffer)
+	{
+#if !defined(ZUI_USE_PACKED_INSTANCES)
+		if (instanceInsets.size() >= instanceCount)
+		{
+			return instanceInsets.data();
+		}
+#endif
+		packBuffer.resize(instanceCount);
+		const size_t count = instanceInsets.size() < instanceCount ? instanceInsets.size() : instanceCount;
+		for (size_t i = 0; i < count; i++)
+		{
+			packBuffer[i] = UIRenderInstanceInsets(instanceInsets[i]);
+		}
+		for (size_t i = count; i < instanceCount; i++)
+		{
+			packBuffer[i] = UIRenderInstanceInsets(UIInstanceInsets(0.0f));
+		}
+		return packBuffer.data();
+	}
+
+	ZE::Float32 UI::GetRenderInstanceUnit()
+	{
+#if defined(ZUI_USE_PACKED_INSTANCES)
+		return UIPackedDrawInstance::PositionUnit;
+#else
+		return 1.0f;
+#endif
+	}
+
+	void UI::FillQuadIndices(UInt16* indices, UInt32 quadCount)
+	{
+		for (UInt32 i = 0; i < quadCount; i++)
+		{
+			const UInt16 base = static_cast<UInt16>(i * 4);
+			indices[0] = base;
+			indices[1] = base + 1;
+			indices[2] = base + 2;
+			indices[3] = base;
+			indices[4] = base + 2;
+			indices[5] = base + 3;
+			indices += QuadIndexCount;
+		}
+	}
+
+	const ZE::UIFrameStats& UI::GetFrameStats()
+	{
+		return MainUIState.frameStats;
+	}
+
+	const ZE::UIIdleStats& UI::GetIdleStats()
+	{
+		return MainUIState.idleStats;
+	}
+
 	UIFont* UI::DefaultFont = nullptr;
 
 	ZE::UInt32 UI::GetUIIDFromString(const UIChar* textData, UInt32 length)
@@ -155,27 +328,58 @@ namespace ZE
 		return ComputeHashPointer(pData, parent);
 	}
 
-	void UI::PushDrawRect(const UIRect& rect)
+	namespace UI
 	{
-		if (MainUIState.DrawRectStack.size() == 0)
+		// Helper function: Min/max box of rect
+		inline UIClipBox GetClipBox(const UIRect& rect)
 		{
-			MainUIState.DrawRectStack.push_back(rect);
+			return UIClipBox{ rect.m_pos.x, rect.m_pos.y, rect.m_pos.x + rect.m_dimension.x, rect.m_pos.y + rect.m_dimension.y };
 		}
-		else
+
+		// Helper function: Rect overlaps or touches clip box. No early out, so no branch per side.
+		inline bool IsRectInClipBox(const UIClipBox& box, const UIRect& rect)
+		{
+			return (rect.m_pos.x <= box.maxX) & (rect.m_pos.y <= box.maxY)
+				& (rect.m_pos.x + rect.m_dimension.x >= box.minX) & (rect.m_pos.y + rect.m_dimension.y >= box.minY);
+		}
+
+		inline bool IsPointInClipBox(const UIClipBox& box, const UIVector2& pos)
+		{
+			return (pos.x >= box.minX) & (pos.x <= box.maxX) & (pos.y >= box.minY) & (pos.y <= box.maxY);
+		}
+	}
+
+	void UI::PushDrawRect(const UIRect& rect)
+	{
+		UIClipBox box = GetClipBox(rect);
+		if (MainUIState.ClipBoxStack.size() > 0)
 		{
-			MainUIState.DrawRectStack.push_back(MainUIState.DrawRectStack.back().intersect(rect));
+			const UIClipBox& parentBox = MainUIState.ClipBoxStack.back();
+			box.minX = UIMAX(box.minX, parentBox.minX);
+			box.minY = UIMAX(box.minY, parentBox.minY);
+			box.maxX = UIMIN(box.maxX, parentBox.maxX);
+			box.maxY = UIMIN(box.maxY, parentBox.maxY);
+
+			// Nothing left visible: keep an empty box
+			box.maxX = UIMAX(box.maxX, box.minX);
+			box.maxY = UIMAX(box.maxY, box.minY);
 		}
+
+		MainUIState.ClipBoxStack.push_back(box);
+		MainUIState.DrawRectStack.push_back(UIRect(UIVector2(box.minX, box.minY), UIVector2(box.maxX - box.minX, box.maxY - box.minY), rect.m_roundness));
 	}
 
 	void UI::PopDrawRect()
 	{
 		UIASSERT(MainUIState.DrawRectStack.size() > 0, "DrawRectStack is empty, but trying to pop! Possibly missing EndPanel or EndListView.");
 		MainUIState.DrawRectStack.pop_back();
+		MainUIState.ClipBoxStack.pop_back();
 	}
 
 	void UI::ClearDrawRect()
 	{
 		MainUIState.DrawRectStack.clear();
+		MainUIState.ClipBoxStack.clear();
 	}
 
 	ZE::UIRect UI::CalculateInteractionRect(const UIRect& rect)
@@ -185,12 +389,225 @@ namespace ZE
 
 	bool UI::CheckMouseInside(const UIRect& rect)
 	{
-		return rect.isContain(MainUIState.mousePos) && (MainUIState.DrawRectStack.size() == 0 || MainUIState.DrawRectStack.back().isContain(MainUIState.mousePos));
+		return rect.isContain(MainUIState.mousePos) && (MainUIState.ClipBoxStack.size() == 0 || IsPointInClipBox(MainUIState.ClipBoxStack.back(), MainUIState.mousePos));
+	}
+
+	bool UI::CheckMouseHover(UInt32 _id, const UIRect& rect, Int32 layer /*= -1*/)
+	{
+		if (!MainUIState.bHitGrid)
+		{
+			return CheckMouseInside(rect);
+		}
+
+		// Only visible part of rect can be hit
+		UIHitRect hitRect;
+		hitRect.rect = rect;
+		if (MainUIState.ClipBoxStack.size() > 0)
+		{
+			const UIClipBox& clipBox = MainUIState.ClipBoxStack.back();
+			const Float32 rectMaxX = rect.m_pos.x + rect.m_dimension.x;
+			const Float32 rectMaxY = rect.m_pos.y + rect.m_dimension.y;
+			const Float32 minX = UIMAX(rect.m_pos.x, clipBox.minX);
+			const Float32 minY = UIMAX(rect.m_pos.y, clipBox.minY);
+			const Float32 maxX = UIMIN(rectMaxX, clipBox.maxX);
+			const Float32 maxY = UIMIN(rectMaxY, clipBox.maxY);
+			hitRect.rect = UIRect(UIVector2(minX, minY), UIVector2(maxX - minX, maxY - minY));
+		}
+
+		hitRect.id = _id;
+		hitRect.layer = layer < 0 ? MainUIState.drawer->GetLayer() : layer;
+		if (hitRect.rect.m_dimension.x > 0.0f && hitRect.rect.m_dimension.y > 0.0f)
+		{
+			MainUIState.hitRects.push_back(hitRect);
+		}
+
+		// Active widget keeps the mouse. Fall back to plain rect test when nothing was under mouse last frame,
+		// or widget is on a higher layer than what was there (popup just opened).
+		const bool bTopmost = MainUIState.hoveredId == _id || MainUIState.hoveredId == 0 || MainUIState.activeItem.id == _id || hitRect.layer > MainUIState.hoveredLayer;
+		return bTopmost && CheckMouseInside(rect);
+	}
+
+	namespace UI
+	{
+		// Helper function: Range of grid cells covered by rect. Return false if rect is outside of grid.
+		bool GetHitGridCells(const UIRect& rect, Int32& minX, Int32& minY, Int32& maxX, Int32& maxY)
+		{
+			const Float32 invCellSize = 1.0f / ZUI_HIT_GRID_CELL_SIZE;
+			minX = (Int32)floorf(rect.m_pos.x * invCellSize);
+			minY = (Int32)floorf(rect.m_pos.y * invCellSize);
+			maxX = (Int32)floorf((rect.m_pos.x + rect.m_dimension.x) * invCellSize);
+			maxY = (Int32)floorf((rect.m_pos.y + rect.m_dimension.y) * invCellSize);
+
+			if (maxX < 0 || maxY < 0 || minX >= MainUIState.hitGridColumns || minY >= MainUIState.hitGridRows) { return false; }
+
+			if (minX < 0) { minX = 0; }
+			if (minY < 0) { minY = 0; }
+			if (maxX >= MainUIState.hitGridColumns) { maxX = MainUIState.hitGridColumns - 1; }
+			if (maxY >= MainUIState.hitGridRows) { maxY = MainUIState.hitGridRows - 1; }
+			return true;
+		}
+
+		// Helper function: Bucket previous frame's interaction rects into grid cells (counting sort, so entries keep record order)
+		void BuildHitGrid()
+		{
+			const Int32 cellSize = ZUI_HIT_GRID_CELL_SIZE;
+			MainUIState.hitGridColumns = (MainUIState.screenWidth + cellSize - 1) / cellSize;
+			MainUIState.hitGridRows = (MainUIState.screenHeight + cellSize - 1) / cellSize;
+
+			const Int32 cellCount = MainUIState.hitGridColumns * MainUIState.hitGridRows;
+			UIArray<UInt32>& cellStart = MainUIState.hitGridCellStart;
+			UIArray<UInt32>& entries = MainUIState.hitGridEntries;
+			cellStart.assign(cellCount + 1, 0);
+			entries.clear();
+
+			const UIArray<UIHitRect>& hitRects = MainUIState.lastHitRects;
+			Int32 minX, minY, maxX, maxY;
+
+			// Count entries of each cell
+			for (const UIHitRect& hitRect : hitRects)
+			{
+				if (!GetHitGridCells(hitRect.rect, minX, minY, maxX, maxY)) { continue; }
+				for (Int32 y = minY; y <= maxY; y++)
+				{
+					for (Int32 x = minX; x <= maxX; x++)
+					{
+						cellStart[y * MainUIState.hitGridColumns + x + 1]++;
+					}
+				}
+			}
+
+			for (Int32 i = 1; i <= cellCount; i++)
+			{
+				cellStart[i] += cellStart[i - 1];
+			}
+
+			// Fill cells, cellStart[i] is moved to end of cell i and shifted back after
+			entries.resize(cellStart[cellCount]);
+			for (UInt32 index = 0; index < (UInt32)hitRects.size(); index++)
+			{
+				if (!GetHitGridCells(hitRects[index].rect, minX, minY, maxX, maxY)) { continue; }
+				for (Int32 y = minY; y <= maxY; y++)
+				{
+					for (Int32 x = minX; x <= maxX; x++)
+					{
+						entries[cellStart[y * MainUIState.hitGridColumns + x]++] = index;
+					}
+				}
+			}
+
+			for (Int32 i = cellCount; i > 0; i--)
+			{
+				cellStart[i] = cellStart[i - 1];
+			}
+			cellStart[0] = 0;
+		}
+
+		// Helper function: Find topmost interaction rect under mouse. Higher layer wins, then later record in same layer.
+		void ResolveHoveredId()
+		{
+			MainUIState.hoveredId = 0;
+			MainUIState.hoveredLayer = 0;
+			if (!MainUIState.bHitGrid || MainUIState.hitGridEntries.size() == 0) { return; }
+
+			const UIVector2& mousePos = MainUIState.mousePos;
+			if (mousePos.x < 0.0f || mousePos.y < 0.0f) { return; }
+
+			const Int32 cellX = (Int32)(mousePos.x / ZUI_HIT_GRID_CELL_SIZE);
+			const Int32 cellY = (Int32)(mousePos.y / ZUI_HIT_GRID_CELL_SIZE);
+			if (cellX >= MainUIState.hitGridColumns || cellY >= MainUIState.hitGridRows) { return; }
+
+			const Int32 cell = cellY * MainUIState.hitGridColumns + cellX;
+			Int32 topLayer = -1;
+			for (UInt32 i = MainUIState.hitGridCellStart[cell]; i < MainUIState.hitGridCellStart[cell + 1]; i++)
+			{
+				const UIHitRect& hitRect = MainUIState.lastHitRects[MainUIState.hitGridEntries[i]];
+				if (hitRect.layer >= topLayer && hitRect.rect.isContain(mousePos))
+				{
+					topLayer = hitRect.layer;
+					MainUIState.hoveredId = hitRect.id;
+					MainUIState.hoveredLayer = hitRect.layer;
+				}
+			}
+		}
+	}
+
+	void UI::SetHitGrid(bool bEnable)
+	{
+		MainUIState.bHitGrid = bEnable;
+		MainUIState.hitRects.clear();
+		MainUIState.lastHitRects.clear();
+		MainUIState.hitGridEntries.clear();
+		MainUIState.hoveredId = 0;
+		MainUIState.hoveredLayer = 0;
 	}
 
 	bool UI::ShouldDrawRect(const UIRect& rect)
 	{
-		return MainUIState.DrawRectStack.size() == 0 || MainUIState.DrawRectStack.back().hasIntersectWith(rect);
+		return MainUIState.ClipBoxStack.size() == 0 || IsRectInClipBox(MainUIState.ClipBoxStack.back(), rect);
+	}
+
+	Int32 UI::CullRects(const UIRect* rects, Int32 count, UInt8* outVisible)
+	{
+		if (MainUIState.ClipBoxStack.size() == 0)
+		{
+			UIMEM_SET(outVisible, 1, count);
+			return count;
+		}
+
+		const UIClipBox& box = MainUIState.ClipBoxStack.back();
+		Int32 visibleCount = 0;
+
+#if defined(ZUI_CLIP_SSE)
+		// One rect per iteration, all four side tests in one compare:
+		// (x + w, y + h, maxX, maxY) >= (minX, minY, x, y)
+		const __m128 clipMin = _mm_setr_ps(box.minX, box.minY, 0.0f, 0.0f);
+		const __m128 clipMax = _mm_setr_ps(box.maxX, box.maxY, 0.0f, 0.0f);
+		for (Int32 i = 0; i < count; i++)
+		{
+			const __m128 rect = _mm_loadu_ps(&rects[i].m_pos.x);
+			const __m128 pos = _mm_movelh_ps(rect, rect);
+			const __m128 end = _mm_add_ps(pos, _mm_movehl_ps(rect, rect));
+			const __m128 ge = _mm_cmpge_ps(_mm_movelh_ps(end, clipMax), _mm_movelh_ps(clipMin, pos));
+			outVisible[i] = _mm_movemask_ps(ge) == 0xF;
+			visibleCount += outVisible[i];
+		}
+#elif defined(ZUI_CLIP_NEON)
+		const float32x2_t clipMin = vld1_f32(&box.minX);
+		const float32x2_t clipMax = vld1_f32(&box.maxX);
+		for (Int32 i = 0; i < count; i++)
+		{
+			const float32x4_t rect = vld1q_f32(&rects[i].m_pos.x);
+			const float32x2_t pos = vget_low_f32(rect);
+			const float32x2_t end = vadd_f32(pos, vget_high_f32(rect));
+			const uint32x4_t ge = vcgeq_f32(vcombine_f32(end, clipMax), vcombine_f32(clipMin, pos));
+			const uint32x2_t both = vand_u32(vget_low_u32(ge), vget_high_u32(ge));
+			outVisible[i] = (vget_lane_u32(both, 0) & vget_lane_u32(both, 1)) != 0;
+			visibleCount += outVisible[i];
+		}
+#else
+		for (Int32 i = 0; i < count; i++)
+		{
+			outVisible[i] = IsRectInClipBox(box, rects[i]);
+			visibleCount += outVisible[i];
+		}
+#endif
+
+		return visibleCount;
+	}
+
+	namespace UI
+	{
+		// Extent for text sides that are unknown before measuring
+		const Float32 TextUnboundedExtent = 1.0e30f;
+
+		// Helper function: Conservative test of text bounds against current draw rect, used to cull text before measuring it
+		bool IsTextCulled(Float32 left, Float32 top, Float32 right, Float32 bottom)
+		{
+			if (MainUIState.ClipBoxStack.size() == 0) { return false; }
+
+			const UIClipBox& clipBox = MainUIState.ClipBoxStack.back();
+			return (left > clipBox.maxX) | (right < clipBox.minX) | (top > clipBox.maxY) | (bottom < clipBox.minY);
+		}
 	}
 
 	// Helper function: Get Length of the UIChar buffer
@@ -218,6 +635,33 @@ namespace ZE
 		MainUIState.renderer->Init(width, height);
 
 		MainUIState.timeFromStart = 0.0f;
+		MainUIState.panelCacheBytes = 0;
+		MainUIState.frameCount = 0;
+		MainUIState.bRenderTargetUnsupported = false;
+#ifdef ZUI_USE_LAYOUT_CACHE
+		MainUIState.bLayoutCache = true;
+#else
+		MainUIState.bLayoutCache = false;
+#endif
+		MainUIState.bHasNextLayoutItem = false;
+		MainUIState.layoutRootCount = 0;
+		MainUIState.layoutNodeCount = 0;
+		MainUIState.widgetDepth = 0;
+		MainUIState.lastLayoutNodeCount = 0;
+#ifdef ZUI_USE_HIT_GRID
+		MainUIState.bHitGrid = true;
+#else
+		MainUIState.bHitGrid = false;
+#endif
+		MainUIState.hoveredId = 0;
+		MainUIState.hoveredLayer = 0;
+		MainUIState.hitGridColumns = 0;
+		MainUIState.hitGridRows = 0;
+#ifdef ZUI_USE_PARTIAL_REDRAW
+		MainUIState.bPartialRedraw = true;
+#else
+		MainUIState.bPartialRedraw = false;
+#endif
 		MainUIState.textTempLength = TEXT_TEMP_LENGTH;
 		MainUIState.textTempBuffer = UINEW(UIChar[TEXT_TEMP_LENGTH]);
 
@@ -324,6 +768,7 @@ namespace ZE
 
 		// Default Panel Style
 		DefaultPanelStyle.headerHeight = 20.0f;
+		DefaultPanelStyle.contentPadding = { 10.0f, 5.0f, 30.0f, 5.0f };
 #ifdef ZUI_STYLE_USE_NO_TEXTURE
 		DefaultPanelStyle.headerColor = { 0.2f, 0.2f, 0.5f, 1.0f };
 		DefaultPanelStyle.fillColor = { 0.2f, 0.2f, 0.2f, 1.0f };
@@ -437,6 +882,37 @@ namespace ZE
 		DefaultScrollBarStyle.scrollLineSize = 3.0f;
 		DefaultScrollBarStyle.scrollButtonSize = 5.0f;
 
+		// Default Table Style
+		DefaultTableStyle.headerFontStyle.font = DefaultFont;
+		DefaultTableStyle.headerFontStyle.fontScale = 1.0f;
+		DefaultTableStyle.cellFontStyle.font = DefaultFont;
+		DefaultTableStyle.cellFontStyle.fontScale = 1.0f;
+		DefaultTableStyle.headerColor = UIVector4(0.2f, 0.2f, 0.2f, 1.0f);
+		DefaultTableStyle.headerHoverColor = COLOR_BLUE_HOVERED;
+		DefaultTableStyle.rowColor = UIVector4(0.12f, 0.12f, 0.12f, 1.0f);
+		DefaultTableStyle.alternateRowColor = UIVector4(0.15f, 0.15f, 0.15f, 1.0f);
+		DefaultTableStyle.textColor = COLOR_WHITE;
+		DefaultTableStyle.resizeHandleColor = COLOR_BLUE_SELECTION;
+		DefaultTableStyle.cellPadding = 4.0f;
+		DefaultTableStyle.resizeHandleSize = 6.0f;
+		DefaultTableStyle.minColumnWidth = 20.0f;
+
+		// Default Tree Style
+		DefaultTreeStyle.fontStyle.font = DefaultFont;
+		DefaultTreeStyle.fontStyle.fontScale = 1.0f;
+		DefaultTreeStyle.textColor = COLOR_WHITE;
+		DefaultTreeStyle.selectionColor = COLOR_BLUE_SELECTION;
+		DefaultTreeStyle.hoverColor = COLOR_BLUE_HOVERED;
+		DefaultTreeStyle.arrowSize = { 12.0f, 12.0f };
+		DefaultTreeStyle.indentSize = 15.0f;
+		DefaultTreeStyle.rowPadding = 2.0f;
+
+		// Default Layout Style
+		DefaultLayoutStyle.padding = { 0.0f, 0.0f, 0.0f, 0.0f };
+		DefaultLayoutStyle.spacing = 5.0f;
+		DefaultLayoutStyle.mainAlign = LAYOUT_ALIGN_START;
+		DefaultLayoutStyle.crossAlign = LAYOUT_ALIGN_START;
+
 		// Push 0 as default stack id
 		StackIDs.push_back(0);
 	}
@@ -450,10 +926,16 @@ namespace ZE
 
 		MainUIState.screenWidth = width;
 		MainUIState.screenHeight = height;
+
+		RequestRedraw();
 	}
 
 	void UI::Destroy()
 	{
+		DestroyItemListCaches();
+		DestroyTableSortJobs();
+		DestroyPanelCaches();
+
 		UITextureManager::Destroy();
 
 		if (MainUIState.renderer)
@@ -477,28 +959,151 @@ namespace ZE
 	{
 		MainUIState.drawer->Reset();
 		MainUIState.timeFromStart += MainUIState.mainTimer.ResetAndGetDeltaMS();
+		MainUIState.frameStats = UIFrameStats();
+		MainUIState.frameCount++;
+		CollectWidgetStates();
+		MainUIState.lastLayoutNodes.swap(MainUIState.layoutNodes);
+		MainUIState.lastLayoutNodeCount = MainUIState.layoutNodeCount;
+		MainUIState.layoutNodeCount = 0;
+		MainUIState.layoutStack.clear();
+		MainUIState.layoutRootCount = 0;
+		MainUIState.bHasNextLayoutItem = false;
+		MainUIState.lastPanelDrawInfos.swap(MainUIState.panelDrawInfos);
+		MainUIState.panelDrawInfos.clear();
+		MainUIState.hitRects.clear();
+		ResolveHoveredId();
 		ClearDrawRect();
 	}
 
 	void UI::EndFrame()
 	{
-		MainUIState.renderer->setDrawList(MainUIState.drawer->getCurrentDrawList());
+		UIDrawList* drawList = MainUIState.drawer->getCurrentDrawList();
+
+		// Idle frame: no input and same output as previous frame
+		const bool bRedrawRequested = RedrawRequested.exchange(false);
+		const UIRect screenRect(UIVector2(0.0f), UIVector2((Float32)MainUIState.screenWidth, (Float32)MainUIState.screenHeight));
+		const UInt32 drawListHash = drawList->updateDamage(MainUIState.drawItemRecords, screenRect, bRedrawRequested || !MainUIState.bPartialRedraw);
+		MainUIState.bDrawListChanged = bRedrawRequested || drawListHash != MainUIState.drawListHash;
+		MainUIState.bIdleFrame = !MainUIState.bDrawListChanged && !MainUIState.bInputChanged;
+		MainUIState.bInputChanged = false;
+		MainUIState.drawListHash = drawListHash;
+		drawList->sortItems();
+
+		if (MainUIState.bHitGrid)
+		{
+			MainUIState.lastHitRects.swap(MainUIState.hitRects);
+			BuildHitGrid();
+		}
+
+		MainUIState.renderer->setDrawList(drawList);
 		MainUIState.drawer->SwapBuffer();
 		MainUIState.UseScrollOffset();
 	}
 
+	bool UI::WaitForEvents(Float32 timeoutMS /*= -1.0f*/)
+	{
+		if (!MainUIState.bIdleFrame || MainUIState.bInputChanged || RedrawRequested.load())
+		{
+			return false;
+		}
+
+		MainUIState.idleStats.idleWaits++;
+		MainUIState.renderer->waitEvents(timeoutMS);
+		return true;
+	}
+
+	void UI::RequestRedraw()
+	{
+		RedrawRequested.store(true);
+		if (MainUIState.renderer)
+		{
+			MainUIState.renderer->postEmptyEvent();
+		}
+	}
+
+	void UI::SetPartialRedraw(bool bEnable)
+	{
+		MainUIState.bPartialRedraw = bEnable;
+	}
+
+	void UI::SetLayoutCache(bool bEnable)
+	{
+		MainUIState.bLayoutCache = bEnable;
+		MainUIState.widgetLayouts.clear();
+	}
+
+	namespace UI
+	{
+		// Helper function: Size of widget label, only measured when widget is new or its inputs changed.
+		// Widget id already hashes the label, input hash covers the rest.
+		UIVector2 GetWidgetLabelSize(UInt32 _id, const UIChar* text, UIFont* font, Float32 scale, UInt32 inputHash = 0)
+		{
+			if (!MainUIState.bLayoutCache)
+			{
+				return UIVector2(font->calculateTextLength(text, scale), font->calculateTextHeight(scale));
+			}
+
+			inputHash = ComputeHashPointer(font, inputHash);
+			inputHash = ComputeHashData((void*)&scale, sizeof(Float32), inputHash);
+
+			bool bCreated;
+			UIWidgetLayout& layout = MainUIState.widgetLayouts.findOrAdd(_id, &bCreated);
+			if (bCreated || layout.inputHash != inputHash)
+			{
+				layout.inputHash = inputHash;
+				layout.labelSize = UIVector2(font->calculateTextLength(text, scale), font->calculateTextHeight(scale));
+				MainUIState.frameStats.layoutCacheMisses++;
+			}
+			else
+			{
+				MainUIState.frameStats.layoutCacheHits++;
+			}
+
+			return layout.labelSize;
+		}
+
+		// Draw text in rect with text width already known
+		void DrawTextInRectWithWidth(const UIRect& rect, const UIChar* text, UIVector4& fillColor, ETextAlign textAlign, ETextVerticalAlign vAlign, Float32 scale, UIFont* font, Float32 textWidth);
+
+		// Helper function: Items drawn since last layout node (e.g. a panel) are placed by themselves, keep them out of next node
+		void ExcludeFromLayout();
+
+		// Scope of a widget call. Explicit rect widgets called from user code keep their items out of layout,
+		// nested in a widget placed by draw position they belong to that widget's layout node.
+		struct UIWidgetScope
+		{
+			UIWidgetScope(bool bExplicitRect) : m_bExplicitRect(bExplicitRect) { MainUIState.widgetDepth++; }
+			~UIWidgetScope() { if (--MainUIState.widgetDepth == 0 && m_bExplicitRect) { ExcludeFromLayout(); } }
+
+			bool m_bExplicitRect;
+		};
+
+		// Button body with label width measured by caller, negative width is measured only when button is drawn
+		bool DoButtonWithLabelWidth(const UIChar* label, UIRect& rect, const UIButtonStyle& buttonStyle, Float32 labelWidth);
+		bool DoImageButtonWithLabelWidth(const UIChar* label, UIRect& rect, const UIImageButtonStyle& buttonStyle, Float32 labelWidth);
+	}
+
 	void UI::UpdateMouseState(Float32 mouseX, Float32 mouseY, EButtonState mouseDown)
 	{
+		if (mouseX != MainUIState.mousePos.x || mouseY != MainUIState.mousePos.y || mouseDown != MainUIState.mouseState)
+		{
+			MainUIState.bInputChanged = true;
+		}
+
 		MainUIState.mouseDeltaX = mouseX - MainUIState.mousePos.x;
 		MainUIState.mouseDeltaY = mouseY - MainUIState.mousePos.y;
 		MainUIState.mousePos.x = mouseX;
 		MainUIState.mousePos.y = mouseY;
 		MainUIState.lastMouseState = MainUIState.mouseState;
 		MainUIState.mouseState = mouseDown;
+
+		ResolveHoveredId();
 	}
 
 	void UI::RecordKeyboardButton(UIChar keyChar, Int32 keyState)
 	{
+		MainUIState.bInputChanged = true;
+
 		// Handle Keys
 		// Backspace key
 		if (keyChar == ZOOID_KEY_BACKSPACE && (keyState == 0 || keyState == 2))
@@ -577,6 +1182,8 @@ namespace ZE
 
 	void UI::RecordTextInput(UIChar keyChar)
 	{
+		MainUIState.bInputChanged = true;
+
 		// Add to buffer if focus is textInput
 		if (MainUIState.lastTextInput.id != 0 && MainUIState.lastTextInput.id == MainUIState.activeItem.id)
 		{
@@ -603,6 +1210,7 @@ namespace ZE
 
 	void UI::RecordMouseScroll(Float32 yOffset)
 	{
+		MainUIState.bInputChanged = true;
 		MainUIState.scrollOffsetY = yOffset;
 	}
 
@@ -610,23 +1218,30 @@ namespace ZE
 	{
 		static UIRect rect;
 		rect = MainUIState.drawPosDimension;
-		rect.m_dimension.x = buttonStyle.fontStyle.font->calculateTextLength(label, buttonStyle.fontStyle.fontScale) + 60.0f;
-		rect.m_dimension.y = buttonStyle.fontStyle.font->calculateTextHeight(buttonStyle.fontStyle.fontScale) + 20.0f;
+		const UIVector2 labelSize = GetWidgetLabelSize(GetUIIDFromString(label), label, buttonStyle.fontStyle.font, buttonStyle.fontStyle.fontScale);
+		rect.m_dimension.x = labelSize.x + 60.0f;
+		rect.m_dimension.y = labelSize.y + 20.0f;
 
-		bool result = DoButtonEx(label, rect, buttonStyle);
+		bool result = DoButtonWithLabelWidth(label, rect, buttonStyle, labelSize.x);
 
-		MainUIState.drawPosDimension.m_pos = MainUIState.drawPosDimension.m_pos + MainUIState.drawDirection * rect.m_dimension + UIVector2(5.0f) * MainUIState.drawDirection;
+		AdvanceDrawPos(rect.m_dimension);
 
 		return result;
 	}
 
 	bool UI::DoButtonEx(const UIChar* label, UIRect& rect, const UIButtonStyle& buttonStyle /*= DefaultButtonStyle*/)
 	{
-		const bool mouseInside = CheckMouseInside(rect);
-		bool bPressed = false;
+		UIWidgetScope widgetScope(true);
+		return DoButtonWithLabelWidth(label, rect, buttonStyle, -1.0f);
+	}
 
+	bool UI::DoButtonWithLabelWidth(const UIChar* label, UIRect& rect, const UIButtonStyle& buttonStyle, Float32 labelWidth)
+	{
 		UInt32 _id = GetUIIDFromString(label);
 
+		const bool mouseInside = CheckMouseHover(_id, rect);
+		bool bPressed = false;
+
 		if (mouseInside && MainUIState.mouseState == EButtonState::BUTTON_DOWN)
 		{
 			MainUIState.activeItem.id = _id;
@@ -652,10 +1267,19 @@ namespace ZE
 			style = &(buttonStyle.hover);
 		}
 
-		MainUIState.drawer->DrawRect(rect, style->borderColor);
-		MainUIState.drawer->DrawRect(rect + UIRect(UIVector2(style->borderThickness), UIVector2(-style->borderThickness*2.0f)), style->fillColor);
+		if (!ShouldDrawRect(rect))
+		{
+			MainUIState.frameStats.textCulled++;
+			return bPressed;
+		}
+
+		MainUIState.drawer->DrawBorderRect(rect, style->fillColor, style->borderThickness, style->borderColor);
 
-		DrawTextInRect(rect, label, COLOR_WHITE, TEXT_CENTER, TEXT_V_CENTER, buttonStyle.fontStyle.fontScale, buttonStyle.fontStyle.font);
+		if (labelWidth < 0.0f)
+		{
+			labelWidth = GetWidgetLabelSize(_id, label, buttonStyle.fontStyle.font, buttonStyle.fontStyle.fontScale).x;
+		}
+		DrawTextInRectWithWidth(rect, label, COLOR_WHITE, TEXT_CENTER, TEXT_V_CENTER, buttonStyle.fontStyle.fontScale, buttonStyle.fontStyle.font, labelWidth);
 
 		return bPressed;
 	}
@@ -664,23 +1288,30 @@ namespace ZE
 	{
 		static UIRect rect;
 		rect = MainUIState.drawPosDimension;
-		rect.m_dimension.x = buttonStyle.fontStyle.font->calculateTextLength(label, buttonStyle.fontStyle.fontScale) + 60.0f;
-		rect.m_dimension.y = buttonStyle.fontStyle.font->calculateTextHeight(buttonStyle.fontStyle.fontScale) + 20.0f;
+		const UIVector2 labelSize = GetWidgetLabelSize(GetUIIDFromString(label), label, buttonStyle.fontStyle.font, buttonStyle.fontStyle.fontScale);
+		rect.m_dimension.x = labelSize.x + 60.0f;
+		rect.m_dimension.y = labelSize.y + 20.0f;
 
-		bool result = DoImageButtonEx(label, rect, buttonStyle);
+		bool result = DoImageButtonWithLabelWidth(label, rect, buttonStyle, labelSize.x);
 
-		MainUIState.drawPosDimension.m_pos = MainUIState.drawPosDimension.m_pos + MainUIState.drawDirection * rect.m_dimension + UIVector2(5.0f) * MainUIState.drawDirection;
+		AdvanceDrawPos(rect.m_dimension);
 
 		return result;
 	}
 
 	bool UI::DoImageButtonEx(const UIChar* label, UIRect& rect, const UIImageButtonStyle& buttonStyle)
 	{
-		const bool mouseInside = CheckMouseInside(rect);
-		bool bPressed = false;
+		UIWidgetScope widgetScope(true);
+		return DoImageButtonWithLabelWidth(label, rect, buttonStyle, -1.0f);
+	}
 
+	bool UI::DoImageButtonWithLabelWidth(const UIChar* label, UIRect& rect, const UIImageButtonStyle& buttonStyle, Float32 labelWidth)
+	{
 		UInt32 _id = GetUIIDFromString(label);
 
+		const bool mouseInside = CheckMouseHover(_id, rect);
+		bool bPressed = false;
+
 		if (mouseInside && MainUIState.mouseState == EButtonState::BUTTON_DOWN)
 		{
 			MainUIState.activeItem.id = _id;
@@ -715,25 +1346,31 @@ namespace ZE
 			MainUIState.drawer->DrawRect(rect, style->fillColor);
 		}
 
-		DrawTextInRect(rect, label, COLOR_WHITE, TEXT_CENTER, TEXT_V_CENTER, buttonStyle.fontStyle.fontScale, buttonStyle.fontStyle.font);
+		if (labelWidth < 0.0f)
+		{
+			labelWidth = GetWidgetLabelSize(_id, label, buttonStyle.fontStyle.font, buttonStyle.fontStyle.fontScale).x;
+		}
+		DrawTextInRectWithWidth(rect, label, COLOR_WHITE, TEXT_CENTER, TEXT_V_CENTER, buttonStyle.fontStyle.fontScale, buttonStyle.fontStyle.font, labelWidth);
 
 		return bPressed;
 	}
 
 	bool UI::DoCheckBox(const UIChar* text, bool bChecked, const UIImageButtonStyle& checkBoxStyle /*= DefaultCheckBoxStyle*/)
 	{
+		UIWidgetScope widgetScope(false);
 		static UIRect rect;
 		rect = MainUIState.drawPosDimension;
 
 		bool result = DoCheckBoxEx(MainUIState.drawPosDimension.m_pos, text, bChecked, rect, checkBoxStyle);
 
-		MainUIState.drawPosDimension.m_pos = MainUIState.drawPosDimension.m_pos + MainUIState.drawDirection * rect.m_dimension + UIVector2(5.0f) * MainUIState.drawDirection;
+		AdvanceDrawPos(rect.m_dimension);
 
 		return result;
 	}
 
 	bool UI::DoCheckBoxEx(const UIVector2& pos, const UIChar* text, bool bChecked, UIRect& rect, const UIImageButtonStyle& checkBoxStyle)
 	{
+		UIWidgetScope widgetScope(true);
 		UIFont* font = checkBoxStyle.fontStyle.font ? checkBoxStyle.fontStyle.font : DefaultFont;
 		rect.m_pos = pos;
 
@@ -749,10 +1386,11 @@ namespace ZE
 			style = &(checkBoxStyle.hover);
 		}
 
-		rect.m_dimension.x = (style->texture ? style->textureSize.x : 0) + font->calculateTextLength(text, 1.0f);
-		rect.m_dimension.y = UIMAX((style->texture ? style->textureSize.y : 0), font->calculateTextHeight(1.0f));
+		const UIVector2 labelSize = GetWidgetLabelSize(_id, text, font, 1.0f);
+		rect.m_dimension.x = (style->texture ? style->textureSize.x : 0) + labelSize.x;
+		rect.m_dimension.y = UIMAX((style->texture ? style->textureSize.y : 0), labelSize.y);
 
-		const bool mouseInside = CheckMouseInside(rect);
+		const bool mouseInside = CheckMouseHover(_id, rect);
 
 		bool bPressed = false;
 		if (mouseInside && MainUIState.mouseState == EButtonState::BUTTON_DOWN)
@@ -854,10 +1492,11 @@ namespace ZE
 			style = &(radioButtonStyle.hover);
 		}
 
-		rect.m_dimension.x = (style->texture ? style->textureSize.x : 0) + font->calculateTextLength(text, 1.0f);
-		rect.m_dimension.y = UIMAX((style->texture ? style->textureSize.y : 0), font->calculateTextHeight(1.0f));
+		const UIVector2 labelSize = GetWidgetLabelSize(_id, text, font, 1.0f);
+		rect.m_dimension.x = (style->texture ? style->textureSize.x : 0) + labelSize.x;
+		rect.m_dimension.y = UIMAX((style->texture ? style->textureSize.y : 0), labelSize.y);
 
-		const bool mouseInside = CheckMouseInside(rect);
+		const bool mouseInside = CheckMouseHover(_id, rect);
 		bool bPressed = false;
 		if (mouseInside && MainUIState.mouseState == EButtonState::BUTTON_DOWN)
 		{
@@ -922,15 +1561,17 @@ namespace ZE
 
 	void UI::DoRadioButtons(const UIChar** textArray, UInt32 textArrayLen, Int32* _selectionId, const UIImageButtonStyle& radioButtonStyle /*= DefaultRadioBtnStyle*/)
 	{
+		UIWidgetScope widgetScope(false);
 		DoRadioButtonsEx(MainUIState.drawPosDimension.m_pos, textArray, textArrayLen, _selectionId, radioButtonStyle);
 
 		UIFont* font = radioButtonStyle.fontStyle.font ? radioButtonStyle.fontStyle.font : DefaultFont;
 		Float32 height = font->calculateTextHeight(radioButtonStyle.fontStyle.fontScale) + 5.0f;
-		MainUIState.drawPosDimension.m_pos = MainUIState.drawPosDimension.m_pos + MainUIState.drawDirection * UIVector2(100.0f, height * textArrayLen) + UIVector2(5.0f) * MainUIState.drawDirection;
+		AdvanceDrawPos(UIVector2(100.0f, height * textArrayLen));
 	}
 
 	void UI::DoRadioButtonsEx(const UIVector2& startPos, const UIChar** textArray, UInt32 textArrayLen, Int32* _selectionId, const UIImageButtonStyle& radioButtonStyle /*= DefaultRadioBtnStyle*/)
 	{
+		UIWidgetScope widgetScope(true);
 		UInt32 id = GetUIIDFromPointer(_selectionId);
 
 		StackIDs.push_back(id);
@@ -949,6 +1590,7 @@ namespace ZE
 
 	void UI::DoSlider(Float32* percent, const UISliderStyle& sliderStyle /*= DefaultSliderStyle*/)
 	{
+		UIWidgetScope widgetScope(false);
 		static UIRect rect;
 		rect = MainUIState.drawPosDimension;
 		rect.m_dimension.x = 200.0f;
@@ -956,13 +1598,14 @@ namespace ZE
 
 		DoSliderEx(rect, percent, sliderStyle);
 
-		MainUIState.drawPosDimension.m_pos = MainUIState.drawPosDimension.m_pos + MainUIState.drawDirection * rect.m_dimension + UIVector2(5.0f) * MainUIState.drawDirection;
+		AdvanceDrawPos(rect.m_dimension);
 	}
 
 	void UI::DoSliderEx(const UIRect& rect, Float32* percent, const UISliderStyle& sliderStyle)
 	{
-		const bool mouseInside = CheckMouseInside(rect);
+		UIWidgetScope widgetScope(true);
 		const UInt32 _id = GetUIIDFromPointer(percent);
+		const bool mouseInside = CheckMouseHover(_id, rect);
 
 		if (mouseInside && MainUIState.mouseState == EButtonState::BUTTON_DOWN)
 		{
@@ -1014,6 +1657,7 @@ namespace ZE
 
 	void UI::DoDropDown(Int32* selectedIdx, const UIChar** textOptions, Int32 optionCount, const UIDropdownStyle& style /*= DefaultDropdownStyle*/)
 	{
+		UIWidgetScope widgetScope(false);
 		static UIRect rect;
 		rect = MainUIState.drawPosDimension;
 		rect.m_dimension.x = style.dropdownButtonStyle.fontStyle.font->calculateTextLength(textOptions[*selectedIdx], style.dropdownButtonStyle.fontStyle.fontScale) + 60.0f;
@@ -1021,26 +1665,92 @@ namespace ZE
 
 		DoDropDownEx(rect, selectedIdx, textOptions, optionCount, style);
 
-		MainUIState.drawPosDimension.m_pos = MainUIState.drawPosDimension.m_pos + MainUIState.drawDirection * rect.m_dimension + UIVector2(5.0f) * MainUIState.drawDirection;
+		AdvanceDrawPos(rect.m_dimension);
 	}
 
-	void UI::DoDropDownEx(const UIRect& rect, Int32* selectedIdx, const UIChar** textOptions, Int32 optionCount, const UIDropdownStyle& style /*= DefaultDropdownStyle*/)
+	namespace UI
 	{
-		bool bPressed = false;
-		const UInt32 _id = GetUIIDFromPointer(selectedIdx);
-
-		UIRect selectionRect = rect;
-		if (cacheId == _id)
+		// Helper to draw Dropdown button with current selection text
+		// @return rect of the selection text
+		UIRect DrawDropDownButton(const UIRect& rect, UInt32 _id, const UIChar* text, const UIDropdownStyle& style)
 		{
-			selectionRect.m_dimension.y += rect.m_dimension.y * optionCount;
-		}
-
-		const bool mouseInside = CheckMouseInside(selectionRect);
+			UIRect textRect = rect;
 
-		if (mouseInside && MainUIState.mouseState == EButtonState::BUTTON_DOWN)
-		{
-			MainUIState.activeItem.id = _id;
-		}
+#ifdef ZUI_STYLE_USE_NO_TEXTURE
+			const UIRectStyle* uiStyle = &(style.dropdownButtonStyle.up);
+			bool bDivideUsingFillColor = true;
+			if (MainUIState.activeItem.id == _id)
+			{
+				bDivideUsingFillColor = false;
+				uiStyle = &(style.dropdownButtonStyle.down);
+			}
+			else if (MainUIState.hotItem.id == _id)
+			{
+				bDivideUsingFillColor = false;
+				uiStyle = &(style.dropdownButtonStyle.hover);
+			}
+
+			const float arrowButtonSection = 15.0f;
+			const float arrowPadding = arrowButtonSection * 0.1f;
+			const UIRect arrowButtonRect( 
+				rect.m_pos + UIVector2(rect.m_dimension.x - arrowButtonSection + arrowPadding, (rect.m_dimension.y - (arrowButtonSection - 2.0f*arrowPadding)) * 0.5f), 
+				UIVector2(arrowButtonSection - 2.0f * arrowPadding));
+		
+			textRect.m_pos.x += 5.0f;
+			textRect.m_dimension.x -= 5.0f;
+			MainUIState.drawer->DrawBorderRect(rect, uiStyle->fillColor, uiStyle->borderThickness, uiStyle->borderColor);
+			MainUIState.drawer->DrawRect(UIRect(rect.m_pos + UIVector2(rect.m_dimension.x - arrowButtonSection, uiStyle->borderThickness), UIVector2(uiStyle->borderThickness, rect.m_dimension.y - 2.0f * uiStyle->borderThickness)), bDivideUsingFillColor ? uiStyle->fillColor : uiStyle->borderColor);
+			MainUIState.drawer->DrawCollapseArrow(arrowButtonRect.m_pos, arrowButtonRect.m_dimension, false);
+#else
+			const UITextureStyle* uiStyle = &(style.dropdownButtonStyle.up);
+			if (MainUIState.activeItem.id == _id)
+			{
+				uiStyle = &(style.dropdownButtonStyle.down);
+			}
+			else if (MainUIState.hotItem.id == _id)
+			{
+				uiStyle = &(style.dropdownButtonStyle.hover);
+			}
+
+			if (uiStyle->texture)
+			{
+				MainUIState.drawer->DrawTexture(rect, uiStyle->texture, uiStyle->fillColor, uiStyle->textureScale, uiStyle->textureOffset);
+				textRect.m_pos.x += uiStyle->textureOffset.z * rect.m_dimension.x;
+				textRect.m_pos.y += uiStyle->textureOffset.x * rect.m_dimension.y;
+				textRect.m_dimension.x -= (uiStyle->textureOffset.z + uiStyle->textureOffset.w) * rect.m_dimension.x;
+				textRect.m_dimension.y -= (uiStyle->textureOffset.x + uiStyle->textureOffset.y) * rect.m_dimension.y;
+			}
+			else
+			{
+				MainUIState.drawer->DrawRect(rect, uiStyle->fillColor);
+			}
+#endif
+
+			DrawTextInRect(textRect, text, COLOR_WHITE, TEXT_LEFT, TEXT_V_CENTER, style.dropdownButtonStyle.fontStyle.fontScale, style.dropdownButtonStyle.fontStyle.font);
+
+			return textRect;
+		}
+	}
+
+	void UI::DoDropDownEx(const UIRect& rect, Int32* selectedIdx, const UIChar** textOptions, Int32 optionCount, const UIDropdownStyle& style /*= DefaultDropdownStyle*/)
+	{
+		UIWidgetScope widgetScope(true);
+		bool bPressed = false;
+		const UInt32 _id = GetUIIDFromPointer(selectedIdx);
+
+		UIRect selectionRect = rect;
+		if (cacheId == _id)
+		{
+			selectionRect.m_dimension.y += rect.m_dimension.y * optionCount;
+		}
+
+		// Open selector is on top of everything
+		const bool mouseInside = CheckMouseHover(_id, selectionRect, cacheId == _id ? 1 : -1);
+
+		if (mouseInside && MainUIState.mouseState == EButtonState::BUTTON_DOWN)
+		{
+			MainUIState.activeItem.id = _id;
+		}
 		else if (mouseInside)
 		{
 			MainUIState.hotItem.id = _id;
@@ -1070,60 +1780,7 @@ namespace ZE
 			}
 		}
 
-		UIRect textRect = rect;
-
-#ifdef ZUI_STYLE_USE_NO_TEXTURE
-		const UIRectStyle* uiStyle = &(style.dropdownButtonStyle.up);
-		bool bDivideUsingFillColor = true;
-		if (MainUIState.activeItem.id == _id)
-		{
-			bDivideUsingFillColor = false;
-			uiStyle = &(style.dropdownButtonStyle.down);
-		}
-		else if (MainUIState.hotItem.id == _id)
-		{
-			bDivideUsingFillColor = false;
-			uiStyle = &(style.dropdownButtonStyle.hover);
-		}
-
-		const float arrowButtonSection = 15.0f;
-		const float arrowPadding = arrowButtonSection * 0.1f;
-		const UIRect arrowButtonRect( 
-			rect.m_pos + UIVector2(rect.m_dimension.x - arrowButtonSection + arrowPadding, (rect.m_dimension.y - (arrowButtonSection - 2.0f*arrowPadding)) * 0.5f), 
-			UIVector2(arrowButtonSection - 2.0f * arrowPadding));
-		
-		textRect.m_pos.x += 5.0f;
-		textRect.m_dimension.x -= 5.0f;
-		MainUIState.drawer->DrawRect(rect, uiStyle->borderColor);
-		MainUIState.drawer->DrawRect(rect + UIRect(UIVector2(uiStyle->borderThickness), UIVector2(-2.0f * uiStyle->borderThickness)), uiStyle->fillColor);
-		MainUIState.drawer->DrawRect(UIRect(rect.m_pos + UIVector2(rect.m_dimension.x - arrowButtonSection, uiStyle->borderThickness), UIVector2(uiStyle->borderThickness, rect.m_dimension.y - 2.0f * uiStyle->borderThickness)), bDivideUsingFillColor ? uiStyle->fillColor : uiStyle->borderColor);
-		MainUIState.drawer->DrawCollapseArrow(arrowButtonRect.m_pos, arrowButtonRect.m_dimension, false);
-#else
-		const UITextureStyle* uiStyle = &(style.dropdownButtonStyle.up);
-		if (MainUIState.activeItem.id == _id)
-		{
-			uiStyle = &(style.dropdownButtonStyle.down);
-		}
-		else if (MainUIState.hotItem.id == _id)
-		{
-			uiStyle = &(style.dropdownButtonStyle.hover);
-		}
-
-		if (uiStyle->texture)
-		{
-			MainUIState.drawer->DrawTexture(rect, uiStyle->texture, uiStyle->fillColor, uiStyle->textureScale, uiStyle->textureOffset);
-			textRect.m_pos.x += uiStyle->textureOffset.z * rect.m_dimension.x;
-			textRect.m_pos.y += uiStyle->textureOffset.x * rect.m_dimension.y;
-			textRect.m_dimension.x -= (uiStyle->textureOffset.z + uiStyle->textureOffset.w) * rect.m_dimension.x;
-			textRect.m_dimension.y -= (uiStyle->textureOffset.x + uiStyle->textureOffset.y) * rect.m_dimension.y;
-		}
-		else
-		{
-			MainUIState.drawer->DrawRect(rect, uiStyle->fillColor);
-		}
-#endif
-
-		DrawTextInRect(textRect, textOptions[*selectedIdx], COLOR_WHITE, TEXT_LEFT, TEXT_V_CENTER, style.dropdownButtonStyle.fontStyle.fontScale, style.dropdownButtonStyle.fontStyle.font);
+		const UIRect textRect = DrawDropDownButton(rect, _id, textOptions[*selectedIdx], style);
 
 #ifdef ZUI_STYLE_USE_NO_TEXTURE
 		if (cacheId == _id)
@@ -1134,8 +1791,7 @@ namespace ZE
 			selectionRect.m_pos.y += rect.m_dimension.y;
 			selectionRect.m_dimension.y = rect.m_dimension.y * optionCount;
 
-			MainUIState.drawer->DrawRect(selectionRect, style.selectorStyle.borderColor);
-			MainUIState.drawer->DrawRect(selectionRect + UIRect(UIVector2(style.selectorStyle.borderThickness), UIVector2(-2.0f*style.selectorStyle.borderThickness)), style.selectorStyle.fillColor);
+			MainUIState.drawer->DrawBorderRect(selectionRect, style.selectorStyle.fillColor, style.selectorStyle.borderThickness, style.selectorStyle.borderColor);
 
 			// Drawing Text
 			UIRect selRect = rect;
@@ -1144,7 +1800,7 @@ namespace ZE
 			selTextRect.m_pos.x = textRect.m_pos.x;
 			for (Int32 i = 0; i < optionCount; i++)
 			{
-				if (CheckMouseInside(selTextRect))
+				if (mouseInside && CheckMouseInside(selTextRect))
 				{
 					selRect.m_pos.y = selTextRect.m_pos.y;
 					MainUIState.drawer->DrawRect(selRect, style.selectorHoverStyle.fillColor);
@@ -1185,7 +1841,7 @@ namespace ZE
 			selTextRect.m_pos.x = textRect.m_pos.x;
 			for (Int32 i = 0; i < optionCount; i++)
 			{
-				if (CheckMouseInside(selTextRect))
+				if (mouseInside && CheckMouseInside(selTextRect))
 				{
 					selRect.m_pos.y = selTextRect.m_pos.y;
 					MainUIState.drawer->DrawRect(selRect, style.selectorHoverStyle.fillColor);
@@ -1205,8 +1861,188 @@ namespace ZE
 #endif
 	}
 
+	void UI::DoSearchableDropDown(Int32* selectedIdx, const UIChar** textOptions, Int32 optionCount, Int32 maxVisibleOptions /*= 10*/, const UIDropdownStyle& style /*= DefaultDropdownStyle*/)
+	{
+		UIWidgetScope widgetScope(false);
+		static UIRect rect;
+		rect = MainUIState.drawPosDimension;
+		rect.m_dimension.x = style.dropdownButtonStyle.fontStyle.font->calculateTextLength(textOptions[*selectedIdx], style.dropdownButtonStyle.fontStyle.fontScale) + 60.0f;
+		rect.m_dimension.y = style.dropdownButtonStyle.fontStyle.font->calculateTextHeight(style.dropdownButtonStyle.fontStyle.fontScale) + 15.0f;
+
+		DoSearchableDropDownEx(rect, selectedIdx, textOptions, optionCount, maxVisibleOptions, style);
+
+		AdvanceDrawPos(rect.m_dimension);
+	}
+
+	void UI::DoSearchableDropDownEx(const UIRect& rect, Int32* selectedIdx, const UIChar** textOptions, Int32 optionCount, Int32 maxVisibleOptions /*= 10*/, const UIDropdownStyle& style /*= DefaultDropdownStyle*/)
+	{
+		UIWidgetScope widgetScope(true);
+		const UInt32 _id = GetUIIDFromPointer(selectedIdx);
+		const UInt32 _filterId = ComputeHashString("Filter", 255, _id);
+		const Float32 rowHeight = rect.m_dimension.y;
+
+		const bool mouseInside = CheckMouseHover(_id, rect);
+		if (mouseInside && MainUIState.mouseState == EButtonState::BUTTON_DOWN)
+		{
+			MainUIState.activeItem.id = _id;
+		}
+		else if (mouseInside)
+		{
+			MainUIState.hotItem.id = _id;
+			if (MainUIState.activeItem.id == _id)
+			{
+				MainUIState.activeItem.id = 0;
+				if (cacheId != _id)
+				{
+					cacheId = _id;
+
+					// Open with empty filter and selected option on top
+					UIDropdownSearchState& searchState = MainUIState.dropdownSearchStates.findOrAdd(_id);
+					searchState.filterBuffer.assign(TEXT_TEMP_LENGTH, 0);
+					searchState.scrollOffset = UIMAX(0, *selectedIdx) * rowHeight;
+				}
+				else
+				{
+					cacheId = 0;
+				}
+			}
+		}
+		else
+		{
+			if (MainUIState.hotItem.id == _id) { MainUIState.hotItem.id = 0; }
+			if (MainUIState.activeItem.id == _id) { MainUIState.activeItem.id = 0; }
+		}
+
+		const UIRect textRect = DrawDropDownButton(rect, _id, textOptions[*selectedIdx], style);
+
+		if (cacheId != _id)
+		{
+			if (MainUIState.lastTextInput.id == _filterId) { MainUIState.lastTextInput.id = 0; }
+			if (MainUIState.activeItem.id == _filterId) { MainUIState.activeItem.id = 0; }
+			return;
+		}
+
+		UIDropdownSearchState& searchState = MainUIState.dropdownSearchStates.findOrAdd(_id);
+		searchState.optionFilter.setOptions(textOptions, optionCount);
+		const bool bFilterChanged = searchState.optionFilter.setFilter(searchState.filterBuffer.data());
+
+		const UIArray<Int32>& matches = searchState.optionFilter.getMatches();
+
+		// Filter left from last open is cleared on open, keep selected option in view if it still matches
+		if (bFilterChanged)
+		{
+			auto selectedMatch = std::find(matches.begin(), matches.end(), *selectedIdx);
+			searchState.scrollOffset = selectedMatch != matches.end() ? (Float32)(selectedMatch - matches.begin()) * rowHeight : 0.0f;
+		}
+
+		const Int32 matchCount = (Int32)matches.size();
+		const Int32 visibleCount = UIMIN(maxVisibleOptions, matchCount);
+
+		// Bounded popup: filter row and visible option rows
+		const UIRect popupRect(rect.m_pos + UIVector2(0.0f, rect.m_dimension.y), UIVector2(rect.m_dimension.x, rowHeight * (visibleCount + 1)));
+		const UIRect filterRect(UIVector2(textRect.m_pos.x, popupRect.m_pos.y), UIVector2(textRect.m_dimension.x, rowHeight));
+		const UIRect listRect(popupRect.m_pos + UIVector2(0.0f, rowHeight), UIVector2(rect.m_dimension.x, rowHeight * visibleCount));
+		const bool mouseInsidePopup = popupRect.isContain(MainUIState.mousePos);
+		const bool mouseOverPopup = CheckMouseHover(_filterId, popupRect, 1);
+
+		// Close on click outside
+		if (MainUIState.mouseState == EButtonState::BUTTON_DOWN && !mouseInside && !mouseInsidePopup && MainUIState.activeItem.id != GetUIIDFromString("ScrollBarV"))
+		{
+			cacheId = 0;
+			return;
+		}
+
+		// Keep keyboard focus on filter while open
+		if (MainUIState.activeItem.id == 0 || MainUIState.activeItem.id == _filterId)
+		{
+			MainUIState.activeItem.id = _filterId;
+			MainUIState.lastTextInput.id = _filterId;
+			MainUIState.textInputBuffer = searchState.filterBuffer.data();
+			MainUIState.textInputLength = (Int32)searchState.filterBuffer.size();
+			MainUIState.textInputCurrentPos = TextLength(searchState.filterBuffer.data());
+			MainUIState.textInputMaxScroll = MainUIState.textInputLength;
+			MainUIState.textInputScrollPos = 0;
+			MainUIState.textInputFilterChar = nullptr;
+		}
+
+		// Scroll by whole rows so no mask is needed
+		const Float32 maxScroll = (Float32)UIMAX(0, matchCount - visibleCount) * rowHeight;
+		if (mouseInsidePopup)
+		{
+			searchState.scrollOffset += MainUIState.UseScrollOffset() * -rowHeight;
+		}
+		searchState.scrollOffset = UICLAMP(0.0f, maxScroll, searchState.scrollOffset);
+		const Int32 firstMatch = UIMIN((Int32)(searchState.scrollOffset / rowHeight + 0.5f), matchCount - visibleCount);
+
+		MainUIState.drawer->SetLayer(1); // Draw on top of everything
+
+#ifdef ZUI_STYLE_USE_NO_TEXTURE
+		MainUIState.drawer->DrawBorderRect(popupRect, style.selectorStyle.fillColor, style.selectorStyle.borderThickness, style.selectorStyle.borderColor);
+#else
+		if (style.selectorStyle.texture)
+		{
+			MainUIState.drawer->DrawTexture(popupRect, style.selectorStyle.texture, style.selectorStyle.fillColor, style.selectorStyle.textureScale, style.selectorStyle.textureOffset);
+		}
+		else
+		{
+			MainUIState.drawer->DrawRect(popupRect, style.selectorStyle.fillColor);
+		}
+#endif
+
+		// Filter row
+		const UIChar* filterText = searchState.filterBuffer.data();
+		if (filterText[0] != 0)
+		{
+			DrawTextInRect(filterRect, filterText, COLOR_WHITE, TEXT_LEFT, TEXT_V_CENTER, style.selectorFontStyle.fontScale, style.selectorFontStyle.font);
+		}
+		else
+		{
+			UIVector4 placeholderColor(1.0f, 1.0f, 1.0f, 0.5f);
+			DrawTextInRect(filterRect, "Type to filter...", placeholderColor, TEXT_LEFT, TEXT_V_CENTER, style.selectorFontStyle.fontScale, style.selectorFontStyle.font);
+		}
+
+		UIRect cursorRect;
+		cursorRect.m_dimension = { 2.0f, style.selectorFontStyle.font->calculateTextHeight(style.selectorFontStyle.fontScale) };
+		cursorRect.m_pos.x = filterRect.m_pos.x + style.selectorFontStyle.font->calculateTextLength(filterText, style.selectorFontStyle.fontScale);
+		cursorRect.m_pos.y = filterRect.m_pos.y + (rowHeight - cursorRect.m_dimension.y) * 0.5f;
+		MainUIState.drawer->DrawRect(cursorRect, COLOR_WHITE);
+
+		// Visible options only
+		UIRect selRect(UIVector2(listRect.m_pos.x, listRect.m_pos.y), UIVector2(listRect.m_dimension.x, rowHeight));
+		UIRect selTextRect(UIVector2(textRect.m_pos.x, listRect.m_pos.y), UIVector2(textRect.m_dimension.x, rowHeight));
+		for (Int32 i = firstMatch; i < firstMatch + visibleCount; i++)
+		{
+			const Int32 option = matches[i];
+			if (mouseOverPopup && selRect.isContain(MainUIState.mousePos))
+			{
+				MainUIState.drawer->DrawRect(selRect, style.selectorHoverStyle.fillColor);
+				if (MainUIState.mouseState == EButtonState::BUTTON_DOWN)
+				{
+					cacheId = 0;
+					*selectedIdx = option;
+				}
+			}
+			else if (option == *selectedIdx)
+			{
+				MainUIState.drawer->DrawRect(selRect, COLOR_BLUE_SELECTION);
+			}
+
+			DrawTextInRect(selTextRect, textOptions[option], COLOR_WHITE, TEXT_LEFT, TEXT_V_CENTER, style.selectorFontStyle.fontScale, style.selectorFontStyle.font);
+			selRect.m_pos.y += rowHeight;
+			selTextRect.m_pos.y += rowHeight;
+		}
+
+		if (matchCount > visibleCount)
+		{
+			searchState.scrollOffset = DoScrollBar(UIVector2(listRect.m_pos.x + listRect.m_dimension.x - 5, listRect.m_pos.y), searchState.scrollOffset, listRect.m_dimension.y, matchCount * rowHeight);
+		}
+
+		MainUIState.drawer->SetLayer(0);
+	}
+
 	void UI::DoTextInput(UIChar* bufferChar, Int32 bufferCount, const UITextInputStyle& style /*= DefaultTextInputStyle*/)
 	{
+		UIWidgetScope widgetScope(false);
 		static UIRect rect;
 		rect = MainUIState.drawPosDimension;
 		rect.m_dimension.x = rect.m_dimension.x;
@@ -1214,17 +2050,17 @@ namespace ZE
 
 		DoTextInputEx(rect, bufferChar, bufferCount, style);
 
-		MainUIState.drawPosDimension.m_pos = MainUIState.drawPosDimension.m_pos + MainUIState.drawDirection * rect.m_dimension + UIVector2(5.0f) * MainUIState.drawDirection;
+		AdvanceDrawPos(rect.m_dimension);
 	}
 
 	void UI::DoTextInputEx(const UIRect& rect, UIChar* bufferChar, Int32 bufferCount, const UITextInputStyle& style /*= DefaultTextInputStyle*/)
 	{
-		const bool mouseInside = CheckMouseInside(rect);
+		UIWidgetScope widgetScope(true);
+		UInt32 _id = GetUIIDFromPointer(bufferChar);
+		const bool mouseInside = CheckMouseHover(_id, rect);
 		const UIRect textRect(UIVector2(rect.m_pos.x + 10, rect.m_pos.y), UIVector2(rect.m_dimension.x - 20, rect.m_dimension.y));
 		Int32 textInputScrollPos = 0;
 
-		UInt32 _id = GetUIIDFromPointer(bufferChar);
-
 		static Int32 lastMaxLength = 100000;
 
 		if (mouseInside && MainUIState.mouseState == EButtonState::BUTTON_DOWN)
@@ -1278,8 +2114,7 @@ namespace ZE
 			rectStyle = &style.activeStyle;
 		}
 
-		MainUIState.drawer->DrawRect(rect, rectStyle->borderColor);
-		MainUIState.drawer->DrawRect(rect + UIRect(UIVector2(rectStyle->borderThickness), UIVector2(-2.0f * rectStyle->borderThickness)), rectStyle->fillColor);
+		MainUIState.drawer->DrawBorderRect(rect, rectStyle->fillColor, rectStyle->borderThickness, rectStyle->borderColor);
 #else
 		const UITextureStyle* rectStyle = &style.defaultStyle;
 		if (MainUIState.activeItem.id == _id || MainUIState.hotItem.id == _id)
@@ -1320,23 +2155,29 @@ namespace ZE
 
 	void UI::DoNumberStepper(Float32* number, Float32 step, bool asInt /*= false*/, const UIFontStyle& textStyle /*= DefaultFontStyle*/, const UIButtonStyle& buttonStyle /*= DefaultButtonStyle*/)
 	{
+		UIWidgetScope widgetScope(false);
 		static UIRect rect;
 		rect = MainUIState.drawPosDimension;
 		rect.m_dimension.y = textStyle.font->calculateTextHeight(textStyle.fontScale) + 20.0f;
 
 		DoNumberStepperEx(rect, number, step, asInt, textStyle);
 
-		MainUIState.drawPosDimension.m_pos = MainUIState.drawPosDimension.m_pos + MainUIState.drawDirection * rect.m_dimension + UIVector2(5.0f) * MainUIState.drawDirection;
+		AdvanceDrawPos(rect.m_dimension);
 	}
 
 	void UI::DoNumberStepperEx(const UIRect& rect, Float32* number, Float32 step, bool asInt /*= false*/, const UIFontStyle& textStyle /*= DefaultFontStyle*/, const UIButtonStyle& buttonStyle /*= DefaultButtonStyle*/)
 	{
+		UIWidgetScope widgetScope(true);
 		UIChar charBuffer[256];
 		StringHelper::NumberToString(*number, charBuffer, 256, asInt);
-		DrawTextInRect(rect, charBuffer, COLOR_WHITE, TEXT_CENTER, TEXT_V_CENTER, textStyle.fontScale, textStyle.font);
 
 		UInt32 _id = GetUIIDFromPointer(number);
 
+		// Id comes from pointer, number itself is part of the inputs
+		const UInt32 numberHash = ComputeHashData((void*)number, sizeof(Float32), asInt ? 1 : 0);
+		const Float32 textWidth = GetWidgetLabelSize(_id, charBuffer, textStyle.font, textStyle.fontScale, numberHash).x;
+		DrawTextInRectWithWidth(rect, charBuffer, COLOR_WHITE, TEXT_CENTER, TEXT_V_CENTER, textStyle.fontScale, textStyle.font, textWidth);
+
 		StackIDs.push_back(_id);
 
 		UIRect buttonRect;
@@ -1359,20 +2200,22 @@ namespace ZE
 
 	void UI::DoNumberInput(Float32* number, const UITextInputStyle& style /*= DefaultTextInputStyle*/, bool asInt /*= false*/)
 	{
+		UIWidgetScope widgetScope(false);
 		static UIRect rect;
 		rect = MainUIState.drawPosDimension;
 		rect.m_dimension.y = style.fontStyle.font->calculateTextHeight(style.fontStyle.fontScale) + 20.0f;
 
 		DoNumberInputEx(rect, number, style, asInt);
 
-		MainUIState.drawPosDimension.m_pos = MainUIState.drawPosDimension.m_pos + MainUIState.drawDirection * rect.m_dimension + UIVector2(5.0f) * MainUIState.drawDirection;
+		AdvanceDrawPos(rect.m_dimension);
 	}
 
 	void UI::DoNumberInputEx(const UIRect& rect, Float32* number, const UITextInputStyle& style /*= DefaultTextInputStyle*/, bool asInt /*= false*/)
 	{
+		UIWidgetScope widgetScope(true);
 		static UIChar charBuffer[256];
 		const UInt32 _id = GetUIIDFromPointer(number);
-		const bool mouseInside = CheckMouseInside(rect);
+		const bool mouseInside = CheckMouseHover(_id, rect);
 
 		UIChar* bufferChar = MainUIState.activeItem.id == _id ? MainUIState.textTempBuffer : charBuffer;
 
@@ -1471,8 +2314,7 @@ namespace ZE
 			rectStyle = &style.activeStyle;
 		}
 
-		MainUIState.drawer->DrawRect(rect, rectStyle->borderColor);
-		MainUIState.drawer->DrawRect(rect + UIRect(UIVector2(rectStyle->borderThickness), UIVector2(-2.0f * rectStyle->borderThickness)), rectStyle->fillColor);
+		MainUIState.drawer->DrawBorderRect(rect, rectStyle->fillColor, rectStyle->borderThickness, rectStyle->borderColor);
 #else
 		const UITextureStyle* rectStyle = &style.defaultStyle;
 		if (MainUIState.activeItem.id == _id || MainUIState.hotItem.id == _id)
@@ -1513,17 +2355,19 @@ namespace ZE
 
 	void UI::DoVector2Input(Float32* vec2, const UITextInputStyle& style /*= DefaultTextInputStyle*/, bool asInt /*= false*/)
 	{
+		UIWidgetScope widgetScope(false);
 		static UIRect rect;
 		rect = MainUIState.drawPosDimension;
 		rect.m_dimension.y = style.fontStyle.font->calculateTextHeight(style.fontStyle.fontScale) + 20.0f;
 
 		DoVector2InputEx(rect, vec2, style, asInt);
 
-		MainUIState.drawPosDimension.m_pos = MainUIState.drawPosDimension.m_pos + MainUIState.drawDirection * rect.m_dimension + UIVector2(5.0f) * MainUIState.drawDirection;
+		AdvanceDrawPos(rect.m_dimension);
 	}
 
 	void UI::DoVector2InputEx(const UIRect& rect, Float32* vec2, const UITextInputStyle& style /*= DefaultTextInputStyle*/, bool asInt /*= false*/)
 	{
+		UIWidgetScope widgetScope(true);
 		const UInt32 nCount = 2;
 		const Float32 elementWidth = rect.m_dimension.x / nCount;
 		UIRect elementRect = rect;
@@ -1537,17 +2381,19 @@ namespace ZE
 
 	void UI::DoVector3Input(Float32* vec3, const UITextInputStyle& style /*= DefaultTextInputStyle*/, bool asInt /*= false*/)
 	{
+		UIWidgetScope widgetScope(false);
 		static UIRect rect;
 		rect = MainUIState.drawPosDimension;
 		rect.m_dimension.y = style.fontStyle.font->calculateTextHeight(style.fontStyle.fontScale) + 20.0f;
 
 		DoVector3InputEx(rect, vec3, style, asInt);
 
-		MainUIState.drawPosDimension.m_pos = MainUIState.drawPosDimension.m_pos + MainUIState.drawDirection * rect.m_dimension + UIVector2(5.0f) * MainUIState.drawDirection;
+		AdvanceDrawPos(rect.m_dimension);
 	}
 
 	void UI::DoVector3InputEx(const UIRect& rect, Float32* vec3, const UITextInputStyle& style /*= DefaultTextInputStyle*/, bool asInt /*= false*/)
 	{
+		UIWidgetScope widgetScope(true);
 		const UInt32 nCount = 3;
 		const Float32 elementWidth = rect.m_dimension.x / nCount;
 		UIRect elementRect = rect;
@@ -1561,17 +2407,19 @@ namespace ZE
 
 	void UI::DoVector4Input(Float32* vec4, const UITextInputStyle& style /*= DefaultTextInputStyle*/, bool asInt /*= false*/)
 	{
+		UIWidgetScope widgetScope(false);
 		static UIRect rect;
 		rect = MainUIState.drawPosDimension;
 		rect.m_dimension.y = style.fontStyle.font->calculateTextHeight(style.fontStyle.fontScale) + 20.0f;
 
 		DoVector4InputEx(rect, vec4, style, asInt);
 
-		MainUIState.drawPosDimension.m_pos = MainUIState.drawPosDimension.m_pos + MainUIState.drawDirection * rect.m_dimension + UIVector2(5.0f) * MainUIState.drawDirection;
+		AdvanceDrawPos(rect.m_dimension);
 	}
 
 	void UI::DoVector4InputEx(const UIRect& rect, Float32* vec4, const UITextInputStyle& style /*= DefaultTextInputStyle*/, bool asInt /*= false*/)
 	{
+		UIWidgetScope widgetScope(true);
 		const UInt32 nCount = 4;
 		const Float32 elementWidth = rect.m_dimension.x / nCount;
 		UIRect elementRect = rect;
@@ -1590,7 +2438,7 @@ namespace ZE
 		{
 			const UInt32 _id = GetUIIDFromPointer(&panelState);
 
-			const bool mouseInside = ZE::UI::CheckMouseInside(rect);
+			const bool mouseInside = ZE::UI::CheckMouseHover(_id, rect);
 			bool bPressed = false;
 			if (mouseInside && ZE::UI::MainUIState.mouseState == EButtonState::BUTTON_DOWN)
 			{
@@ -1634,84 +2482,563 @@ namespace ZE
 		}
 	}
 
-	bool UI::BeginPanel(const UIChar* panelLabel, const UIRect initialRect, bool bAutoSize, const UIPanelStyle& style /*= DefaultPanelStyle*/)
+	namespace UI
 	{
-		const UInt32 _id = GetUIIDFromString(panelLabel);
-
-		StackIDs.push_back(_id);
+		// Helper function: Panel background fully hides what is behind it
+		bool IsPanelOpaque(const UIPanelState& panelState, const UIPanelStyle& style)
+		{
+			if (panelState.bCollapsed || panelState.targetRect.m_roundness > 0.0f) { return false; }
+#ifdef ZUI_STYLE_USE_NO_TEXTURE
+			return style.fillColor.w >= 1.0f;
+#else
+			return style.panel.texture == nullptr && style.panel.fillColor.w >= 1.0f;
+#endif
+		}
 
-		if (!(HashMapHas(MainUIState.panelStates, _id)))
+		// Helper function: Panel is outside of screen or fully covered by an opaque panel drawn after it on previous frame
+		bool IsPanelHidden(UInt32 panelId, const UIRect& rect)
 		{
-			UIPanelState panelState;
-			panelState.targetRect = initialRect;
-			panelState.contentSize = initialRect.m_dimension;
-			panelState.scrollOffset = 0.0f;
-			panelState.bAutoSize = bAutoSize;
-			panelState.bCollapsed = false;
-			MainUIState.panelStates[_id] = panelState;
+			const UIVector2 bottomRight = rect.m_pos + rect.m_dimension;
+			if (bottomRight.x < 0.0f || bottomRight.y < 0.0f || rect.m_pos.x > MainUIState.screenWidth || rect.m_pos.y > MainUIState.screenHeight)
+			{
+				return true;
+			}
+
+			bool bFound = false;
+			for (const UIPanelDrawInfo& drawInfo : MainUIState.lastPanelDrawInfos)
+			{
+				if (!bFound)
+				{
+					bFound = drawInfo.id == panelId;
+					continue;
+				}
+
+				const UIVector2 otherBottomRight = drawInfo.rect.m_pos + drawInfo.rect.m_dimension;
+				if (drawInfo.bOpaque && drawInfo.rect.m_pos.x <= rect.m_pos.x && drawInfo.rect.m_pos.y <= rect.m_pos.y
+					&& otherBottomRight.x >= bottomRight.x && otherBottomRight.y >= bottomRight.y)
+				{
+					return true;
+				}
+			}
+
+			return false;
 		}
+	}
 
-		UIPanelState& panelState = MainUIState.panelStates[_id];
+	namespace UI
+	{
+		// Helper functions: Size along row/column direction and across it
+		inline Float32 LayoutMain(const UIVector2& v, bool bRow) { return bRow ? v.x : v.y; }
+		inline Float32 LayoutCross(const UIVector2& v, bool bRow) { return bRow ? v.y : v.x; }
+		inline UIVector2 LayoutVector(Float32 main, Float32 cross, bool bRow) { return bRow ? UIVector2(main, cross) : UIVector2(cross, main); }
 
-		UIRect headerRect;
-		headerRect.m_pos = panelState.targetRect.m_pos;
-		headerRect.m_dimension.x = panelState.targetRect.m_dimension.x;
-		headerRect.m_dimension.y = style.headerHeight;
-		panelState.headerSize = headerRect.m_dimension;
+		UIVector2 ClampLayoutSize(const UIVector2& size, const UILayoutItem& item)
+		{
+			return UIVector2(UICLAMP(item.minSize.x, item.maxSize.x, size.x), UICLAMP(item.minSize.y, item.maxSize.y, size.y));
+		}
 
-#ifdef ZUI_STYLE_USE_NO_TEXTURE
-		if (!panelState.bCollapsed)
+		// Helper function: Open container that widget drawn now belongs to, -1 if widget is drawn inside something else (list, panel...)
+		Int32 GetLayoutParent()
 		{
-			MainUIState.drawer->DrawRect(panelState.targetRect + UIRect(UIVector2(-style.borderSize), UIVector2(2.0f*style.borderSize)), style.borderColor);
-			MainUIState.drawer->DrawRect(panelState.targetRect, style.fillColor);
+			if (MainUIState.layoutStack.size() == 0) { return -1; }
+
+			const Int32 parentIndex = MainUIState.layoutStack.back();
+			return MainUIState.layoutNodes[parentIndex].drawStackDepth == (Int32)MainUIState.drawPosDimensionStack.size() ? parentIndex : -1;
 		}
-		else
+
+		// Child id from parent id and child index, cheap since it's done for every widget inside a layout
+		UInt32 GetNextLayoutChildId(const UILayoutNode& parent)
 		{
-			MainUIState.drawer->DrawRect(headerRect + UIRect(UIVector2(-style.borderSize), UIVector2(2.0f*style.borderSize)), style.borderColor);
+			return parent.id ^ ((UInt32)parent.childCount + 0x9e3779b9 + (parent.id << 6) + (parent.id >> 2));
+		}
 
+		// Helper function: Same node in previous frame, null if layout changed up to this node
+		const UILayoutNode* FindLastLayoutNode(Int32 nodeIndex, UInt32 nodeId)
+		{
+			if (nodeIndex < MainUIState.lastLayoutNodeCount && MainUIState.lastLayoutNodes[nodeIndex].id == nodeId)
+			{
+				return &MainUIState.lastLayoutNodes[nodeIndex];
+			}
+			return nullptr;
 		}
-		MainUIState.drawer->DrawRect(UIRect(panelState.targetRect.m_pos, UIVector2(panelState.targetRect.m_dimension.x, headerRect.m_dimension.y + style.headerOffset)), style.headerColor);
-		MainUIState.drawer->DrawRect(UIRect(UIVector2(panelState.targetRect.m_pos.x, panelState.targetRect.m_pos.y + panelState.headerSize.y + style.headerOffset), UIVector2(panelState.targetRect.m_dimension.x, style.borderSize)), style.borderColor);
-#else
-		// Draw Panel
-		if (panelState.bCollapsed)
+
+		Int32 AddLayoutNode(Int32 parentIndex, bool bContainer)
 		{
-			UIRect closeRect;
-			closeRect.m_pos = panelState.targetRect.m_pos;
-			closeRect.m_dimension = { panelState.targetRect.m_dimension.x, panelState.headerSize.y + 5.0f };
-			closeRect.m_roundness = panelState.targetRect.m_roundness;
-			if (style.panelClosedBG.texture)
+			UIArray<UILayoutNode>& nodes = MainUIState.layoutNodes;
+			const Int32 nodeIndex = MainUIState.layoutNodeCount++;
+
+			// Nodes are reused from earlier frames, array only allocates when layout gets bigger
+			if (nodeIndex == (Int32)nodes.size())
 			{
-				MainUIState.drawer->DrawTexture(closeRect, style.panelClosedBG.texture, style.panelClosedBG.fillColor, style.panelClosedBG.textureScale, style.panelClosedBG.textureOffset);
+				nodes.resize(nodes.size() * 2 + 64);
+			}
+			UILayoutNode& node = nodes[nodeIndex];
+			node.parent = parentIndex;
+			node.firstChild = node.lastChild = node.nextSibling = -1;
+			node.childCount = 0;
+			node.firstItem = node.lastItem = node.nextItem = 0;
+			node.firstScissor = node.nextScissor = 0;
+			node.drawStackDepth = 0;
+			node.item = MainUIState.bHasNextLayoutItem ? MainUIState.nextLayoutItem : UILayoutItem();
+			node.drawPos = MainUIState.drawPosDimension.m_pos;
+			node.bContainer = bContainer;
+			node.bRow = false;
+			node.bFillCross = false;
+			MainUIState.bHasNextLayoutItem = false;
+
+			if (parentIndex >= 0)
+			{
+				UILayoutNode& parent = nodes[parentIndex];
+				node.id = GetNextLayoutChildId(parent);
+				node.root = parent.root;
+				if (parent.lastChild >= 0)
+				{
+					nodes[parent.lastChild].nextSibling = nodeIndex;
+				}
+				else
+				{
+					parent.firstChild = nodeIndex;
+				}
+				parent.lastChild = nodeIndex;
+				parent.childCount++;
 			}
 			else
 			{
-				MainUIState.drawer->DrawRect(closeRect, style.panelClosedBG.fillColor);
+				node.id = ComputeHashData((void*)&MainUIState.layoutRootCount, sizeof(UInt32), StackIDs.back());
+				node.root = nodeIndex;
+				MainUIState.layoutRootCount++;
 			}
+
+			return nodeIndex;
 		}
-		else
+
+		// Helper function: Draw position of next child. Known children start at their arranged place from previous frame, so their input rects match what is shown.
+		void PrepareLayoutChild(Int32 parentIndex)
 		{
-			if (style.panel.texture)
+			const UILayoutNode& parent = MainUIState.layoutNodes[parentIndex];
+			MainUIState.drawPosDimension.m_dimension = parent.contentRect.m_dimension;
+
+			const UILayoutNode* lastNode = FindLastLayoutNode(MainUIState.layoutNodeCount, GetNextLayoutChildId(parent));
+			if (lastNode)
 			{
-				MainUIState.drawer->DrawTexture(panelState.targetRect, style.panel.texture, style.panel.fillColor, style.panel.textureScale, style.panel.textureOffset);
+				MainUIState.drawPosDimension.m_pos = MainUIState.layoutNodes[parent.root].drawPos + lastNode->relativeRect.m_pos;
 			}
 			else
 			{
-				MainUIState.drawer->DrawRect(panelState.targetRect, style.panel.fillColor);
+				MainUIState.drawPosDimension.m_pos = parent.cursor;
 			}
 		}
-#endif
-		UIRect collapseIconRect;
-		collapseIconRect.m_pos = headerRect.m_pos + UIVector2(5.0f, 5.0f);
-#ifdef ZUI_STYLE_USE_NO_TEXTURE
-		collapseIconRect.m_dimension = style.collapseArrowSize;
-#else
-		collapseIconRect.m_dimension = style.panelOpened.textureSize;
-#endif
 
-		// adjusting the header rect
-		headerRect.m_pos.x += collapseIconRect.m_dimension.x + 10.0f;
-		headerRect.m_dimension.x -= collapseIconRect.m_dimension.x + 10.0f;
+		void EndLayoutChild(Int32 parentIndex, const UIVector2& childSize)
+		{
+			UILayoutNode& parent = MainUIState.layoutNodes[parentIndex];
+			parent.nextItem = MainUIState.drawer->getCurrentDrawList()->itemCount();
+			parent.nextScissor = MainUIState.drawer->GetScissorCount();
+			parent.cursor = parent.cursor + LayoutVector(LayoutMain(childSize, parent.bRow) + parent.style.spacing, 0.0f, parent.bRow);
+
+			PrepareLayoutChild(parentIndex);
+		}
+
+		void MeasureLayoutNode(UILayoutNode& node)
+		{
+			Float32 mainSize = 0.0f;
+			Float32 crossSize = 0.0f;
+			for (Int32 childIndex = node.firstChild; childIndex >= 0; childIndex = MainUIState.layoutNodes[childIndex].nextSibling)
+			{
+				const UIVector2& childSize = MainUIState.layoutNodes[childIndex].measuredSize;
+				const Float32 childCross = LayoutCross(childSize, node.bRow);
+				mainSize += LayoutMain(childSize, node.bRow);
+				crossSize = UIMAX(crossSize, childCross);
+			}
+
+			if (node.childCount > 1)
+			{
+				mainSize += node.style.spacing * (node.childCount - 1);
+			}
+
+			const UIVector4& padding = node.style.padding;
+			node.measuredSize = ClampLayoutSize(LayoutVector(mainSize, crossSize, node.bRow) + UIVector2(padding.x + padding.z, padding.y + padding.w), node.item);
+		}
+
+		void ArrangeLayoutNode(Int32 nodeIndex, const UIRect& rect)
+		{
+			UILayoutNode& node = MainUIState.layoutNodes[nodeIndex];
+			node.rect = rect;
+
+			if (!node.bContainer || node.childCount == 0) { return; }
+
+			const bool bRow = node.bRow;
+			const UIVector4& padding = node.style.padding;
+			const UIVector2 contentPos = rect.m_pos + UIVector2(padding.x, padding.y);
+			const UIVector2 contentSize = rect.m_dimension - UIVector2(padding.x + padding.z, padding.y + padding.w);
+			const Float32 contentCross = LayoutCross(contentSize, bRow);
+
+			Float32 usedSize = node.style.spacing * (node.childCount - 1);
+			Float32 totalGrow = 0.0f;
+			Float32 totalShrink = 0.0f;
+			for (Int32 childIndex = node.firstChild; childIndex >= 0; childIndex = MainUIState.layoutNodes[childIndex].nextSibling)
+			{
+				const UILayoutNode& child = MainUIState.layoutNodes[childIndex];
+				usedSize += LayoutMain(child.measuredSize, bRow);
+				totalGrow += child.item.grow;
+				totalShrink += child.item.shrink * LayoutMain(child.measuredSize, bRow);
+			}
+
+			const Float32 freeSpace = LayoutMain(contentSize, bRow) - usedSize;
+			Float32 mainPos = LayoutMain(contentPos, bRow);
+			if (freeSpace > 0.0f && totalGrow <= 0.0f)
+			{
+				if (node.style.mainAlign == LAYOUT_ALIGN_CENTER) { mainPos += freeSpace * 0.5f; }
+				else if (node.style.mainAlign == LAYOUT_ALIGN_END) { mainPos += freeSpace; }
+			}
+
+			for (Int32 childIndex = node.firstChild; childIndex >= 0; childIndex = MainUIState.layoutNodes[childIndex].nextSibling)
+			{
+				const UILayoutNode& child = MainUIState.layoutNodes[childIndex];
+				const Float32 measuredMain = LayoutMain(child.measuredSize, bRow);
+
+				Float32 childMain = measuredMain;
+				if (freeSpace > 0.0f && totalGrow > 0.0f)
+				{
+					childMain += freeSpace * child.item.grow / totalGrow;
+				}
+				else if (freeSpace < 0.0f && totalShrink > 0.0f)
+				{
+					childMain += freeSpace * child.item.shrink * measuredMain / totalShrink;
+				}
+				childMain = UICLAMP(LayoutMain(child.item.minSize, bRow), LayoutMain(child.item.maxSize, bRow), childMain);
+
+				Float32 childCross = LayoutCross(child.measuredSize, bRow);
+				Float32 crossPos = LayoutCross(contentPos, bRow);
+				switch (node.style.crossAlign)
+				{
+				case LAYOUT_ALIGN_STRETCH:
+					childCross = UICLAMP(LayoutCross(child.item.minSize, bRow), LayoutCross(child.item.maxSize, bRow), contentCross);
+					break;
+				case LAYOUT_ALIGN_CENTER:
+					crossPos += (contentCross - childCross) * 0.5f;
+					break;
+				case LAYOUT_ALIGN_END:
+					crossPos += contentCross - childCross;
+					break;
+				default:
+					break;
+				}
+
+				ArrangeLayoutNode(childIndex, UIRect(LayoutVector(mainPos, crossPos, bRow), LayoutVector(childMain, childCross, bRow)));
+				mainPos += childMain + node.style.spacing;
+			}
+		}
+
+		// Helper function: Move draw items of nodes drawn away from their arranged place and keep arranged rects for next frame
+		void ApplyLayout(Int32 rootIndex)
+		{
+			UIDrawList* drawList = MainUIState.drawer->getCurrentDrawList();
+			const UIVector2 rootPos = MainUIState.layoutNodes[rootIndex].rect.m_pos;
+
+			for (Int32 i = rootIndex; i < MainUIState.layoutNodeCount; i++)
+			{
+				UILayoutNode& node = MainUIState.layoutNodes[i];
+
+				// Nested roots (inside list, panel...) are already arranged and move with widget containing them
+				if (node.root != rootIndex) { continue; }
+
+#ifdef ZUI_DRAW_ITEM_PER_DRAW_CALL
+				const UIVector2 delta = node.rect.m_pos - node.drawPos;
+				if (delta.x != 0.0f || delta.y != 0.0f)
+				{
+					for (Int32 itemIndex = node.firstItem; itemIndex < node.lastItem; itemIndex++)
+					{
+						UIDrawItem* drawItem = drawList->getDrawItem(itemIndex);
+						drawItem->translate(delta, drawItem->getScissorIndex() >= node.firstScissor);
+					}
+				}
+#endif
+
+				node.relativeRect = UIRect(node.rect.m_pos - rootPos, node.rect.m_dimension);
+			}
+		}
+
+		// Helper function: Start row/column. bFillCross makes outermost container as wide (column) or tall (row) as current draw rect.
+		void BeginLayoutInternal(bool bRow, const UILayoutStyle& style, bool bFillCross)
+		{
+			const Int32 parentIndex = GetLayoutParent();
+			const Int32 nodeIndex = AddLayoutNode(parentIndex, true);
+
+			UILayoutNode& node = MainUIState.layoutNodes[nodeIndex];
+			node.bRow = bRow;
+			node.bFillCross = bFillCross;
+			node.style = style;
+			node.nextItem = parentIndex >= 0 ? MainUIState.layoutNodes[parentIndex].nextItem : MainUIState.drawer->getCurrentDrawList()->itemCount();
+			node.nextScissor = parentIndex >= 0 ? MainUIState.layoutNodes[parentIndex].nextScissor : MainUIState.drawer->GetScissorCount();
+
+			// Outermost container lays out in current draw rect, nested ones in their size from previous frame
+			UIVector2 size = MainUIState.drawPosDimension.m_dimension;
+			if (parentIndex >= 0)
+			{
+				const UILayoutNode* lastNode = FindLastLayoutNode(nodeIndex, node.id);
+				if (lastNode)
+				{
+					size = lastNode->relativeRect.m_dimension;
+				}
+			}
+
+			// Space available to outermost container, rect is set by arrange later
+			node.rect = MainUIState.drawPosDimension;
+
+			node.contentRect.m_pos = node.drawPos + UIVector2(style.padding.x, style.padding.y);
+			node.contentRect.m_dimension = size - UIVector2(style.padding.x + style.padding.z, style.padding.y + style.padding.w);
+			node.cursor = node.contentRect.m_pos;
+
+			MainUIState.drawPosDimensionStack.push_back(MainUIState.drawPosDimension);
+			MainUIState.drawDirectionStack.push_back(MainUIState.drawDirection);
+			MainUIState.drawDirection = bRow ? UIVector2(1.0f, 0.0f) : UIVector2(0.0f, 1.0f);
+
+			node.drawStackDepth = (Int32)MainUIState.drawPosDimensionStack.size();
+			MainUIState.layoutStack.push_back(nodeIndex);
+
+			PrepareLayoutChild(nodeIndex);
+		}
+
+		void EndLayoutInternal()
+		{
+			const Int32 nodeIndex = MainUIState.layoutStack.back();
+			MainUIState.layoutStack.pop_back();
+
+			UILayoutNode& node = MainUIState.layoutNodes[nodeIndex];
+			node.firstItem = node.nextItem;
+			node.lastItem = MainUIState.drawer->getCurrentDrawList()->itemCount();
+			node.firstScissor = node.nextScissor;
+
+			MeasureLayoutNode(node);
+
+			MainUIState.drawPosDimension = MainUIState.drawPosDimensionStack.back();
+			MainUIState.drawPosDimensionStack.pop_back();
+
+			MainUIState.drawDirection = MainUIState.drawDirectionStack.back();
+			MainUIState.drawDirectionStack.pop_back();
+
+			if (node.parent >= 0)
+			{
+				EndLayoutChild(node.parent, node.measuredSize);
+				return;
+			}
+
+			// Outermost container ended, whole tree is measured: arrange it and move drawn widgets to their place.
+			// It takes all available space along its direction when it grows, aligns children or has growing children.
+			const bool bRow = node.bRow;
+			const UIVector2 availableSize = node.rect.m_dimension;
+			bool bFillMain = node.item.grow > 0.0f || node.style.mainAlign != LAYOUT_ALIGN_START;
+			for (Int32 childIndex = node.firstChild; childIndex >= 0 && !bFillMain; childIndex = MainUIState.layoutNodes[childIndex].nextSibling)
+			{
+				bFillMain = MainUIState.layoutNodes[childIndex].item.grow > 0.0f;
+			}
+
+			Float32 mainSize = LayoutMain(node.measuredSize, bRow);
+			Float32 crossSize = LayoutCross(node.measuredSize, bRow);
+			if (bFillMain)
+			{
+				mainSize = UIMAX(mainSize, LayoutMain(availableSize, bRow));
+			}
+			if (node.bFillCross)
+			{
+				crossSize = LayoutCross(availableSize, bRow);
+			}
+
+			const UIRect rootRect(node.drawPos, LayoutVector(mainSize, crossSize, bRow));
+			ArrangeLayoutNode(nodeIndex, rootRect);
+			ApplyLayout(nodeIndex);
+
+			AdvanceDrawPos(rootRect.m_dimension);
+		}
+
+		void ExcludeFromLayout()
+		{
+			const Int32 parentIndex = GetLayoutParent();
+			if (parentIndex >= 0)
+			{
+				MainUIState.layoutNodes[parentIndex].nextItem = MainUIState.drawer->getCurrentDrawList()->itemCount();
+				MainUIState.layoutNodes[parentIndex].nextScissor = MainUIState.drawer->GetScissorCount();
+			}
+		}
+	}
+
+	void UI::BeginRow(const UILayoutStyle& style /*= DefaultLayoutStyle*/)
+	{
+		BeginLayoutInternal(true, style, false);
+	}
+
+	void UI::EndRow()
+	{
+		EndLayoutInternal();
+	}
+
+	void UI::BeginColumn(const UILayoutStyle& style /*= DefaultLayoutStyle*/)
+	{
+		BeginLayoutInternal(false, style, false);
+	}
+
+	void UI::EndColumn()
+	{
+		EndLayoutInternal();
+	}
+
+	void UI::SetNextLayoutItem(Float32 grow, Float32 shrink /*= 0.0f*/, const UIVector2& minSize /*= UIVector2(0.0f)*/, const UIVector2& maxSize /*= UIVector2(1.0e30f)*/)
+	{
+		MainUIState.nextLayoutItem.grow = grow;
+		MainUIState.nextLayoutItem.shrink = shrink;
+		MainUIState.nextLayoutItem.minSize = minSize;
+		MainUIState.nextLayoutItem.maxSize = maxSize;
+		MainUIState.bHasNextLayoutItem = true;
+
+		// Widget sized by draw rect gets its arranged size from previous frame
+		const Int32 parentIndex = GetLayoutParent();
+		if (parentIndex >= 0)
+		{
+			const UILayoutNode* lastNode = FindLastLayoutNode(MainUIState.layoutNodeCount, GetNextLayoutChildId(MainUIState.layoutNodes[parentIndex]));
+			if (lastNode)
+			{
+				MainUIState.drawPosDimension.m_dimension = lastNode->relativeRect.m_dimension;
+			}
+		}
+	}
+
+	void UI::AdvanceDrawPos(const UIVector2& size, Float32 spacing /*= 5.0f*/)
+	{
+		const Int32 parentIndex = GetLayoutParent();
+		if (parentIndex < 0)
+		{
+			MainUIState.drawPosDimension.m_pos = MainUIState.drawPosDimension.m_pos + MainUIState.drawDirection * size + UIVector2(spacing) * MainUIState.drawDirection;
+			return;
+		}
+
+		const Int32 nodeIndex = AddLayoutNode(parentIndex, false);
+		UILayoutNode& node = MainUIState.layoutNodes[nodeIndex];
+		const UILayoutNode& parent = MainUIState.layoutNodes[parentIndex];
+		node.measuredSize = ClampLayoutSize(size, node.item);
+
+		// Growing widget that took all offered size is measured at its min size, so growing can be worked out again each frame
+		if (node.item.grow > 0.0f && LayoutMain(size, parent.bRow) == LayoutMain(MainUIState.drawPosDimension.m_dimension, parent.bRow))
+		{
+			node.measuredSize = LayoutVector(LayoutMain(node.item.minSize, parent.bRow), LayoutCross(node.measuredSize, parent.bRow), parent.bRow);
+		}
+
+		node.firstItem = parent.nextItem;
+		node.lastItem = MainUIState.drawer->getCurrentDrawList()->itemCount();
+		node.firstScissor = parent.nextScissor;
+
+		EndLayoutChild(parentIndex, node.measuredSize);
+	}
+
+	namespace UI
+	{
+		bool BeginPanelInternal(const UIChar* panelLabel, const UIRect initialRect, bool bAutoSize, bool bCached, const UIPanelStyle& style);
+		void EndPanelCache(UInt32 panelId, UIPanelState& panelState);
+	}
+
+	bool UI::BeginPanel(const UIChar* panelLabel, const UIRect initialRect, bool bAutoSize, const UIPanelStyle& style /*= DefaultPanelStyle*/)
+	{
+		return BeginPanelInternal(panelLabel, initialRect, bAutoSize, false, style);
+	}
+
+	bool UI::BeginCachedPanel(const UIChar* panelLabel, const UIRect initialRect, bool bAutoSize, const UIPanelStyle& style /*= DefaultPanelStyle*/)
+	{
+		return BeginPanelInternal(panelLabel, initialRect, bAutoSize, true, style);
+	}
+
+	bool UI::BeginPanelInternal(const UIChar* panelLabel, const UIRect initialRect, bool bAutoSize, bool bCached, const UIPanelStyle& style)
+	{
+		const UInt32 _id = GetUIIDFromString(panelLabel);
+
+		StackIDs.push_back(_id);
+
+		bool bCreated;
+		UIPanelState& panelState = MainUIState.panelStates.findOrAdd(_id, &bCreated);
+		if (bCreated)
+		{
+			panelState.targetRect = initialRect;
+			panelState.contentSize = initialRect.m_dimension;
+			panelState.scrollOffset = 0.0f;
+			panelState.bAutoSize = bAutoSize;
+			panelState.bCollapsed = false;
+			panelState.activeChildId = 0;
+			panelState.bodyEntryActiveId = 0;
+			panelState.cacheFirstItem = 0;
+			panelState.bodyFirstItem = 0;
+		}
+
+		// Everything panel draws from here until end of EndPanel goes to its cache
+#ifdef ZUI_DRAW_ITEM_PER_DRAW_CALL
+		panelState.bCached = bCached && !MainUIState.bRenderTargetUnsupported;
+#else
+		panelState.bCached = false;
+#endif
+		panelState.cacheFirstItem = MainUIState.drawer->getCurrentDrawList()->itemCount();
+
+		UIRect headerRect;
+		headerRect.m_pos = panelState.targetRect.m_pos;
+		headerRect.m_dimension.x = panelState.targetRect.m_dimension.x;
+		headerRect.m_dimension.y = style.headerHeight;
+		panelState.headerSize = headerRect.m_dimension;
+
+		// Panel blocks widgets under it. Widgets inside are recorded later, so they stay on top of it.
+		const bool bPanelHovered = CheckMouseHover(_id, panelState.bCollapsed ? headerRect : panelState.targetRect);
+
+#ifdef ZUI_STYLE_USE_NO_TEXTURE
+		if (!panelState.bCollapsed)
+		{
+			// Border grows outward, so corner roundness of panel fill stays the same
+			const Float32 borderRoundness = panelState.targetRect.m_roundness > 0.0f ? panelState.targetRect.m_roundness + style.borderSize : 0.0f;
+			const UIRect borderRect(panelState.targetRect.m_pos - UIVector2(style.borderSize), panelState.targetRect.m_dimension + UIVector2(2.0f * style.borderSize), borderRoundness);
+			MainUIState.drawer->DrawBorderRect(borderRect, style.fillColor, style.borderSize, style.borderColor);
+		}
+		else
+		{
+			MainUIState.drawer->DrawRect(headerRect + UIRect(UIVector2(-style.borderSize), UIVector2(2.0f*style.borderSize)), style.borderColor);
+
+		}
+		MainUIState.drawer->DrawRect(UIRect(panelState.targetRect.m_pos, UIVector2(panelState.targetRect.m_dimension.x, headerRect.m_dimension.y + style.headerOffset)), style.headerColor);
+		MainUIState.drawer->DrawRect(UIRect(UIVector2(panelState.targetRect.m_pos.x, panelState.targetRect.m_pos.y + panelState.headerSize.y + style.headerOffset), UIVector2(panelState.targetRect.m_dimension.x, style.borderSize)), style.borderColor);
+#else
+		// Draw Panel
+		if (panelState.bCollapsed)
+		{
+			UIRect closeRect;
+			closeRect.m_pos = panelState.targetRect.m_pos;
+			closeRect.m_dimension = { panelState.targetRect.m_dimension.x, panelState.headerSize.y + 5.0f };
+			closeRect.m_roundness = panelState.targetRect.m_roundness;
+			if (style.panelClosedBG.texture)
+			{
+				MainUIState.drawer->DrawTexture(closeRect, style.panelClosedBG.texture, style.panelClosedBG.fillColor, style.panelClosedBG.textureScale, style.panelClosedBG.textureOffset);
+			}
+			else
+			{
+				MainUIState.drawer->DrawRect(closeRect, style.panelClosedBG.fillColor);
+			}
+		}
+		else
+		{
+			if (style.panel.texture)
+			{
+				MainUIState.drawer->DrawTexture(panelState.targetRect, style.panel.texture, style.panel.fillColor, style.panel.textureScale, style.panel.textureOffset);
+			}
+			else
+			{
+				MainUIState.drawer->DrawRect(panelState.targetRect, style.panel.fillColor);
+			}
+		}
+#endif
+		UIRect collapseIconRect;
+		collapseIconRect.m_pos = headerRect.m_pos + UIVector2(5.0f, 5.0f);
+#ifdef ZUI_STYLE_USE_NO_TEXTURE
+		collapseIconRect.m_dimension = style.collapseArrowSize;
+#else
+		collapseIconRect.m_dimension = style.panelOpened.textureSize;
+#endif
+
+		// adjusting the header rect
+		headerRect.m_pos.x += collapseIconRect.m_dimension.x + 10.0f;
+		headerRect.m_dimension.x -= collapseIconRect.m_dimension.x + 10.0f;
 
 		UIFont* font = style.headerFontStyle.font ? style.headerFontStyle.font : DefaultFont;
 		DrawTextInRect(headerRect, panelLabel, COLOR_WHITE, TEXT_LEFT, TEXT_V_CENTER, style.headerFontStyle.fontScale, font);
@@ -1719,7 +3046,7 @@ namespace ZE
 		if (!DoPanelCollapseButton(panelState, collapseIconRect, style))
 		{
 			bool bJustActive = false;
-			const bool mouseInside = CheckMouseInside(headerRect);
+			const bool mouseInside = bPanelHovered && CheckMouseInside(headerRect);
 			if ((MainUIState.activeItem.id == _id || mouseInside) && MainUIState.mouseState == EButtonState::BUTTON_DOWN)
 			{
 				bJustActive = MainUIState.activeItem.id != _id;
@@ -1744,46 +3071,118 @@ namespace ZE
 			}
 		}
 
+		MainUIState.panelDrawInfos.push_back({ _id, panelState.targetRect, IsPanelOpaque(panelState, style) });
+
 		// Panel is closed, stop now
 		if (panelState.bCollapsed)
 		{
+			ExcludeFromLayout();
+			StackIDs.pop_back();
+			return false;
+		}
+
+		// Nothing of panel body can be seen, skip it unless an item inside it is still active
+		const bool bHasActiveChild = panelState.activeChildId != 0 && MainUIState.activeItem.id == panelState.activeChildId;
+		if (!bHasActiveChild && IsPanelHidden(_id, panelState.targetRect))
+		{
+			ExcludeFromLayout();
 			StackIDs.pop_back();
 			return false;
 		}
 
 		MainUIState.drawPosDimensionStack.push_back(MainUIState.drawPosDimension);
 
+		const UIVector4& padding = style.contentPadding;
 		MainUIState.drawPosDimension = panelState.targetRect;
-		MainUIState.drawPosDimension.m_pos.x += 10.0f;
-		MainUIState.drawPosDimension.m_pos.y += style.headerHeight + 5.0f;
-		MainUIState.drawPosDimension.m_dimension.x -= 40.0f;
-		MainUIState.drawPosDimension.m_dimension.y -= style.headerHeight + 10.0f;
+		MainUIState.drawPosDimension.m_pos.x += padding.x;
+		MainUIState.drawPosDimension.m_pos.y += style.headerHeight + padding.y;
+		MainUIState.drawPosDimension.m_dimension.x -= padding.x + padding.z;
+		MainUIState.drawPosDimension.m_dimension.y -= style.headerHeight + padding.y + padding.w;
+		panelState.bottomPadding = padding.w;
+		panelState.bodyTop = style.headerHeight + padding.y;
 
 		MainUIState.drawDirectionStack.push_back(MainUIState.drawDirection);
 		MainUIState.drawDirection = UIVector2(0.0f, 1.0f);
 
-		if (panelState.bAutoSize)
-		{
-			panelState.targetRect.m_dimension.y = panelState.contentSize.y;
-		}
-
 		MainUIState.drawer->PushRectMask(MainUIState.drawPosDimension);
 		PushDrawRect(MainUIState.drawPosDimension);
+		panelState.bodyFirstItem = MainUIState.drawer->getCurrentDrawList()->itemCount();
 
 		MainUIState.drawPosDimension.m_pos.y -= panelState.scrollOffset;
 
+		panelState.bodyEntryActiveId = MainUIState.activeItem.id;
+
+		// Panel body is a column as wide as panel, measured while widgets are drawn
+		static UILayoutStyle bodyLayoutStyle;
+		bodyLayoutStyle = DefaultLayoutStyle;
+		bodyLayoutStyle.padding = UIVector4(0.0f);
+		bodyLayoutStyle.spacing = 5.0f;
+		bodyLayoutStyle.crossAlign = LAYOUT_ALIGN_STRETCH;
+		BeginLayoutInternal(false, bodyLayoutStyle, true);
+
 		return true;
 	}
 
+	namespace UI
+	{
+		// Helper function: Fit auto size panel to content measured this frame. Background was drawn with previous size, so stretch it.
+		void FitAutoSizePanel(UInt32 panelId, UIPanelState& panelState)
+		{
+			const Float32 delta = panelState.contentSize.y - panelState.targetRect.m_dimension.y;
+			if (delta == 0.0f) { return; }
+
+#ifdef ZUI_DRAW_ITEM_PER_DRAW_CALL
+			const Float32 halfHeight = panelState.targetRect.m_dimension.y * 0.5f;
+			const Float32 splitY = panelState.targetRect.m_pos.y + UIMAX(halfHeight, panelState.bodyTop);
+
+			UIDrawList* drawList = MainUIState.drawer->getCurrentDrawList();
+			for (Int32 i = panelState.cacheFirstItem; i < panelState.bodyFirstItem; i++)
+			{
+				drawList->getDrawItem(i)->extendBottom(splitY, delta);
+			}
+#endif
+
+			panelState.targetRect.m_dimension.y = panelState.contentSize.y;
+
+			for (Int32 i = (Int32)MainUIState.panelDrawInfos.size() - 1; i >= 0; i--)
+			{
+				if (MainUIState.panelDrawInfos[i].id == panelId)
+				{
+					MainUIState.panelDrawInfos[i].rect = panelState.targetRect;
+					break;
+				}
+			}
+		}
+	}
+
 	void UI::EndPanel()
 	{
+		UInt32 parentId = StackIDs.back();
+		UIPanelState& panelState = MainUIState.panelStates.findOrAdd(parentId);
+
+		// Body column is measured now, content size is known on the same frame
+		const Int32 bodyNodeIndex = MainUIState.layoutStack.back();
+		EndLayoutInternal();
+		const UIRect& bodyRect = MainUIState.layoutNodes[bodyNodeIndex].rect;
+		panelState.contentSize.y = bodyRect.m_pos.y + bodyRect.m_dimension.y + panelState.bottomPadding - (panelState.targetRect.m_pos.y - panelState.scrollOffset);
+
+		if (panelState.bAutoSize)
+		{
+			FitAutoSizePanel(parentId, panelState);
+		}
+
 		MainUIState.drawer->PopMask();
 		PopDrawRect();
 
-		UInt32 parentId = StackIDs.back();
-		UIPanelState& panelState = MainUIState.panelStates[parentId];
-		panelState.contentSize.y = MainUIState.drawPosDimension.m_pos.y - (panelState.targetRect.m_pos.y - panelState.scrollOffset);
-
+		// Track item that was activated inside panel body
+		if (MainUIState.activeItem.id != panelState.bodyEntryActiveId)
+		{
+			panelState.activeChildId = MainUIState.activeItem.id;
+		}
+		else if (MainUIState.activeItem.id != panelState.activeChildId)
+		{
+			panelState.activeChildId = 0;
+		}
 		UIRect newRect = MainUIState.drawPosDimensionStack.back();
 		MainUIState.drawPosDimension = newRect;
 		MainUIState.drawPosDimensionStack.pop_back();
@@ -1809,9 +3208,236 @@ namespace ZE
 			panelState.scrollOffset = 0.0f;
 		}
 
+		if (panelState.bCached)
+		{
+			EndPanelCache(parentId, panelState);
+		}
+
+		ExcludeFromLayout();
+
 		StackIDs.pop_back();
 	}
 
+	namespace UI
+	{
+		UInt32 ComputeDrawItemHash(const UIDrawItem* drawItem, const UIArray<UIVertex>& vertices, const UIArray<UIDrawInstance>& instances);
+		UIRect ComputeDrawItemBounds(const UIDrawItem* drawItem, const UIArray<UIVertex>& vertices, const UIArray<UIDrawInstance>& instances);
+
+		void DestroyPanelCache(UIPanelCache& panelCache)
+		{
+			MainUIState.renderer->destroyRenderTarget(panelCache.textureHandle);
+			MainUIState.panelCacheBytes -= panelCache.width * panelCache.height * 4;
+			UIFREE(panelCache.drawList);
+		}
+
+		// Helper function: Make room for new panel texture, panels used this frame are kept
+		bool EvictPanelCaches(UInt32 requiredBytes)
+		{
+			while (MainUIState.panelCacheBytes + requiredBytes > ZUI_PANEL_CACHE_MAX_BYTES)
+			{
+				auto lruIter = MainUIState.panelCaches.end();
+				for (auto iter = MainUIState.panelCaches.begin(); iter != MainUIState.panelCaches.end(); ++iter)
+				{
+					if (iter->second.lastUsedFrame != MainUIState.frameCount && (lruIter == MainUIState.panelCaches.end() || iter->second.lastUsedFrame < lruIter->second.lastUsedFrame))
+					{
+						lruIter = iter;
+					}
+				}
+
+				if (lruIter == MainUIState.panelCaches.end())
+				{
+					return false;
+				}
+
+				DestroyPanelCache(lruIter->second);
+				MainUIState.panelCaches.erase(lruIter);
+			}
+
+			return true;
+		}
+
+		void EndPanelCache(UInt32 panelId, UIPanelState& panelState)
+		{
+			UIDrawList* drawList = MainUIState.drawer->getCurrentDrawList();
+			const Int32 firstItem = panelState.cacheFirstItem;
+
+			// Cache whole screen area panel draws into
+			UIVector2 minPos(1.0e30f);
+			UIVector2 maxPos(-1.0e30f);
+			UInt32 contentHash = 0;
+			for (Int32 i = firstItem; i < drawList->itemCount(); i++)
+			{
+				UIDrawItem* drawItem = drawList->getDrawItem(i);
+
+				// Popups are drawn over other panels, can't be inside panel texture
+				if (drawItem->getLayer() > 0) { return; }
+
+				const UIRect bounds = ComputeDrawItemBounds(drawItem, drawItem->getVertices(), drawItem->getInstances());
+				if (bounds.m_dimension.x > 0.0f && bounds.m_dimension.y > 0.0f)
+				{
+					minPos.x = UIMIN(minPos.x, bounds.m_pos.x);
+					minPos.y = UIMIN(minPos.y, bounds.m_pos.y);
+					maxPos.x = UIMAX(maxPos.x, bounds.m_pos.x + bounds.m_dimension.x);
+					maxPos.y = UIMAX(maxPos.y, bounds.m_pos.y + bounds.m_dimension.y);
+				}
+
+				const UInt32 itemHash = ComputeDrawItemHash(drawItem, drawItem->getVertices(), drawItem->getInstances());
+				contentHash = ComputeHashData((void*)&itemHash, sizeof(itemHash), contentHash);
+			}
+
+			minPos.x = UIMAX(floorf(minPos.x), 0.0f);
+			minPos.y = UIMAX(floorf(minPos.y), 0.0f);
+			maxPos.x = UIMIN(ceilf(maxPos.x), (Float32)MainUIState.screenWidth);
+			maxPos.y = UIMIN(ceilf(maxPos.y), (Float32)MainUIState.screenHeight);
+			if (minPos.x >= maxPos.x || minPos.y >= maxPos.y) { return; }
+
+			const UIRect cacheRect(minPos, maxPos - minPos);
+			const UInt32 width = (UInt32)cacheRect.m_dimension.x;
+			const UInt32 height = (UInt32)cacheRect.m_dimension.y;
+			contentHash = ComputeHashData((void*)&cacheRect.m_pos, sizeof(UIVector2), contentHash);
+
+			// Hovered or active item inside panel
+			UInt32 interactionKey = 0;
+			if (panelState.activeChildId != 0 || CheckMouseInside(panelState.targetRect))
+			{
+				interactionKey = ComputeHashData((void*)&MainUIState.hotItem.id, sizeof(UInt32), interactionKey);
+				interactionKey = ComputeHashData((void*)&MainUIState.activeItem.id, sizeof(UInt32), interactionKey);
+			}
+
+			bool bRender = false;
+			UIPanelCache* panelCache = nullptr;
+			auto iter = MainUIState.panelCaches.find(panelId);
+			if (iter != MainUIState.panelCaches.end())
+			{
+				panelCache = &iter->second;
+				if (panelCache->width != width || panelCache->height != height)
+				{
+					DestroyPanelCache(*panelCache);
+					MainUIState.panelCaches.erase(iter);
+					panelCache = nullptr;
+				}
+			}
+
+			if (!panelCache)
+			{
+				if (!EvictPanelCaches(width * height * 4)) { return; }
+
+				const UInt32 textureHandle = MainUIState.renderer->createRenderTarget(width, height);
+				if (textureHandle == 0)
+				{
+					MainUIState.bRenderTargetUnsupported = true;
+					return;
+				}
+
+				UIPanelCache newCache;
+				newCache.textureHandle = textureHandle;
+				newCache.width = width;
+				newCache.height = height;
+				newCache.version = 0;
+				newCache.drawList = UINEW(UIDrawList);
+				MainUIState.panelCaches[panelId] = newCache;
+				MainUIState.panelCacheBytes += width * height * 4;
+
+				panelCache = &MainUIState.panelCaches[panelId];
+				bRender = true;
+			}
+
+			bRender = bRender || panelCache->contentHash != contentHash || panelCache->interactionKey != interactionKey;
+			panelCache->contentHash = contentHash;
+			panelCache->interactionKey = interactionKey;
+			panelCache->lastUsedFrame = MainUIState.frameCount;
+
+			// Panel items are either rendered into its texture or already there
+			if (bRender)
+			{
+				panelCache->drawList->reset();
+				drawList->moveItemsTo(*panelCache->drawList, firstItem);
+				panelCache->drawList->updateBounds();
+				panelCache->drawList->sortItems();
+				MainUIState.renderer->renderToTarget(panelCache->textureHandle, panelCache->drawList, cacheRect);
+				panelCache->version++;
+			}
+			else
+			{
+				drawList->truncate(firstItem);
+			}
+
+			MainUIState.drawer->DrawRenderTarget(cacheRect, panelCache->textureHandle, panelCache->version);
+		}
+	}
+
+	void DestroyPanelCaches()
+	{
+		for (auto& panelCache : UI::MainUIState.panelCaches)
+		{
+			UI::DestroyPanelCache(panelCache.second);
+		}
+		UI::MainUIState.panelCaches.clear();
+	}
+
+	namespace UI
+	{
+		// Helper to set up draw position, mask and draw rect of a scrolled list area
+		void BeginScrollArea(UIScrollState& scrollState, const UIRect& rect, bool hasParent)
+		{
+			MainUIState.drawPosDimensionStack.push_back(MainUIState.drawPosDimension);
+
+			if (hasParent)
+			{
+				MainUIState.drawPosDimension.m_pos += rect.m_pos;
+				MainUIState.drawPosDimension.m_dimension = rect.m_dimension;
+			}
+			else
+			{
+				MainUIState.drawPosDimension = rect;
+			}
+			scrollState.targetRect = MainUIState.drawPosDimension;
+
+			MainUIState.drawDirectionStack.push_back(MainUIState.drawDirection);
+			MainUIState.drawDirection = UIVector2(0.0f, 1.0f);
+
+			MainUIState.drawer->PushRectMask(MainUIState.drawPosDimension);
+			PushDrawRect(MainUIState.drawPosDimension);
+
+			MainUIState.drawPosDimension.m_pos.y -= scrollState.scrollOffset;
+		}
+
+		// Helper to restore draw position and handle scroll bar of a scrolled list area. scrollState.contentSize has to be set before.
+		void EndScrollArea(UIScrollState& scrollState, bool hasParent)
+		{
+			PopDrawRect();
+			MainUIState.drawer->PopMask();
+
+			MainUIState.drawDirection = MainUIState.drawDirectionStack.back();
+			MainUIState.drawDirectionStack.pop_back();
+
+			MainUIState.drawPosDimension = MainUIState.drawPosDimensionStack.back();
+			MainUIState.drawPosDimensionStack.pop_back();
+
+			// Add scrollbar
+			if (scrollState.targetRect.m_dimension.y < scrollState.contentSize.y)
+			{
+				if (CheckMouseInside(scrollState.targetRect))
+				{
+					Float32 mouseScroll = MainUIState.UseScrollOffset();
+					scrollState.scrollOffset += mouseScroll * -10.0f;
+					scrollState.scrollOffset = UICLAMP(0.0f, scrollState.contentSize.y - scrollState.targetRect.m_dimension.y, scrollState.scrollOffset);
+				}
+				scrollState.scrollOffset = DoScrollBar(UIVector2(scrollState.targetRect.m_pos.x + scrollState.targetRect.m_dimension.x - 5, scrollState.targetRect.m_pos.y), scrollState.scrollOffset, scrollState.targetRect.m_dimension.y, scrollState.contentSize.y);
+			}
+			else
+			{
+				scrollState.scrollOffset = 0.0f;
+			}
+
+			// After scrollbar, so its items move with the list
+			if (hasParent)
+			{
+				AdvanceDrawPos(scrollState.targetRect.m_dimension, 0.0f);
+			}
+		}
+	}
+
 	void UI::BeginListView(const UIChar* listName, const UIRect& rect)
 	{
 		const UInt32 _id = GetUIIDFromString(listName);
@@ -1820,223 +3446,1426 @@ namespace ZE
 
 		StackIDs.push_back(_id);
 
-		if (!(HashMapHas(MainUIState.scrollStates, _id)))
+		bool bCreated;
+		UIScrollState& scrollState = MainUIState.scrollStates.findOrAdd(_id, &bCreated);
+		if (bCreated)
 		{
-			UIScrollState scrollState;
 			scrollState.targetRect = rect;
 			scrollState.contentSize = rect.m_dimension;
 			scrollState.scrollOffset = 0.0f;
-			MainUIState.scrollStates[_id] = scrollState;
 		}
 
-		UIScrollState& scrollState = MainUIState.scrollStates[_id];
+		BeginScrollArea(scrollState, rect, hasParent);
+	}
 
-		MainUIState.drawPosDimensionStack.push_back(MainUIState.drawPosDimension);
+	void UI::EndListView()
+	{
+		const bool hasParent = StackIDs.size() > 2;
+		const UInt32 _id = StackIDs.back();
 
-		if (hasParent)
+		UIScrollState& scrollState = MainUIState.scrollStates.findOrAdd(_id);
+		scrollState.contentSize.y = MainUIState.drawPosDimension.m_pos.y - (scrollState.targetRect.m_pos.y - scrollState.scrollOffset);
+
+		EndScrollArea(scrollState, hasParent);
+
+		StackIDs.pop_back();
+	}
+
+	UInt32 UI::BeginVirtualListView(const UIChar* listName, const UIRect& rect, UInt32 itemCount, Float32 estimatedItemHeight)
+	{
+		const UInt32 _id = GetUIIDFromString(listName);
+
+		const bool hasParent = StackIDs.size() > 1;
+
+		StackIDs.push_back(_id);
+
+		bool bCreated;
+		UIVirtualListState& listState = MainUIState.virtualListStates.findOrAdd(_id, &bCreated);
+		if (bCreated)
 		{
-			MainUIState.drawPosDimension.m_pos += rect.m_pos;
-			MainUIState.drawPosDimension.m_dimension = rect.m_dimension;
+			listState.targetRect = rect;
+			listState.contentSize = rect.m_dimension;
+			listState.scrollOffset = 0.0f;
+			listState.rowStartPos = 0.0f;
+			listState.itemCache = nullptr;
 		}
-		else
+		MainUIState.virtualListStack.push_back(&listState);
+
+		// Keep measured heights of existing rows, new rows start with the estimate
+		if (listState.rowHeights.count() != itemCount)
 		{
-			MainUIState.drawPosDimension = rect;
+			listState.rowHeights.resize(itemCount, estimatedItemHeight);
 		}
-		scrollState.targetRect = MainUIState.drawPosDimension;
 
-		MainUIState.drawDirectionStack.push_back(MainUIState.drawDirection);
-		MainUIState.drawDirection = UIVector2(0.0f, 1.0f);
+		BeginScrollArea(listState, rect, hasParent);
 
-		MainUIState.drawer->PushRectMask(MainUIState.drawPosDimension);
-		PushDrawRect(MainUIState.drawPosDimension);
+		if (itemCount == 0) { return 0; }
 
-		MainUIState.drawPosDimension.m_pos.y -= scrollState.scrollOffset;
+		// Skip to first visible row
+		UInt32 firstRow = listState.rowHeights.findIndexAtOffset(listState.scrollOffset);
+		MainUIState.drawPosDimension.m_pos.y += (Float32)listState.rowHeights.getOffset(firstRow);
+
+		return firstRow;
 	}
 
-	void UI::EndListView()
+	bool UI::BeginVirtualListItem(UInt32 index)
+	{
+		UIVirtualListState* listState = MainUIState.virtualListStack.back();
+		if (index >= listState->rowHeights.count()) { return false; }
+
+		if (MainUIState.drawPosDimension.m_pos.y > listState->targetRect.m_pos.y + listState->targetRect.m_dimension.y) { return false; }
+
+		listState->rowStartPos = MainUIState.drawPosDimension.m_pos.y;
+		return true;
+	}
+
+	void UI::EndVirtualListItem(UInt32 index)
+	{
+		UIVirtualListState* listState = MainUIState.virtualListStack.back();
+		listState->rowHeights.setHeight(index, MainUIState.drawPosDimension.m_pos.y - listState->rowStartPos);
+	}
+
+	void UI::EndVirtualListView()
 	{
 		const bool hasParent = StackIDs.size() > 2;
-		const UInt32 _id = StackIDs.back();
 
-		UIScrollState& scrollState = MainUIState.scrollStates[_id];
-		scrollState.contentSize.y = MainUIState.drawPosDimension.m_pos.y - (scrollState.targetRect.m_pos.y - scrollState.scrollOffset);
+		UIVirtualListState* listState = MainUIState.virtualListStack.back();
+		MainUIState.virtualListStack.pop_back();
+
+		listState->contentSize.y = (Float32)listState->rowHeights.getTotalHeight();
+
+		EndScrollArea(*listState, hasParent);
+
+		StackIDs.pop_back();
+	}
+
+	// Bounded block cache of an asynchronous item list, owned by a virtual list view
+	class UIItemListCache
+	{
+	public:
+		struct Block
+		{
+			UInt32 blockIndex;
+			UInt32 lastUsed;
+			bool bLoaded;
+			UIItemListBlock items;
+		};
+
+		~UIItemListCache();
+
+		// Start fetching items for this frame
+		void beginFetch(AsyncItemListProvider* provider, UInt32 itemCount);
+
+		// Fetch items [first, first + count), placeholder for items not loaded yet. Missing blocks get requested.
+		void fetchRange(UInt32 first, UInt32 count, const UIChar** outItems);
+
+		// Request blocks ahead of the scroll direction
+		void prefetch(UInt32 firstRow, UInt32 lastRow);
+
+		// Called from loader: load block if it is still wanted
+		void loadBlock(UInt32 blockIndex, UInt32 generation);
+
+	protected:
+		Block* findBlock(UInt32 blockIndex);
+		Block* requestBlock(UInt32 blockIndex);
+
+		AsyncItemListProvider* m_provider = nullptr;
+		UInt32 m_itemCount = 0;
+		UInt32 m_generation = 0;
+		UInt32 m_useCounter = 0;
+		UInt32 m_lastFirstRow = 0;
+		Int32 m_scrollDirection = 1;
+		UIArray<Block*> m_blocks;
+
+#ifdef ZUI_USE_ASYNC_LIST_LOADER
+		std::mutex m_mutex;
+#endif
+	};
+
+#ifdef ZUI_USE_ASYNC_LIST_LOADER
+	// Background thread that loads blocks of asynchronous item lists
+	class UIItemListLoader
+	{
+	public:
+		struct Request
+		{
+			UIItemListCache* cache;
+			UInt32 blockIndex;
+			UInt32 generation;
+		};
+
+		void push(const Request& request);
+		void stop();
+
+		// Drop requests of cache and wait until loader isn't loading for it, so cache can be freed
+		void cancel(UIItemListCache* cache);
+
+	protected:
+		void run();
+
+		std::thread m_thread;
+		std::mutex m_mutex;
+		std::condition_variable m_condition;
+		UIArray<Request> m_requests;
+		UIItemListCache* m_loadingCache = nullptr;
+		bool m_bRunning = false;
+	};
+
+	static UIItemListLoader ItemListLoader;
+
+	void UIItemListLoader::push(const Request& request)
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			if (!m_bRunning)
+			{
+				m_bRunning = true;
+				m_thread = std::thread(&UIItemListLoader::run, this);
+			}
+			m_requests.push_back(request);
+		}
+		m_condition.notify_one();
+	}
+
+	void UIItemListLoader::stop()
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_bRunning = false;
+			m_requests.clear();
+		}
+		m_condition.notify_one();
+
+		if (m_thread.joinable())
+		{
+			m_thread.join();
+		}
+	}
+
+	void UIItemListLoader::cancel(UIItemListCache* cache)
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+		m_requests.erase(std::remove_if(m_requests.begin(), m_requests.end(), [cache](const Request& request) { return request.cache == cache; }), m_requests.end());
+		m_condition.wait(lock, [this, cache]() { return m_loadingCache != cache; });
+	}
+
+	void UIItemListLoader::run()
+	{
+		while (true)
+		{
+			Request request;
+			{
+				std::unique_lock<std::mutex> lock(m_mutex);
+				m_condition.wait(lock, [this]() { return !m_bRunning || !m_requests.empty(); });
+				if (!m_bRunning) { return; }
+
+				request = m_requests.front();
+				m_requests.erase(m_requests.begin());
+				m_loadingCache = request.cache;
+			}
+
+			request.cache->loadBlock(request.blockIndex, request.generation);
+
+			{
+				std::lock_guard<std::mutex> lock(m_mutex);
+				m_loadingCache = nullptr;
+			}
+			m_condition.notify_all();
+			UI::RequestRedraw();
+		}
+	}
+#endif
+
+	UIItemListCache::~UIItemListCache()
+	{
+		for (Block* block : m_blocks)
+		{
+			UIFREE(block);
+		}
+		m_blocks.clear();
+	}
+
+	void UIItemListCache::beginFetch(AsyncItemListProvider* provider, UInt32 itemCount)
+	{
+#ifdef ZUI_USE_ASYNC_LIST_LOADER
+		std::lock_guard<std::mutex> lock(m_mutex);
+#endif
+		// Provider or item count changed: cached blocks are no longer valid
+		if (m_provider != provider || m_itemCount != itemCount)
+		{
+			m_provider = provider;
+			m_itemCount = itemCount;
+			m_generation++;
+			for (Block* block : m_blocks)
+			{
+				UIFREE(block);
+			}
+			m_blocks.clear();
+		}
+
+		m_useCounter++;
+	}
+
+	UIItemListCache::Block* UIItemListCache::findBlock(UInt32 blockIndex)
+	{
+		for (Block* block : m_blocks)
+		{
+			if (block->blockIndex == blockIndex) { return block; }
+		}
+		return nullptr;
+	}
+
+	UIItemListCache::Block* UIItemListCache::requestBlock(UInt32 blockIndex)
+	{
+		Block* block = findBlock(blockIndex);
+		if (block)
+		{
+			block->lastUsed = m_useCounter;
+			return block;
+		}
+
+		if (m_blocks.size() < ZUI_LIST_CACHE_MAX_BLOCKS)
+		{
+			block = UINEW(Block);
+			m_blocks.push_back(block);
+		}
+		else
+		{
+			// Reuse least recently used block that isn't used this frame
+			for (Block* candidate : m_blocks)
+			{
+				if (candidate->lastUsed != m_useCounter && (!block || candidate->lastUsed < block->lastUsed))
+				{
+					block = candidate;
+				}
+			}
+
+			if (!block) { return nullptr; }
+		}
+
+		block->blockIndex = blockIndex;
+		block->lastUsed = m_useCounter;
+		block->bLoaded = false;
+		block->items.clear();
+
+#ifdef ZUI_USE_ASYNC_LIST_LOADER
+		ItemListLoader.push({ this, blockIndex, m_generation });
+#else
+		const UInt32 first = blockIndex * ZUI_LIST_CACHE_BLOCK_SIZE;
+		m_provider->loadRange(first, UIMIN(m_itemCount - first, ZUI_LIST_CACHE_BLOCK_SIZE), block->items);
+		block->bLoaded = true;
+#endif
+		return block;
+	}
+
+	void UIItemListCache::fetchRange(UInt32 first, UInt32 count, const UIChar** outItems)
+	{
+#ifdef ZUI_USE_ASYNC_LIST_LOADER
+		std::lock_guard<std::mutex> lock(m_mutex);
+#endif
+		Block* block = nullptr;
+		for (UInt32 i = 0; i < count; i++)
+		{
+			const UInt32 index = first + i;
+			const UInt32 blockIndex = index / ZUI_LIST_CACHE_BLOCK_SIZE;
+			if (!block || block->blockIndex != blockIndex)
+			{
+				block = requestBlock(blockIndex);
+			}
+
+			const UInt32 indexInBlock = index % ZUI_LIST_CACHE_BLOCK_SIZE;
+			outItems[i] = block && block->bLoaded && indexInBlock < block->items.count() ? block->items.getItem(indexInBlock) : m_provider->getPlaceholder();
+		}
+	}
+
+	void UIItemListCache::prefetch(UInt32 firstRow, UInt32 lastRow)
+	{
+#ifdef ZUI_USE_ASYNC_LIST_LOADER
+		std::lock_guard<std::mutex> lock(m_mutex);
+#endif
+		if (firstRow > m_lastFirstRow) { m_scrollDirection = 1; }
+		else if (firstRow < m_lastFirstRow) { m_scrollDirection = -1; }
+		m_lastFirstRow = firstRow;
+
+		const Int32 blockCount = (Int32)((m_itemCount + ZUI_LIST_CACHE_BLOCK_SIZE - 1) / ZUI_LIST_CACHE_BLOCK_SIZE);
+		const Int32 startBlock = m_scrollDirection > 0 ? (Int32)(lastRow / ZUI_LIST_CACHE_BLOCK_SIZE) : (Int32)(firstRow / ZUI_LIST_CACHE_BLOCK_SIZE);
+		for (Int32 i = 1; i <= ZUI_LIST_CACHE_PREFETCH_BLOCKS; i++)
+		{
+			const Int32 blockIndex = startBlock + i * m_scrollDirection;
+			if (blockIndex < 0 || blockIndex >= blockCount) { break; }
+			requestBlock((UInt32)blockIndex);
+		}
+	}
+
+	void UIItemListCache::loadBlock(UInt32 blockIndex, UInt32 generation)
+	{
+#ifdef ZUI_USE_ASYNC_LIST_LOADER
+		AsyncItemListProvider* provider = nullptr;
+		UInt32 first = 0;
+		UInt32 count = 0;
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			Block* block = findBlock(blockIndex);
+			if (!block || block->bLoaded || generation != m_generation) { return; }
+
+			provider = m_provider;
+			first = blockIndex * ZUI_LIST_CACHE_BLOCK_SIZE;
+			count = UIMIN(m_itemCount - first, ZUI_LIST_CACHE_BLOCK_SIZE);
+		}
+
+		// Load outside the lock, UI thread keeps showing placeholders meanwhile
+		UIItemListBlock loadedItems;
+		provider->loadRange(first, count, loadedItems);
+
+		std::lock_guard<std::mutex> lock(m_mutex);
+		Block* block = findBlock(blockIndex);
+		if (block && !block->bLoaded && generation == m_generation)
+		{
+			block->items = std::move(loadedItems);
+			block->bLoaded = true;
+		}
+#endif
+	}
+
+	void DestroyItemListCaches()
+	{
+#ifdef ZUI_USE_ASYNC_LIST_LOADER
+		ItemListLoader.stop();
+#endif
+
+		UI::MainUIState.virtualListStates.forEach([](UIVirtualListState& listState)
+		{
+			if (listState.itemCache)
+			{
+				UIFREE(listState.itemCache);
+				listState.itemCache = nullptr;
+			}
+		});
+	}
+
+	void UIItemListBlock::addItem(const UIChar* text)
+	{
+		m_offsets.push_back((UInt32)m_text.size());
+		m_text.insert(m_text.end(), text, text + TextLength(text) + 1);
+	}
+
+	namespace UI
+	{
+		// Helper to get number of rows to fetch from index until the end of the view, based on current row heights
+		UInt32 GetVirtualListFetchCount(const UIVirtualListState& listState, UInt32 index)
+		{
+			const UInt32 lastRow = listState.rowHeights.findIndexAtOffset(listState.scrollOffset + listState.targetRect.m_dimension.y);
+			const UInt32 count = lastRow >= index ? lastRow - index + 1 : 1;
+			return UIMIN(count, listState.rowHeights.count() - index);
+		}
+
+		// Helper to draw rows of the current virtual list view, fetching the visible items in ranges
+		template<typename FetchFunc>
+		UInt32 DoVirtualListRows(UInt32 index, FetchFunc fetchFunc)
+		{
+			static UIArray<const UIChar*> fetchedItems;
+
+			const UIVirtualListState& listState = *MainUIState.virtualListStack.back();
+			UInt32 fetchedFirst = index;
+			UInt32 fetchedCount = 0;
+			while (BeginVirtualListItem(index))
+			{
+				// Rows can be shorter than estimated, fetch the rest of the view
+				if (index >= fetchedFirst + fetchedCount)
+				{
+					fetchedFirst = index;
+					fetchedCount = GetVirtualListFetchCount(listState, index);
+					fetchedItems.resize(fetchedCount);
+					fetchFunc(fetchedFirst, fetchedCount, fetchedItems.data());
+				}
+
+				DoText(fetchedItems[index - fetchedFirst]);
+				EndVirtualListItem(index);
+				index++;
+			}
+
+			return index;
+		}
+	}
+
+	void UI::DoVirtualListView(const UIChar* listName, const UIRect& rect, ItemListProvider* itemProvider, Float32 estimatedItemHeight)
+	{
+		UInt32 index = BeginVirtualListView(listName, rect, itemProvider->count(), estimatedItemHeight);
+		DoVirtualListRows(index, [itemProvider](UInt32 first, UInt32 count, const UIChar** outItems)
+		{
+			itemProvider->fetchRange(first, count, outItems);
+		});
+		EndVirtualListView();
+	}
+
+	void UI::DoVirtualListView(const UIChar* listName, const UIRect& rect, AsyncItemListProvider* itemProvider, Float32 estimatedItemHeight)
+	{
+		const UInt32 itemCount = itemProvider->count();
+		UInt32 index = BeginVirtualListView(listName, rect, itemCount, estimatedItemHeight);
+
+		UIVirtualListState* listState = MainUIState.virtualListStack.back();
+		if (!listState->itemCache)
+		{
+			listState->itemCache = UINEW(UIItemListCache);
+		}
+
+		UIItemListCache* itemCache = listState->itemCache;
+		itemCache->beginFetch(itemProvider, itemCount);
+
+		const UInt32 firstRow = index;
+		UInt32 lastRow = DoVirtualListRows(index, [itemCache](UInt32 first, UInt32 count, const UIChar** outItems)
+		{
+			itemCache->fetchRange(first, count, outItems);
+		});
+
+		if (itemCount > 0)
+		{
+			itemCache->prefetch(firstRow, lastRow > firstRow ? lastRow - 1 : firstRow);
+		}
+
+		EndVirtualListView();
+	}
+
+	void UI::DoListView(const UIChar* listName, const UIRect& rect, const UIChar** listItem, UInt32 itemCount)
+	{
+		BeginListView(listName, rect);
+		for (UInt32 i = 0; i < itemCount; i++)
+		{
+			DoText(listItem[i]);
+		}
+		EndListView();
+	}
+
+	void UI::DoListView(const UIChar* listName, const UIRect& rect, ItemListProvider* itemProvider)
+	{
+		static UIArray<const UIChar*> fetchedItems;
+		fetchedItems.resize(itemProvider->count());
+		itemProvider->fetchRange(0, (UInt32)fetchedItems.size(), fetchedItems.data());
+
+		BeginListView(listName, rect);
+		for (UInt32 i = 0; i < fetchedItems.size(); i++)
+		{
+			DoText(fetchedItems[i]);
+		}
+		EndListView();
+	}
+
+	void UI::BeginSelectionListView(const UIChar* listName, const UIRect& rect, Int32& selection)
+	{
+		const UInt32 _id = GetUIIDFromString(listName);
+
+		const bool hasParent = StackIDs.size() > 1;
+
+		StackIDs.push_back(_id);
+
+		bool bCreated;
+		UIScrollState& scrollState = MainUIState.scrollStates.findOrAdd(_id, &bCreated);
+		if (bCreated)
+		{
+			scrollState.targetRect = rect;
+			scrollState.contentSize = rect.m_dimension;
+			scrollState.scrollOffset = 0.0f;
+		}
+
+		MainUIState.drawPosDimensionStack.push_back(MainUIState.drawPosDimension);
+
+		if (hasParent)
+		{
+			MainUIState.drawPosDimension.m_pos += rect.m_pos;
+			MainUIState.drawPosDimension.m_dimension = rect.m_dimension;
+		}
+		else
+		{
+			MainUIState.drawPosDimension = rect;
+		}
+		scrollState.targetRect = MainUIState.drawPosDimension;
+
+		MainUIState.drawDirectionStack.push_back(MainUIState.drawDirection);
+		MainUIState.drawDirection = UIVector2(0.0f, 1.0f);
+
+		MainUIState.drawer->DrawRect(MainUIState.drawPosDimension, ZE::UIVector4(0.15f, 0.15f, 0.15f, 1.0f));
+
+		MainUIState.drawer->PushRectMask(MainUIState.drawPosDimension);
+		PushDrawRect(MainUIState.drawPosDimension);
+
+		MainUIState.drawPosDimension.m_pos.y -= scrollState.scrollOffset;
+	}
+
+	bool UI::DoSelectionListView(const UIChar* listName, const UIRect& rect, const UIChar** listItem, Int32& selection, UInt32 itemCount)
+	{
+		bool selectionChanged = false;
+		BeginSelectionListView(listName, rect, selection);
+		for (UInt32 i = 0; i < itemCount; i++)
+		{
+			selectionChanged |= DoSelectionItemList(rect, listItem[i], i, selection);
+		}
+		EndListView();
+
+		return selectionChanged;
+	}
+
+	bool UI::DoSelectionListView(const UIChar* listName, const UIRect& rect, ItemListProvider* itemProvider, Int32& selectedIndex)
+	{
+		bool selectionChanged = false;
+		static UIArray<const UIChar*> fetchedItems;
+		fetchedItems.resize(itemProvider->count());
+		itemProvider->fetchRange(0, (UInt32)fetchedItems.size(), fetchedItems.data());
+
+		BeginSelectionListView(listName, rect, selectedIndex);
+		for (UInt32 i = 0; i < fetchedItems.size(); i++)
+		{
+			selectionChanged |= DoSelectionItemList(rect, fetchedItems[i], i, selectedIndex);
+		}
+		EndListView();
+
+		return selectionChanged;
+	}
+
+	bool UI::DoSelectionItemList(const UIRect& rect, const UIChar* listItem, const UInt32 currentIndex, Int32& selectedIndex)
+	{
+		bool selectionChanged = false;
+		static UIRect drawRect;
+		drawRect = MainUIState.drawPosDimension;
+		drawRect.m_dimension.x = rect.m_dimension.x - 5;
+		drawRect.m_dimension.y = DefaultFont->calculateTextHeight(1.0f) + 10;
+
+		const UInt32 _id = GetUIIDFromString(listItem);
+		const bool mouseInside = CheckMouseHover(_id, drawRect);
+
+		if (mouseInside && MainUIState.mouseState == EButtonState::BUTTON_DOWN)
+		{
+			MainUIState.activeItem.id = _id;
+		}
+		else if (mouseInside)
+		{
+			MainUIState.hotItem.id = _id;
+			if (MainUIState.activeItem.id == _id)
+			{
+				MainUIState.activeItem.id = 0;
+				selectionChanged = true;
+				if (selectedIndex != currentIndex)
+				{
+					selectedIndex = currentIndex;
+				}
+				else
+				{
+					selectedIndex = -1; // deselect
+				}
+			}
+		}
+		else
+		{
+			if (MainUIState.hotItem.id == _id) { MainUIState.hotItem.id = 0; }
+			if (MainUIState.activeItem.id == _id) { MainUIState.activeItem.id = 0; }
+		}
+
+		if (currentIndex == selectedIndex)
+		{
+			MainUIState.drawer->DrawRect(drawRect, COLOR_BLUE_SELECTION);
+		}
+		else if (MainUIState.hotItem.id == _id)
+		{
+			MainUIState.drawer->DrawRect(drawRect, COLOR_BLUE_HOVERED);
+		}
+
+		DrawTextInRect(drawRect, listItem, COLOR_WHITE, TEXT_LEFT, TEXT_V_CENTER);
+
+		AdvanceDrawPos(drawRect.m_dimension, 0.0f);
+
+		return selectionChanged;
+	}
+
+	bool TableDataProvider::lessThan(UInt32 rowA, UInt32 rowB, UInt32 column) const
+	{
+		return strcmp(getCell(rowA, column), getCell(rowB, column)) < 0;
+	}
+
+	bool TableDataProvider::passFilter(UInt32 row, const UIChar* filter) const
+	{
+		const Int32 columns = columnCount();
+		for (Int32 column = 0; column < columns; column++)
+		{
+			if (strstr(getCell(row, column), filter)) { return true; }
+		}
+		return false;
+	}
+
+	// Sorts and filters table rows on worker thread
+	class UITableSortJob
+	{
+	public:
+		~UITableSortJob();
+
+		// Request new row order. Running job gets cancelled and the request starts once it stops.
+		void request(TableDataProvider* provider, Int32 sortColumn, bool bAscending, const UIChar* filter);
+
+		// Cancel running and pending requests
+		void cancel();
+
+		// Swap finished row order into outRowOrder
+		// @return true if outRowOrder is swapped
+		bool poll(UIArray<UInt32>& outRowOrder);
+
+	protected:
+		struct Params
+		{
+			TableDataProvider* provider;
+			Int32 sortColumn;
+			bool bAscending;
+			UIArray<UIChar> filter;
+		};
+
+		void startPending();
+		void run();
+		bool isCancelled() const;
+
+		Params m_params;
+		Params m_pendingParams;
+		bool m_bPending = false;
+		UIArray<UInt32> m_result;
+
+#ifdef ZUI_USE_ASYNC_TABLE_SORT
+		std::thread m_thread;
+		std::atomic<bool> m_bDone{ false };
+		std::atomic<bool> m_bCancel{ false };
+		bool m_bRunning = false;
+#else
+		bool m_bResultReady = false;
+#endif
+	};
+
+	UITableSortJob::~UITableSortJob()
+	{
+#ifdef ZUI_USE_ASYNC_TABLE_SORT
+		if (m_bRunning)
+		{
+			m_bCancel = true;
+			m_thread.join();
+		}
+#endif
+	}
+
+	void UITableSortJob::request(TableDataProvider* provider, Int32 sortColumn, bool bAscending, const UIChar* filter)
+	{
+		m_pendingParams.provider = provider;
+		m_pendingParams.sortColumn = sortColumn;
+		m_pendingParams.bAscending = bAscending;
+		m_pendingParams.filter.assign(filter, filter + TextLength(filter) + 1);
+		m_bPending = true;
+
+#ifdef ZUI_USE_ASYNC_TABLE_SORT
+		if (m_bRunning)
+		{
+			m_bCancel = true;
+			return;
+		}
+#endif
+		startPending();
+	}
+
+	void UITableSortJob::cancel()
+	{
+		m_bPending = false;
+#ifdef ZUI_USE_ASYNC_TABLE_SORT
+		m_bCancel = true;
+#else
+		m_bResultReady = false;
+#endif
+	}
+
+	bool UITableSortJob::poll(UIArray<UInt32>& outRowOrder)
+	{
+#ifdef ZUI_USE_ASYNC_TABLE_SORT
+		if (!m_bRunning || !m_bDone.load(std::memory_order_acquire)) { return false; }
+
+		m_thread.join();
+		m_bRunning = false;
+
+		const bool bSwapped = !m_bCancel;
+		if (bSwapped)
+		{
+			outRowOrder.swap(m_result);
+		}
+		m_result.clear();
+
+		if (m_bPending)
+		{
+			startPending();
+		}
+
+		return bSwapped;
+#else
+		if (!m_bResultReady) { return false; }
+
+		outRowOrder.swap(m_result);
+		m_result.clear();
+		m_bResultReady = false;
+		return true;
+#endif
+	}
+
+	void UITableSortJob::startPending()
+	{
+		m_params.provider = m_pendingParams.provider;
+		m_params.sortColumn = m_pendingParams.sortColumn;
+		m_params.bAscending = m_pendingParams.bAscending;
+		m_params.filter.swap(m_pendingParams.filter);
+		m_bPending = false;
+
+#ifdef ZUI_USE_ASYNC_TABLE_SORT
+		m_bCancel = false;
+		m_bDone = false;
+		m_bRunning = true;
+		m_thread = std::thread(&UITableSortJob::run, this);
+#else
+		run();
+#endif
+	}
+
+	bool UITableSortJob::isCancelled() const
+	{
+#ifdef ZUI_USE_ASYNC_TABLE_SORT
+		return m_bCancel.load(std::memory_order_relaxed);
+#else
+		return false;
+#endif
+	}
+
+	void UITableSortJob::run()
+	{
+		const TableDataProvider* provider = m_params.provider;
+		const UInt32 rowCount = provider->rowCount();
+		const UIChar* filter = m_params.filter.data();
+
+		m_result.clear();
+		m_result.reserve(rowCount);
+		for (UInt32 row = 0; row < rowCount && !isCancelled(); row++)
+		{
+			if (filter[0] == 0 || provider->passFilter(row, filter))
+			{
+				m_result.push_back(row);
+			}
+		}
+
+		if (m_params.sortColumn >= 0)
+		{
+			const UInt32 column = (UInt32)m_params.sortColumn;
+			const bool bAscending = m_params.bAscending;
+
+			// Once cancelled every row compares equal so the sort finishes quickly
+			std::stable_sort(m_result.begin(), m_result.end(), [this, provider, column, bAscending](UInt32 rowA, UInt32 rowB)
+			{
+				if (isCancelled()) { return false; }
+				return bAscending ? provider->lessThan(rowA, rowB, column) : provider->lessThan(rowB, rowA, column);
+			});
+		}
+
+#ifdef ZUI_USE_ASYNC_TABLE_SORT
+		m_bDone.store(true, std::memory_order_release);
+		UI::RequestRedraw();
+#else
+		m_bResultReady = true;
+#endif
+	}
+
+	void DestroyTableSortJobs()
+	{
+		UI::MainUIState.tableStates.forEach([](UITableState& tableState)
+		{
+			if (tableState.sortJob)
+			{
+				UIFREE(tableState.sortJob);
+				tableState.sortJob = nullptr;
+			}
+		});
+	}
+
+	void CollectWidgetStates()
+	{
+		UIState& state = UI::MainUIState;
+		const UInt32 frame = state.frameCount;
+		auto noRelease = [](auto&) {};
+
+		state.widgetLayouts.collect(frame, WidgetLayoutLifetime, ZUI_STATE_COLLECT_BUDGET, noRelease);
+		state.panelStates.collect(frame, ZUI_STATE_LIFETIME, ZUI_STATE_COLLECT_BUDGET, noRelease);
+		state.scrollStates.collect(frame, ZUI_STATE_LIFETIME, ZUI_STATE_COLLECT_BUDGET, noRelease);
+		state.treeStates.collect(frame, ZUI_STATE_LIFETIME, ZUI_STATE_COLLECT_BUDGET, noRelease);
+		state.dropdownSearchStates.collect(frame, ZUI_STATE_LIFETIME, ZUI_STATE_COLLECT_BUDGET, noRelease);
+
+		state.virtualListStates.collect(frame, ZUI_STATE_LIFETIME, ZUI_STATE_COLLECT_BUDGET, [](UIVirtualListState& listState)
+		{
+			if (listState.itemCache)
+			{
+#ifdef ZUI_USE_ASYNC_LIST_LOADER
+				ItemListLoader.cancel(listState.itemCache);
+#endif
+				UIFREE(listState.itemCache);
+			}
+		});
+
+		state.tableStates.collect(frame, ZUI_STATE_LIFETIME, ZUI_STATE_COLLECT_BUDGET, [](UITableState& tableState)
+		{
+			if (tableState.sortJob)
+			{
+				UIFREE(tableState.sortJob);
+			}
+		});
+	}
+
+	namespace UI
+	{
+		// Helper to request row order of table after sort column or filter changed
+		void RequestTableSort(UITableState& tableState, TableDataProvider* dataProvider)
+		{
+			// Nothing to sort or filter: view row is data row
+			if (tableState.sortColumn < 0 && tableState.filterText[0] == 0)
+			{
+				if (tableState.sortJob)
+				{
+					tableState.sortJob->cancel();
+				}
+				tableState.bUseRowOrder = false;
+				return;
+			}
+
+			if (!tableState.sortJob)
+			{
+				tableState.sortJob = UINEW(UITableSortJob);
+			}
+			tableState.sortJob->request(dataProvider, tableState.sortColumn, tableState.bSortAscending, tableState.filterText.data());
+		}
+
+		// Helper for Table Header Cell: handles column resize and click
+		// @return true if header is clicked
+		bool DoTableHeaderCell(UITableState& tableState, UInt32 column, const UITableColumn& tableColumn, const UIRect& rect, const UITableStyle& style)
+		{
+			// Resize handle on right edge of the column
+			const UInt32 resizeId = GetUIIDFromPointer(&tableState.columnWidths[column]);
+			const UIRect handleRect(UIVector2(rect.m_pos.x + rect.m_dimension.x - style.resizeHandleSize * 0.5f, rect.m_pos.y), UIVector2(style.resizeHandleSize, rect.m_dimension.y));
+
+			const bool mouseInsideHandle = CheckMouseHover(resizeId, handleRect);
+			if (mouseInsideHandle && MainUIState.mouseState == BUTTON_DOWN)
+			{
+				MainUIState.activeItem.id = resizeId;
+			}
+			else if (mouseInsideHandle)
+			{
+				MainUIState.hotItem.id = resizeId;
+				if (MainUIState.activeItem.id == resizeId) { MainUIState.activeItem.id = 0; }
+			}
+			else
+			{
+				if (MainUIState.hotItem.id == resizeId) { MainUIState.hotItem.id = 0; }
+				if (MainUIState.activeItem.id == resizeId && MainUIState.mouseState != BUTTON_DOWN) { MainUIState.activeItem.id = 0; }
+			}
+
+			if (MainUIState.activeItem.id == resizeId)
+			{
+				tableState.columnWidths[column] = UIMAX(style.minColumnWidth, tableState.columnWidths[column] + MainUIState.mouseDeltaX);
+			}
+
+			// Header click
+			// Hit rect leaves out resize handles on both edges, so a handle is never covered by the next header
+			const UInt32 _id = GetUIIDFromPointer(&tableColumn);
+			const UIRect headerHitRect(UIVector2(rect.m_pos.x + style.resizeHandleSize * 0.5f, rect.m_pos.y), UIVector2(rect.m_dimension.x - style.resizeHandleSize, rect.m_dimension.y));
+			const bool mouseInside = !mouseInsideHandle && MainUIState.activeItem.id != resizeId && CheckMouseHover(_id, headerHitRect);
+			bool bPressed = false;
+			if (mouseInside && MainUIState.mouseState == BUTTON_DOWN)
+			{
+				MainUIState.activeItem.id = _id;
+			}
+			else if (mouseInside)
+			{
+				MainUIState.hotItem.id = _id;
+				if (MainUIState.activeItem.id == _id) { MainUIState.activeItem.id = 0; bPressed = true; }
+			}
+			else
+			{
+				if (MainUIState.hotItem.id == _id) { MainUIState.hotItem.id = 0; }
+				if (MainUIState.activeItem.id == _id) { MainUIState.activeItem.id = 0; }
+			}
+
+			if (MainUIState.hotItem.id == _id || MainUIState.activeItem.id == _id)
+			{
+				MainUIState.drawer->DrawRect(rect, style.headerHoverColor);
+			}
+
+			if (MainUIState.hotItem.id == resizeId || MainUIState.activeItem.id == resizeId)
+			{
+				MainUIState.drawer->DrawRect(handleRect, style.resizeHandleColor);
+			}
+
+			UIRect textRect = rect;
+			textRect.m_pos.x += style.cellPadding;
+			textRect.m_dimension.x -= 2 * style.cellPadding;
+
+			UIVector4 textColor = style.textColor;
+			DrawTextInRect(textRect, tableColumn.label, textColor, TEXT_LEFT, TEXT_V_CENTER, style.headerFontStyle.fontScale, style.headerFontStyle.font);
+
+			if (tableState.sortColumn == (Int32)column)
+			{
+				DrawTextInRect(textRect, tableState.bSortAscending ? "^" : "v", textColor, TEXT_RIGHT, TEXT_V_CENTER, style.headerFontStyle.fontScale, style.headerFontStyle.font);
+			}
+
+			return bPressed;
+		}
+	}
+
+	const UITableState& UI::BeginTable(const UIChar* tableName, const UIRect& rect, const UITableColumn* columns, UInt32 columnCount, TableDataProvider* dataProvider, const UIChar* filter /*= nullptr*/, const UITableStyle& style /*= DefaultTableStyle*/)
+	{
+		const UInt32 _id = GetUIIDFromString(tableName);
+
+		const bool hasParent = StackIDs.size() > 1;
+
+		StackIDs.push_back(_id);
+
+		bool bCreated;
+		UITableState& tableState = MainUIState.tableStates.findOrAdd(_id, &bCreated);
+		if (bCreated)
+		{
+			tableState.targetRect = rect;
+			tableState.contentSize = rect.m_dimension;
+			tableState.scrollOffset = 0.0f;
+			tableState.scrollOffsetX = 0.0f;
+			tableState.sortColumn = -1;
+			tableState.bSortAscending = true;
+			tableState.filterText.push_back(0);
+			tableState.dataRowCount = 0;
+			tableState.sortJob = nullptr;
+			tableState.bUseRowOrder = false;
+		}
+		MainUIState.tableStack.push_back(&tableState);
+
+		if (tableState.columnWidths.size() != columnCount)
+		{
+			tableState.columnWidths.resize(columnCount);
+			for (UInt32 column = 0; column < columnCount; column++)
+			{
+				tableState.columnWidths[column] = columns[column].width;
+			}
+		}
+
+		// Swap in finished sort and filter
+		if (tableState.sortJob && tableState.sortJob->poll(tableState.rowOrder))
+		{
+			tableState.bUseRowOrder = true;
+		}
+
+		bool bRequestSort = false;
+
+		const UIChar* filterText = filter ? filter : "";
+		if (strcmp(filterText, tableState.filterText.data()) != 0)
+		{
+			tableState.filterText.assign(filterText, filterText + TextLength(filterText) + 1);
+			bRequestSort = true;
+		}
+
+		const UInt32 dataRowCount = dataProvider->rowCount();
+		if (dataRowCount != tableState.dataRowCount)
+		{
+			// Row order may point to removed rows, show unsorted until new order is done
+			tableState.dataRowCount = dataRowCount;
+			tableState.bUseRowOrder = false;
+			bRequestSort = true;
+		}
+
+		BeginScrollArea(tableState, rect, hasParent);
+
+		const UIRect& tableRect = tableState.targetRect;
+		const Float32 headerHeight = style.headerFontStyle.font->calculateTextHeight(style.headerFontStyle.fontScale) + 2 * style.cellPadding;
+		tableState.rowHeight = style.cellFontStyle.font->calculateTextHeight(style.cellFontStyle.fontScale) + 2 * style.cellPadding;
+
+		// Column layout
+		tableState.columnOffsets.resize(columnCount + 1);
+		Float32 totalWidth = 0.0f;
+		for (UInt32 column = 0; column < columnCount; column++)
+		{
+			tableState.columnOffsets[column] = totalWidth;
+			totalWidth += tableState.columnWidths[column];
+		}
+		tableState.columnOffsets[columnCount] = totalWidth;
+
+		const bool bScrollX = totalWidth > tableRect.m_dimension.x;
+		tableState.contentSize.x = totalWidth;
+		tableState.scrollOffsetX = bScrollX ? UICLAMP(0.0f, totalWidth - tableRect.m_dimension.x, tableState.scrollOffsetX) : 0.0f;
+
+		tableState.cellsRect = tableRect;
+		tableState.cellsRect.m_pos.y += headerHeight;
+		tableState.cellsRect.m_dimension.y -= headerHeight + (bScrollX ? DefaultScrollBarStyle.scrollButtonSize : 0.0f);
+
+		// Visible columns
+		tableState.firstColumn = 0;
+		while (tableState.firstColumn < columnCount && tableState.columnOffsets[tableState.firstColumn + 1] <= tableState.scrollOffsetX)
+		{
+			tableState.firstColumn++;
+		}
+
+		tableState.lastColumn = tableState.firstColumn;
+		while (tableState.lastColumn < columnCount && tableState.columnOffsets[tableState.lastColumn] < tableState.scrollOffsetX + tableRect.m_dimension.x)
+		{
+			tableState.lastColumn++;
+		}
+
+		// Visible rows
+		const UInt32 viewRowCount = tableState.bUseRowOrder ? (UInt32)tableState.rowOrder.size() : dataRowCount;
+		tableState.contentSize.y = viewRowCount * tableState.rowHeight + (tableRect.m_dimension.y - tableState.cellsRect.m_dimension.y);
+		tableState.scrollOffset = UICLAMP(0.0f, UIMAX(0.0f, tableState.contentSize.y - tableRect.m_dimension.y), tableState.scrollOffset);
+
+		const UInt32 firstRow = (UInt32)(tableState.scrollOffset / tableState.rowHeight);
+		const UInt32 lastRow = (UInt32)((tableState.scrollOffset + tableState.cellsRect.m_dimension.y) / tableState.rowHeight) + 1;
+		tableState.firstRow = UIMIN(firstRow, viewRowCount);
+		tableState.lastRow = UIMIN(lastRow, viewRowCount);
+
+		// Frozen header row
+		MainUIState.drawer->DrawRect(UIRect(tableRect.m_pos, UIVector2(tableRect.m_dimension.x, headerHeight)), style.headerColor);
+		for (UInt32 column = tableState.firstColumn; column < tableState.lastColumn; column++)
+		{
+			const UIRect headerCellRect(UIVector2(tableRect.m_pos.x + tableState.columnOffsets[column] - tableState.scrollOffsetX, tableRect.m_pos.y), UIVector2(tableState.columnWidths[column], headerHeight));
+			if (DoTableHeaderCell(tableState, column, columns[column], headerCellRect, style))
+			{
+				tableState.bSortAscending = tableState.sortColumn == (Int32)column ? !tableState.bSortAscending : true;
+				tableState.sortColumn = (Int32)column;
+				bRequestSort = true;
+			}
+		}
+
+		if (bRequestSort)
+		{
+			RequestTableSort(tableState, dataProvider);
+		}
+
+		// Cells
+		MainUIState.drawer->PushRectMask(tableState.cellsRect);
+		PushDrawRect(tableState.cellsRect);
+
+		for (UInt32 row = tableState.firstRow; row < tableState.lastRow; row++)
+		{
+			UIRect rowRect = GetTableCellRect(row, 0);
+			rowRect.m_pos.x = tableState.cellsRect.m_pos.x;
+			rowRect.m_dimension.x = tableState.cellsRect.m_dimension.x;
+			MainUIState.drawer->DrawRect(rowRect, row % 2 ? style.alternateRowColor : style.rowColor);
+		}
+
+		return tableState;
+	}
+
+	void UI::BeginTableColumn(UInt32 column)
+	{
+		const UITableState& tableState = *MainUIState.tableStack.back();
+
+		UIRect columnRect = tableState.cellsRect;
+		columnRect.m_pos.x += tableState.columnOffsets[column] - tableState.scrollOffsetX;
+		columnRect.m_dimension.x = tableState.columnWidths[column];
+
+		MainUIState.drawer->PushRectMask(columnRect);
+		PushDrawRect(columnRect);
+	}
+
+	void UI::EndTableColumn()
+	{
+		PopDrawRect();
+		MainUIState.drawer->PopMask();
+	}
+
+	ZE::UIRect UI::GetTableCellRect(UInt32 viewRow, UInt32 column)
+	{
+		const UITableState& tableState = *MainUIState.tableStack.back();
+
+		UIRect cellRect;
+		cellRect.m_pos.x = tableState.cellsRect.m_pos.x + tableState.columnOffsets[column] - tableState.scrollOffsetX;
+		cellRect.m_pos.y = tableState.cellsRect.m_pos.y + (Float32)((Float64)viewRow * tableState.rowHeight - tableState.scrollOffset);
+		cellRect.m_dimension.x = tableState.columnWidths[column];
+		cellRect.m_dimension.y = tableState.rowHeight;
+		return cellRect;
+	}
+
+	UInt32 UI::GetTableDataRow(UInt32 viewRow)
+	{
+		const UITableState& tableState = *MainUIState.tableStack.back();
+		return tableState.bUseRowOrder ? tableState.rowOrder[viewRow] : viewRow;
+	}
+
+	void UI::EndTable()
+	{
+		const bool hasParent = StackIDs.size() > 2;
+
+		UITableState& tableState = *MainUIState.tableStack.back();
+		MainUIState.tableStack.pop_back();
 
+		// Cells
 		PopDrawRect();
 		MainUIState.drawer->PopMask();
 
-		MainUIState.drawDirection = MainUIState.drawDirectionStack.back();
-		MainUIState.drawDirectionStack.pop_back();
-
-		if (hasParent)
-		{
-			UIRect topStackRect = MainUIState.drawPosDimensionStack.back();
-			MainUIState.drawPosDimension.m_pos = topStackRect.m_pos + scrollState.targetRect.m_dimension * MainUIState.drawDirection;
-			MainUIState.drawPosDimension.m_dimension = topStackRect.m_dimension;
-		}
-		else
-		{
-			MainUIState.drawPosDimension = MainUIState.drawPosDimensionStack.back();
-		}
-		MainUIState.drawPosDimensionStack.pop_back();
-
-		// Add scrollbar
-		if (scrollState.targetRect.m_dimension.y < scrollState.contentSize.y)
+		const UIRect& tableRect = tableState.targetRect;
+		if (tableState.contentSize.x > tableRect.m_dimension.x)
 		{
-			if (CheckMouseInside(scrollState.targetRect))
+			if (CheckMouseInside(tableRect) && tableState.contentSize.y <= tableRect.m_dimension.y)
 			{
-				Float32 mouseScroll = MainUIState.UseScrollOffset();
-				scrollState.scrollOffset += mouseScroll * -10.0f;
-				scrollState.scrollOffset = UICLAMP(0.0f, scrollState.contentSize.y - scrollState.targetRect.m_dimension.y, scrollState.scrollOffset);
+				// No vertical scroll: wheel scrolls horizontally
+				tableState.scrollOffsetX += MainUIState.UseScrollOffset() * -10.0f;
+				tableState.scrollOffsetX = UICLAMP(0.0f, tableState.contentSize.x - tableRect.m_dimension.x, tableState.scrollOffsetX);
 			}
-			scrollState.scrollOffset = DoScrollBar(UIVector2(scrollState.targetRect.m_pos.x + scrollState.targetRect.m_dimension.x - 5, scrollState.targetRect.m_pos.y), scrollState.scrollOffset, scrollState.targetRect.m_dimension.y, scrollState.contentSize.y);
-		}
-		else
-		{
-			scrollState.scrollOffset = 0.0f;
+			tableState.scrollOffsetX = DoScrollBar(UIVector2(tableRect.m_pos.x, tableRect.m_pos.y + tableRect.m_dimension.y - DefaultScrollBarStyle.scrollButtonSize), tableState.scrollOffsetX, tableRect.m_dimension.x, tableState.contentSize.x, DIR_HORIZONTAL);
 		}
 
+		EndScrollArea(tableState, hasParent);
+
 		StackIDs.pop_back();
 	}
 
-	void UI::DoListView(const UIChar* listName, const UIRect& rect, const UIChar** listItem, UInt32 itemCount)
+	void UI::DoTable(const UIChar* tableName, const UIRect& rect, const UITableColumn* columns, UInt32 columnCount, TableDataProvider* dataProvider, const UIChar* filter /*= nullptr*/, const UITableStyle& style /*= DefaultTableStyle*/)
 	{
-		BeginListView(listName, rect);
-		for (UInt32 i = 0; i < itemCount; i++)
+		const UITableState& tableState = BeginTable(tableName, rect, columns, columnCount, dataProvider, filter, style);
+
+		UIVector4 textColor = style.textColor;
+		for (UInt32 column = tableState.firstColumn; column < tableState.lastColumn; column++)
 		{
-			DoText(listItem[i]);
+			BeginTableColumn(column);
+			for (UInt32 row = tableState.firstRow; row < tableState.lastRow; row++)
+			{
+				UIRect cellRect = GetTableCellRect(row, column);
+				cellRect.m_pos.x += style.cellPadding;
+				cellRect.m_dimension.x -= 2 * style.cellPadding;
+				DrawTextInRect(cellRect, dataProvider->getCell(GetTableDataRow(row), column), textColor, TEXT_LEFT, TEXT_V_CENTER, style.cellFontStyle.fontScale, style.cellFontStyle.font);
+			}
+			EndTableColumn();
 		}
-		EndListView();
+
+		EndTable();
 	}
 
-	void UI::DoListView(const UIChar* listName, const UIRect& rect, ItemListProvider* ItemProvider)
+	namespace UI
 	{
-		BeginListView(listName, rect);
-		for (UInt32 i = 0; i < ItemProvider->count(); i++)
+		// Helper to start adding children of node after insertPos
+		void ExpandTreeNode(UITreeState& treeState, UInt32 node, UInt32 depth, Int32 parentRow, UInt32 insertPos)
 		{
-			DoText(ItemProvider->getItemAt(i));
+			const UInt32 childCount = treeState.provider->getChildCount(node);
+			if (childCount == 0) { return; }
+
+			UITreeExpandJob expandJob;
+			expandJob.node = node;
+			expandJob.depth = depth;
+			expandJob.parentRow = parentRow;
+			expandJob.insertPos = insertPos;
+			expandJob.nextChild = 0;
+			expandJob.childCount = childCount;
+			treeState.expandJobs.push_back(expandJob);
 		}
-		EndListView();
-	}
 
-	void UI::BeginSelectionListView(const UIChar* listName, const UIRect& rect, Int32& selection)
-	{
-		const UInt32 _id = GetUIIDFromString(listName);
+		// Helper to remove descendant rows of row
+		void CollapseTreeRow(UITreeState& treeState, UInt32 row)
+		{
+			UIArray<UITreeRow>& rows = treeState.rows;
+			rows[row].bExpanded = false;
 
-		const bool hasParent = StackIDs.size() > 1;
+			UInt32 end = row + 1;
+			while (end < rows.size() && rows[end].depth > rows[row].depth)
+			{
+				end++;
+			}
 
-		StackIDs.push_back(_id);
+			const UInt32 removeCount = end - (row + 1);
+			rows.erase(rows.begin() + row + 1, rows.begin() + end);
 
-		if (!(HashMapHas(MainUIState.scrollStates, _id)))
-		{
-			UIScrollState scrollState;
-			scrollState.targetRect = rect;
-			scrollState.contentSize = rect.m_dimension;
-			scrollState.scrollOffset = 0.0f;
-			MainUIState.scrollStates[_id] = scrollState;
+			// Pending children of the collapsed subtree are cancelled, the rest is moved up
+			UInt32 jobIndex = 0;
+			while (jobIndex < treeState.expandJobs.size())
+			{
+				UITreeExpandJob& expandJob = treeState.expandJobs[jobIndex];
+				if (expandJob.parentRow >= (Int32)row && expandJob.parentRow < (Int32)end)
+				{
+					treeState.expandJobs.erase(treeState.expandJobs.begin() + jobIndex);
+					continue;
+				}
+
+				if (expandJob.parentRow >= (Int32)end) { expandJob.parentRow -= removeCount; }
+				if (expandJob.insertPos >= end) { expandJob.insertPos -= removeCount; }
+				jobIndex++;
+			}
 		}
 
-		UIScrollState& scrollState = MainUIState.scrollStates[_id];
+		// Helper to add pending children of expanded nodes, up to ZUI_TREE_EXPAND_BUDGET per frame
+		void ProcessTreeExpandJobs(UITreeState& treeState)
+		{
+			static UIArray<UInt32> children;
+			static UIArray<UITreeRow> newRows;
 
-		MainUIState.drawPosDimensionStack.push_back(MainUIState.drawPosDimension);
+			UInt32 budget = ZUI_TREE_EXPAND_BUDGET;
+			while (budget > 0 && treeState.expandJobs.size() > 0)
+			{
+				UITreeExpandJob& expandJob = treeState.expandJobs[0];
+				const UInt32 count = UIMIN(budget, expandJob.childCount - expandJob.nextChild);
 
-		if (hasParent)
-		{
-			MainUIState.drawPosDimension.m_pos += rect.m_pos;
-			MainUIState.drawPosDimension.m_dimension = rect.m_dimension;
-		}
-		else
-		{
-			MainUIState.drawPosDimension = rect;
-		}
-		scrollState.targetRect = MainUIState.drawPosDimension;
+				children.resize(count);
+				treeState.provider->fetchChildren(expandJob.node, expandJob.nextChild, count, children.data());
 
-		MainUIState.drawDirectionStack.push_back(MainUIState.drawDirection);
-		MainUIState.drawDirection = UIVector2(0.0f, 1.0f);
+				newRows.resize(count);
+				for (UInt32 i = 0; i < count; i++)
+				{
+					newRows[i].node = children[i];
+					newRows[i].depth = expandJob.depth;
+					newRows[i].bExpanded = false;
+				}
 
-		MainUIState.drawer->DrawRect(MainUIState.drawPosDimension, ZE::UIVector4(0.15f, 0.15f, 0.15f, 1.0f));
+				const UInt32 insertPos = expandJob.insertPos;
+				treeState.rows.insert(treeState.rows.begin() + insertPos, newRows.begin(), newRows.end());
 
-		MainUIState.drawer->PushRectMask(MainUIState.drawPosDimension);
-		PushDrawRect(MainUIState.drawPosDimension);
+				// Move other pending jobs below insertion point
+				for (UInt32 jobIndex = 1; jobIndex < treeState.expandJobs.size(); jobIndex++)
+				{
+					UITreeExpandJob& otherJob = treeState.expandJobs[jobIndex];
+					if (otherJob.parentRow >= (Int32)insertPos) { otherJob.parentRow += count; }
+					// Children of the last added row are inserted at insertPos too, they stay ahead of the rest of this job
+					if (otherJob.insertPos > insertPos) { otherJob.insertPos += count; }
+				}
 
-		MainUIState.drawPosDimension.m_pos.y -= scrollState.scrollOffset;
+				expandJob.insertPos += count;
+				expandJob.nextChild += count;
+				budget -= count;
+
+				if (expandJob.nextChild == expandJob.childCount)
+				{
+					treeState.expandJobs.erase(treeState.expandJobs.begin());
+				}
+			}
+
+			// Keep frames coming until expand is finished
+			if (treeState.expandJobs.size() > 0)
+			{
+				RequestRedraw();
+			}
+		}
 	}
 
-	bool UI::DoSelectionListView(const UIChar* listName, const UIRect& rect, const UIChar** listItem, Int32& selection, UInt32 itemCount)
+	bool UI::DoTreeView(const UIChar* treeName, const UIRect& rect, TreeDataProvider* dataProvider, UInt32& selectedNode, const UITreeStyle& style /*= DefaultTreeStyle*/)
 	{
-		bool selectionChanged = false;
-		BeginSelectionListView(listName, rect, selection);
-		for (UInt32 i = 0; i < itemCount; i++)
+		const UInt32 _id = GetUIIDFromString(treeName);
+
+		const bool hasParent = StackIDs.size() > 1;
+
+		StackIDs.push_back(_id);
+
+		bool bCreated;
+		UITreeState& treeState = MainUIState.treeStates.findOrAdd(_id, &bCreated);
+		if (bCreated)
 		{
-			selectionChanged |= DoSelectionItemList(rect, listItem[i], i, selection);
+			treeState.targetRect = rect;
+			treeState.contentSize = rect.m_dimension;
+			treeState.scrollOffset = 0.0f;
+			treeState.provider = nullptr;
 		}
-		EndListView();
-
-		return selectionChanged;
-	}
 
-	bool UI::DoSelectionListView(const UIChar* listName, const UIRect& rect, ItemListProvider* itemProvider, Int32& selectedIndex)
-	{
-		bool selectionChanged = false;
-		BeginSelectionListView(listName, rect, selectedIndex);
-		for (UInt32 i = 0; i < itemProvider->count(); i++)
+		// New provider: start from root children
+		if (treeState.provider != dataProvider)
 		{
-			selectionChanged |= DoSelectionItemList(rect, itemProvider->getItemAt(i), i, selectedIndex);
+			treeState.provider = dataProvider;
+			treeState.rows.clear();
+			treeState.expandJobs.clear();
+			ExpandTreeNode(treeState, dataProvider->getRootNode(), 0, -1, 0);
 		}
-		EndListView();
 
-		return selectionChanged;
-	}
+		ProcessTreeExpandJobs(treeState);
 
-	bool UI::DoSelectionItemList(const UIRect& rect, const UIChar* listItem, const UInt32 currentIndex, Int32& selectedIndex)
-	{
-		bool selectionChanged = false;
-		static UIRect drawRect;
-		drawRect = MainUIState.drawPosDimension;
-		drawRect.m_dimension.x = rect.m_dimension.x - 5;
-		drawRect.m_dimension.y = DefaultFont->calculateTextHeight(1.0f) + 10;
+		BeginScrollArea(treeState, rect, hasParent);
 
-		const UInt32 _id = GetUIIDFromString(listItem);
-		const bool mouseInside = CheckMouseInside(drawRect);
+		const UIRect& treeRect = treeState.targetRect;
+		const Float32 rowHeight = style.fontStyle.font->calculateTextHeight(style.fontStyle.fontScale) + 2 * style.rowPadding;
+		const UInt32 rowCount = (UInt32)treeState.rows.size();
 
-		if (mouseInside && MainUIState.mouseState == EButtonState::BUTTON_DOWN)
-		{
-			MainUIState.activeItem.id = _id;
-		}
-		else if (mouseInside)
+		treeState.contentSize.y = rowCount * rowHeight;
+		treeState.scrollOffset = UICLAMP(0.0f, UIMAX(0.0f, treeState.contentSize.y - treeRect.m_dimension.y), treeState.scrollOffset);
+
+		const UInt32 firstRow = UIMIN((UInt32)(treeState.scrollOffset / rowHeight), rowCount);
+		const UInt32 lastRow = UIMIN(firstRow + (UInt32)(treeRect.m_dimension.y / rowHeight) + 2, rowCount);
+
+		bool selectionChanged = false;
+		Int32 toggleRow = -1;
+		UIVector4 textColor = style.textColor;
+
+		for (UInt32 row = firstRow; row < lastRow; row++)
 		{
-			MainUIState.hotItem.id = _id;
-			if (MainUIState.activeItem.id == _id)
+			const UITreeRow& treeRow = treeState.rows[row];
+
+			UIRect rowRect;
+			rowRect.m_pos.x = treeRect.m_pos.x;
+			rowRect.m_pos.y = treeRect.m_pos.y + (Float32)((Float64)row * rowHeight - treeState.scrollOffset);
+			rowRect.m_dimension.x = treeRect.m_dimension.x - 5;
+			rowRect.m_dimension.y = rowHeight;
+
+			const Float32 indent = treeRow.depth * style.indentSize;
+			const UIRect arrowRect(UIVector2(rowRect.m_pos.x + indent, rowRect.m_pos.y + (rowHeight - style.arrowSize.y) * 0.5f), style.arrowSize);
+			const bool bHasChildren = treeState.provider->hasChildren(treeRow.node);
+
+			UInt32 node = treeRow.node;
+			const UInt32 _rowId = ComputeHashData(&node, sizeof(UInt32), _id);
+			const bool mouseInside = CheckMouseHover(_rowId, rowRect);
+			bool bPressed = false;
+			if (mouseInside && MainUIState.mouseState == BUTTON_DOWN)
 			{
-				MainUIState.activeItem.id = 0;
-				selectionChanged = true;
-				if (selectedIndex != currentIndex)
+				MainUIState.activeItem.id = _rowId;
+			}
+			else if (mouseInside)
+			{
+				MainUIState.hotItem.id = _rowId;
+				if (MainUIState.activeItem.id == _rowId) { MainUIState.activeItem.id = 0; bPressed = true; }
+			}
+			else
+			{
+				if (MainUIState.hotItem.id == _rowId) { MainUIState.hotItem.id = 0; }
+				if (MainUIState.activeItem.id == _rowId) { MainUIState.activeItem.id = 0; }
+			}
+
+			if (bPressed)
+			{
+				if (bHasChildren && arrowRect.isContain(MainUIState.mousePos))
 				{
-					selectedIndex = currentIndex;
+					toggleRow = (Int32)row;
 				}
 				else
 				{
-					selectedIndex = -1; // deselect
+					selectedNode = selectedNode == treeRow.node ? TreeDataProvider::InvalidNode : treeRow.node;
+					selectionChanged = true;
 				}
 			}
-		}
-		else
-		{
-			if (MainUIState.hotItem.id == _id) { MainUIState.hotItem.id = 0; }
-			if (MainUIState.activeItem.id == _id) { MainUIState.activeItem.id = 0; }
-		}
 
-		if (currentIndex == selectedIndex)
-		{
-			MainUIState.drawer->DrawRect(drawRect, COLOR_BLUE_SELECTION);
+			if (selectedNode == treeRow.node)
+			{
+				MainUIState.drawer->DrawRect(rowRect, style.selectionColor);
+			}
+			else if (MainUIState.hotItem.id == _rowId)
+			{
+				MainUIState.drawer->DrawRect(rowRect, style.hoverColor);
+			}
+
+			if (bHasChildren)
+			{
+				MainUIState.drawer->DrawCollapseArrow(arrowRect.m_pos, style.arrowSize, !treeRow.bExpanded);
+			}
+
+			UIRect textRect = rowRect;
+			textRect.m_pos.x += indent + style.arrowSize.x + style.rowPadding;
+			textRect.m_dimension.x -= indent + style.arrowSize.x + style.rowPadding;
+			DrawTextInRect(textRect, treeState.provider->getLabel(treeRow.node), textColor, TEXT_LEFT, TEXT_V_CENTER, style.fontStyle.fontScale, style.fontStyle.font);
 		}
-		else if (MainUIState.hotItem.id == _id)
+
+		// Toggle after drawing so the rows drawn this frame stay valid
+		if (toggleRow >= 0)
 		{
-			MainUIState.drawer->DrawRect(drawRect, COLOR_BLUE_HOVERED);
+			UITreeRow& treeRow = treeState.rows[toggleRow];
+			if (treeRow.bExpanded)
+			{
+				CollapseTreeRow(treeState, toggleRow);
+			}
+			else
+			{
+				treeRow.bExpanded = true;
+				ExpandTreeNode(treeState, treeRow.node, treeRow.depth + 1, toggleRow, toggleRow + 1);
+			}
 		}
 
-		DrawTextInRect(drawRect, listItem, COLOR_WHITE, TEXT_LEFT, TEXT_V_CENTER);
+		EndScrollArea(treeState, hasParent);
 
-		MainUIState.drawPosDimension.m_pos = MainUIState.drawPosDimension.m_pos + MainUIState.drawDirection * drawRect.m_dimension;
+		StackIDs.pop_back();
 
 		return selectionChanged;
 	}
@@ -2084,7 +4913,7 @@ namespace ZE
 		// Update Draw Position
 		MainUIState.drawPosDimension.m_pos.x += rect.m_dimension.x;
 
-		const bool mouseInside = CheckMouseInside(rect);
+		const bool mouseInside = CheckMouseHover(menuID, rect);
 
 		if (mouseInside && MainUIState.mouseState == BUTTON_DOWN)
 		{
@@ -2205,7 +5034,7 @@ namespace ZE
 		// Update Draw Position
 		MainUIState.drawPosDimension.m_pos.y += rect.m_dimension.y;
 
-		const bool mouseInside = CheckMouseInside(rect);
+		const bool mouseInside = CheckMouseHover(menuID, rect);
 
 		if (mouseInside && MainUIState.mouseState == BUTTON_DOWN)
 		{
@@ -2304,7 +5133,7 @@ namespace ZE
 
 		static Float32 mouseOffset = 0.0f;
 
-		const bool mouseInside = CheckMouseInside(buttonRect);
+		const bool mouseInside = CheckMouseHover(id, buttonRect);
 		if (mouseInside && MainUIState.mouseState == BUTTON_DOWN)
 		{
 			if (MainUIState.activeItem.id != id)
@@ -2371,26 +5200,21 @@ namespace ZE
 
 	void UI::DrawTextInPos(UIVector2& pos, const UIChar* text, const UIVector4& fillColor, UIFont* font, Float32 scale)
 	{
+		UIWidgetScope widgetScope(true);
 		MainUIState.drawer->DrawText(pos, fillColor, font, text, scale);
 	}
 
 	void UI::DrawTextInRect(const UIRect& rect, const UIChar* text, UIVector4& fillColor, ETextAlign textAlign /*= TEXT_LEFT*/, ETextVerticalAlign vAlign /*= TEXT_V_CENTER*/, Float32 scale /*= 1.0f*/, UIFont* font)
+	{
+		DrawTextInRectWithWidth(rect, text, fillColor, textAlign, vAlign, scale, font, -1.0f);
+	}
+
+	void UI::DrawTextInRectWithWidth(const UIRect& rect, const UIChar* text, UIVector4& fillColor, ETextAlign textAlign, ETextVerticalAlign vAlign, Float32 scale, UIFont* font, Float32 textWidth)
 	{
 		UIVector2 textDimension;
-		textDimension.x = font->calculateTextLength(text, scale);
 		textDimension.y = font->calculateTextHeight(scale);
 
 		UIVector2 actualPos = rect.m_pos;
-		switch (textAlign)
-		{
-		case ZE::TEXT_CENTER:
-			actualPos.x += (rect.m_dimension.x - textDimension.x) / 2;
-			break;
-		case ZE::TEXT_RIGHT:
-			actualPos.x += (rect.m_dimension.x - textDimension.x);
-			break;
-		}
-
 		switch (vAlign)
 		{
 		case ZE::TEXT_V_BOTTOM:
@@ -2401,6 +5225,32 @@ namespace ZE
 			break;
 		}
 
+		// Height is known without measuring, horizontal extent is only known on the aligned side
+		const Float32 boundLeft = textAlign == TEXT_LEFT ? rect.m_pos.x : -TextUnboundedExtent;
+		const Float32 boundRight = textAlign == TEXT_RIGHT ? rect.m_pos.x + rect.m_dimension.x : TextUnboundedExtent;
+		if (IsTextCulled(boundLeft, actualPos.y, boundRight, actualPos.y + textDimension.y))
+		{
+			MainUIState.frameStats.textCulled++;
+			return;
+		}
+
+		if (textWidth < 0.0f)
+		{
+			textWidth = font->calculateTextLength(text, scale);
+			MainUIState.frameStats.textMeasured++;
+		}
+		textDimension.x = textWidth;
+
+		switch (textAlign)
+		{
+		case ZE::TEXT_CENTER:
+			actualPos.x += (rect.m_dimension.x - textDimension.x) / 2;
+			break;
+		case ZE::TEXT_RIGHT:
+			actualPos.x += (rect.m_dimension.x - textDimension.x);
+			break;
+		}
+
 		MainUIState.drawer->DrawText(actualPos, fillColor, font, text, scale, false, 0.0f, TEXT_LEFT, rect.m_dimension);
 	}
 
@@ -2425,22 +5275,24 @@ namespace ZE
 		Int32 lineCount = 0;
 		MainUIState.drawer->DrawText(actualPos, fillColor, font, text, scale, true, MainUIState.drawPosDimension.m_dimension.x, textAlign, UIVector2(0.0f), &lineCount);
 
-		MainUIState.drawPosDimension.m_pos = MainUIState.drawPosDimension.m_pos + MainUIState.drawDirection * UIVector2(0.0f, lineCount * font->calculateTextHeight(scale)) + UIVector2(5.0f) * MainUIState.drawDirection;
+		AdvanceDrawPos(UIVector2(MainUIState.drawPosDimension.m_dimension.x, lineCount * font->calculateTextHeight(scale)));
 	}
 
 	void UI::DrawMultiLineText(const UIVector2& dimension, const UIChar* text, const UIVector4& fillColor, ETextAlign textAlign /*= TEXT_LEFT*/, ETextVerticalAlign vAlign /*= TEXT_V_TOP*/, Float32 scale /*= 1.0f*/, UIFont* font /*= DefaultFont*/)
 	{
+		UIWidgetScope widgetScope(false);
 		static UIRect rect;
 		rect = MainUIState.drawPosDimension;
 		rect.m_dimension = dimension;
 
 		DrawMultiLineTextEx(rect, text, fillColor, textAlign, vAlign, scale, font);
 
-		MainUIState.drawPosDimension.m_pos = MainUIState.drawPosDimension.m_pos + MainUIState.drawDirection * rect.m_dimension + UIVector2(5.0f) * MainUIState.drawDirection;
+		AdvanceDrawPos(rect.m_dimension);
 	}
 
 	void UI::DrawMultiLineTextEx(const UIRect& rect, const UIChar* text, const UIVector4& fillColor, ETextAlign textAlign /*= TEXT_V_CENTER*/, ETextVerticalAlign vAlign /*= TEXT_V_TOP*/, Float32 scale /*= 1.0f*/, UIFont* font)
 	{
+		UIWidgetScope widgetScope(true);
 		UIVector2 textDimension;
 		textDimension.x = rect.m_dimension.x;
 		textDimension.y = font->calculateTextHeight(scale);
@@ -2466,7 +5318,7 @@ namespace ZE
 		rect = MainUIState.drawPosDimension;
 		rect.m_dimension.y = (Float32)texture->getHeight();
 		MainUIState.drawer->DrawTexture(rect, texture, colorMultiplier, textureScale, scaleOffset);
-		MainUIState.drawPosDimension.m_pos = MainUIState.drawPosDimension.m_pos + MainUIState.drawDirection * rect.m_dimension + UIVector2(5.0f) * MainUIState.drawDirection;
+		AdvanceDrawPos(rect.m_dimension);
 	}
 
 	void UI::DrawTexture(const UIVector2& dimension, UITexture* texture, const UIVector4& colorMultiplier, ETextureScale textureScale /*= SCALE_IMAGE*/, const UIVector4& scaleOffset /*= UIVector4(0.0f)*/)
@@ -2475,11 +5327,12 @@ namespace ZE
 		rect = MainUIState.drawPosDimension;
 		rect.m_dimension = dimension;
 		MainUIState.drawer->DrawTexture(rect, texture, colorMultiplier, textureScale, scaleOffset);
-		MainUIState.drawPosDimension.m_pos = MainUIState.drawPosDimension.m_pos + MainUIState.drawDirection * rect.m_dimension + UIVector2(5.0f) * MainUIState.drawDirection;
+		AdvanceDrawPos(rect.m_dimension);
 	}
 
 	void UI::DrawTextureInPos(const UIVector2& pos, UITexture* texture, const UIVector4& colorMultiplier, ETextureScale textureScale, const UIVector4& scaleOffset)
 	{
+		UIWidgetScope widgetScope(true);
 		UIRect rect;
 		rect.m_pos = pos;
 		rect.m_dimension = { (Float32)texture->getWidth(), (Float32)texture->getHeight() };
@@ -2488,6 +5341,15 @@ namespace ZE
 
 	void UI::ProcessDrawList()
 	{
+		// Presented frame is still valid, keep it and only handle events
+		if (!MainUIState.bDrawListChanged)
+		{
+			MainUIState.idleStats.skippedFrames++;
+			MainUIState.renderer->pollEvents();
+			return;
+		}
+
+		MainUIState.idleStats.renderedFrames++;
 		MainUIState.renderer->ProcessCurrentDrawList();
 	}
 
@@ -2503,6 +5365,7 @@ namespace ZE
 
 	void UI::DrawTextureInPos(const UIRect& rect, UITexture* texture, const UIVector4& colorMultiplier, ETextureScale textureScale, const UIVector4& scaleOffset)
 	{
+		UIWidgetScope widgetScope(true);
 		MainUIState.drawer->DrawTexture(rect, texture, colorMultiplier, textureScale, scaleOffset);
 	}
 
@@ -2526,30 +5389,39 @@ namespace ZE
 #endif
 
 		drawItem->m_layer = m_currentLayer;
+		ApplyScissor(drawItem);
 		Float32 depth = m_currentLayer * 0.5f + m_currentDepth;
 
+#if !defined(ZUI_USE_RECT_INSTANCING)
 		UIVector2 positions[4] = { rect.m_pos,
 								{ rect.m_pos.x + rect.m_dimension.x, rect.m_pos.y },
 								{ rect.m_pos.x, rect.m_pos.y + rect.m_dimension.y },
 								rect.m_pos + rect.m_dimension };
 		UIVector2 texCoords[4] = { {0.0f, 0.0f}, {1.0f, 0.0f}, {0.0f, 1.0f}, {1.0f, 1.0f} };
 
+		// Texture in atlas page only covers part of texture handle
+		for (UIVector2& texCoord : texCoords) { texCoord = texture->mapUV(texCoord); }
+#endif
+
 		if (textureScale == ZE::SCALE_IMAGE)
 		{
 #if defined(ZUI_USE_RECT_INSTANCING)
-			drawItem->m_instances.push_back(UIDrawInstance{ rect.m_pos, depth, rect.m_dimension, 0.0f, fillColor, UIVector4{ 0.0f, 0.0f, 1.0f, 1.0f } });
+			drawItem->m_instances.push_back(UIDrawInstance{ rect.m_pos, depth, rect.m_dimension, 0.0f, fillColor, texture->getUVRect() });
 #else
+			// Quad corners: top left, bottom left, bottom right, top right
 			drawItem->m_vertices.push_back(UIVertex{ positions[0], depth, texCoords[0], fillColor });
-			drawItem->m_vertices.push_back(UIVertex{ positions[1], depth, texCoords[1], fillColor });
-			drawItem->m_vertices.push_back(UIVertex{ positions[3], depth, texCoords[3], fillColor });
-
-			drawItem->m_vertices.push_back(UIVertex{ positions[0], depth, texCoords[0], fillColor });
-			drawItem->m_vertices.push_back(UIVertex{ positions[3], depth, texCoords[3], fillColor });
 			drawItem->m_vertices.push_back(UIVertex{ positions[2], depth, texCoords[2], fillColor });
+			drawItem->m_vertices.push_back(UIVertex{ positions[3], depth, texCoords[3], fillColor });
+			drawItem->m_vertices.push_back(UIVertex{ positions[1], depth, texCoords[1], fillColor });
 #endif
 		}
 		else if (textureScale == SCALE_9SCALE || textureScale == SCALE_BORDER)
 		{
+#if defined(ZUI_USE_RECT_INSTANCING)
+			// Single instance, shape shader expands slices from insets. Negative radius leaves out center for border scale.
+			drawItem->m_instances.push_back(UIDrawInstance{ rect.m_pos, depth, rect.m_dimension, textureScale == SCALE_BORDER ? -1.0f : 0.0f, fillColor, texture->getUVRect() });
+			drawItem->setLastInstanceInsets(UIInstanceInsets{ scaleOffset.x * texture->getHeight(), scaleOffset.y * texture->getHeight(), scaleOffset.z * texture->getWidth(), scaleOffset.w * texture->getWidth() });
+#else
 			UIVector2 outerPositions[8] = { positions[0] + UIVector2{ Float32(texture->getWidth() * scaleOffset.z), 0 },
 											positions[0] + UIVector2{ 0, Float32(texture->getHeight() * scaleOffset.x) },
 											positions[1] + UIVector2{ Float32(texture->getWidth() * -scaleOffset.w), 0 },
@@ -2581,136 +5453,77 @@ namespace ZE
 											{1.0f - scaleOffset.w, 1.0f - scaleOffset.y}
 			};
 
-#if defined(ZUI_USE_RECT_INSTANCING)
-
-			Float32 top = scaleOffset.x;
-			Float32 bottom = scaleOffset.y;
-			Float32 left = scaleOffset.z;
-			Float32 right = scaleOffset.w;
-
-			UIVector2 smallRectDim1{ left * texture->getWidth(), top * texture->getHeight() };
-			UIVector2 smallRectDim2{ right* texture->getWidth(), top * texture->getHeight() };
-			UIVector2 smallRectDim3{ left * texture->getWidth(), bottom * texture->getHeight() };
-			UIVector2 smallRectDim4{ right * texture->getWidth(), bottom * texture->getHeight() };
-
-			UIVector2 edgeRectDimTop{ rect.m_dimension.x - smallRectDim1.x - smallRectDim2.x, smallRectDim1.y };
-			UIVector2 edgeRectDimBottom{ rect.m_dimension.x - smallRectDim1.x - smallRectDim2.x, smallRectDim3.y };
-			UIVector2 edgeRectDimLeft{ smallRectDim1.x, rect.m_dimension.y - smallRectDim1.y - smallRectDim3.y };
-			UIVector2 edgeRectDimRight{ smallRectDim2.x, rect.m_dimension.y - smallRectDim2.y - smallRectDim4.y };
-
-			// Top Left Corner
-			drawItem->m_instances.push_back(UIDrawInstance{ rect.m_pos, depth, smallRectDim1, 0.0f, fillColor, UIVector4{ 0.0f, 0.0f, left, top } });
-
-			// Bottom Left Corner
-			drawItem->m_instances.push_back(UIDrawInstance{ outerPositions[5], depth, smallRectDim3, 0.0f, fillColor, UIVector4{ outerTexCoords[5].x, outerTexCoords[5].y, left, bottom } });
-
-			// Right Top Corner
-			drawItem->m_instances.push_back(UIDrawInstance{ outerPositions[2], depth, smallRectDim2, 0.0f, fillColor, UIVector4{ outerTexCoords[2].x, outerTexCoords[2].y, right, top } });
-
-			// Right Bottom Corner
-			drawItem->m_instances.push_back(UIDrawInstance{ innerPositions[3], depth, smallRectDim4, 0.0f, fillColor, UIVector4{ innerTexCoords[3].x, innerTexCoords[3].y, right, bottom } });
-
-			// Top Edge
-			drawItem->m_instances.push_back(UIDrawInstance{ outerPositions[0], depth, edgeRectDimTop, 0.0f, fillColor, UIVector4{ outerTexCoords[0].x, outerTexCoords[0].y, 1.0f - right - left, top } });
-
-			// Bottom Edge
-			drawItem->m_instances.push_back(UIDrawInstance{ innerPositions[2], depth, edgeRectDimBottom, 0.0f, fillColor, UIVector4{ innerTexCoords[2].x, innerTexCoords[2].y, 1.0f - right - left, bottom } });
-
-			// Left Edge
-			drawItem->m_instances.push_back(UIDrawInstance{ outerPositions[1], depth, edgeRectDimLeft, 0.0f, fillColor, UIVector4{ outerTexCoords[1].x, outerTexCoords[1].y, left, 1.0f - top - bottom } });
-
-			// Right Edge
-			drawItem->m_instances.push_back(UIDrawInstance{ innerPositions[1], depth, edgeRectDimRight, 0.0f, fillColor, UIVector4{ innerTexCoords[1].x, innerTexCoords[1].y, right, 1.0f - top - bottom } });
-
-#else
-			// Top-Left Corner
-			drawItem->m_vertices.push_back(UIVertex{ positions[0], depth, texCoords[0], fillColor });
-			drawItem->m_vertices.push_back(UIVertex{ outerPositions[0], depth, outerTexCoords[0], fillColor });
-			drawItem->m_vertices.push_back(UIVertex{ innerPositions[0], depth, innerTexCoords[0], fillColor });
-
-			drawItem->m_vertices.push_back(UIVertex{ positions[0], depth, texCoords[0], fillColor });
-			drawItem->m_vertices.push_back(UIVertex{ innerPositions[0], depth, innerTexCoords[0], fillColor });
-			drawItem->m_vertices.push_back(UIVertex{ outerPositions[1], depth, outerTexCoords[1], fillColor });
-
-			// Top-Right Corner
-			drawItem->m_vertices.push_back(UIVertex{ positions[1], depth, texCoords[1], fillColor });
-			drawItem->m_vertices.push_back(UIVertex{ outerPositions[3], depth, outerTexCoords[3], fillColor });
-			drawItem->m_vertices.push_back(UIVertex{ innerPositions[1], depth, innerTexCoords[1], fillColor });
-
-			drawItem->m_vertices.push_back(UIVertex{ positions[1], depth, texCoords[1], fillColor });
-			drawItem->m_vertices.push_back(UIVertex{ innerPositions[1], depth, innerTexCoords[1], fillColor });
-			drawItem->m_vertices.push_back(UIVertex{ outerPositions[2], depth, outerTexCoords[2], fillColor });
-
-			// Bottom-Left Corner
-			drawItem->m_vertices.push_back(UIVertex{ positions[2], depth, texCoords[2], fillColor });
-			drawItem->m_vertices.push_back(UIVertex{ outerPositions[5], depth, outerTexCoords[5], fillColor });
-			drawItem->m_vertices.push_back(UIVertex{ innerPositions[2], depth, innerTexCoords[2], fillColor });
-
-			drawItem->m_vertices.push_back(UIVertex{ positions[2], depth, texCoords[2], fillColor });
-			drawItem->m_vertices.push_back(UIVertex{ innerPositions[2], depth, innerTexCoords[2], fillColor });
-			drawItem->m_vertices.push_back(UIVertex{ outerPositions[4], depth, outerTexCoords[4], fillColor });
-
-			// Bottom-Right Corner
-			drawItem->m_vertices.push_back(UIVertex{ positions[3], depth, texCoords[3], fillColor });
-			drawItem->m_vertices.push_back(UIVertex{ outerPositions[7], depth, outerTexCoords[7], fillColor });
-			drawItem->m_vertices.push_back(UIVertex{ innerPositions[3], depth, innerTexCoords[3], fillColor });
-
-			drawItem->m_vertices.push_back(UIVertex{ positions[3], depth, texCoords[3], fillColor });
-			drawItem->m_vertices.push_back(UIVertex{ innerPositions[3], depth, innerTexCoords[3], fillColor });
-			drawItem->m_vertices.push_back(UIVertex{ outerPositions[6], depth, outerTexCoords[6], fillColor });
+			for (UIVector2& texCoord : outerTexCoords) { texCoord = texture->mapUV(texCoord); }
+			for (UIVector2& texCoord : innerTexCoords) { texCoord = texture->mapUV(texCoord); }
 
-			// Top
-			drawItem->m_vertices.push_back(UIVertex{ outerPositions[0], depth, outerTexCoords[0], fillColor });
-			drawItem->m_vertices.push_back(UIVertex{ outerPositions[2], depth, outerTexCoords[2], fillColor });
-			drawItem->m_vertices.push_back(UIVertex{ innerPositions[1], depth, innerTexCoords[1], fillColor });
+			// 4x4 grid of slice corners, row by row
+			const UIVector2 gridPositions[16] = { positions[0], outerPositions[0], outerPositions[2], positions[1],
+												outerPositions[1], innerPositions[0], innerPositions[1], outerPositions[3],
+												outerPositions[5], innerPositions[2], innerPositions[3], outerPositions[7],
+												positions[2], outerPositions[4], outerPositions[6], positions[3] };
 
-			drawItem->m_vertices.push_back(UIVertex{ outerPositions[0], depth, outerTexCoords[0], fillColor });
-			drawItem->m_vertices.push_back(UIVertex{ innerPositions[1], depth, innerTexCoords[1], fillColor });
-			drawItem->m_vertices.push_back(UIVertex{ innerPositions[0], depth, innerTexCoords[0], fillColor });
+			const UIVector2 gridTexCoords[16] = { texCoords[0], outerTexCoords[0], outerTexCoords[2], texCoords[1],
+												outerTexCoords[1], innerTexCoords[0], innerTexCoords[1], outerTexCoords[3],
+												outerTexCoords[5], innerTexCoords[2], innerTexCoords[3], outerTexCoords[7],
+												texCoords[2], outerTexCoords[4], outerTexCoords[6], texCoords[3] };
 
-			// Bottom
-			drawItem->m_vertices.push_back(UIVertex{ outerPositions[4], depth, outerTexCoords[4], fillColor });
-			drawItem->m_vertices.push_back(UIVertex{ innerPositions[3], depth, innerTexCoords[3], fillColor });
-			drawItem->m_vertices.push_back(UIVertex{ innerPositions[2], depth, innerTexCoords[2], fillColor });
-
-			drawItem->m_vertices.push_back(UIVertex{ outerPositions[6], depth, outerTexCoords[6], fillColor });
-			drawItem->m_vertices.push_back(UIVertex{ outerPositions[4], depth, outerTexCoords[4], fillColor });
-			drawItem->m_vertices.push_back(UIVertex{ innerPositions[3], depth, innerTexCoords[3], fillColor });
+			// Slices outside of draw rect are left out, a large panel in a scroll area often shows only one edge
+			UIRect cellRects[9];
+			UInt8 cellVisible[9];
+			for (Int32 cell = 0; cell < 9; cell++)
+			{
+				const Int32 corner = (cell / 3) * 4 + cell % 3;
+				cellRects[cell] = UIRect(gridPositions[corner], gridPositions[corner + 5] - gridPositions[corner]);
+			}
+			UI::CullRects(cellRects, 9, cellVisible);
 
-			// Left
-			drawItem->m_vertices.push_back(UIVertex{ outerPositions[1], depth, outerTexCoords[1], fillColor });
-			drawItem->m_vertices.push_back(UIVertex{ innerPositions[2], depth, innerTexCoords[2], fillColor });
-			drawItem->m_vertices.push_back(UIVertex{ outerPositions[5], depth, outerTexCoords[5], fillColor });
+			for (Int32 row = 0; row < 3; row++)
+			{
+				for (Int32 column = 0; column < 3; column++)
+				{
+					// Center, only for 9 scale
+					if (row == 1 && column == 1 && textureScale != SCALE_9SCALE) { continue; }
+					if (!cellVisible[row * 3 + column]) { continue; }
 
-			drawItem->m_vertices.push_back(UIVertex{ outerPositions[1], depth, outerTexCoords[1], fillColor });
-			drawItem->m_vertices.push_back(UIVertex{ innerPositions[0], depth, innerTexCoords[0], fillColor });
-			drawItem->m_vertices.push_back(UIVertex{ innerPositions[2], depth, innerTexCoords[2], fillColor });
+					// Quad corners: top left, bottom left, bottom right, top right
+					const Int32 corners[4] = { row * 4 + column, (row + 1) * 4 + column, (row + 1) * 4 + column + 1, row * 4 + column + 1 };
+					for (Int32 corner : corners)
+					{
+						drawItem->m_vertices.push_back(UIVertex{ gridPositions[corner], depth, gridTexCoords[corner], fillColor });
+					}
+				}
+			}
+#endif
+		}
+		m_currentDepth += m_step;
+	}
 
-			// Right
-			drawItem->m_vertices.push_back(UIVertex{ outerPositions[3], depth, outerTexCoords[3], fillColor });
-			drawItem->m_vertices.push_back(UIVertex{ outerPositions[7], depth, outerTexCoords[7], fillColor });
-			drawItem->m_vertices.push_back(UIVertex{ innerPositions[1], depth, innerTexCoords[1], fillColor });
+	void UIDrawer::DrawRenderTarget(const UIRect& rect, UInt32 textureHandle, UInt32 version)
+	{
+		UIDrawItem* drawItem = m_currentDrawList->getNextDrawItem();
+		drawItem->m_textureHandle = textureHandle;
+		drawItem->m_textureVersion = version;
+		drawItem->m_layer = m_currentLayer;
+		ApplyScissor(drawItem);
+		Float32 depth = m_currentLayer * 0.5f + m_currentDepth;
+		const UIVector4 fillColor(1.0f);
 
-			drawItem->m_vertices.push_back(UIVertex{ outerPositions[7], depth, outerTexCoords[7], fillColor });
-			drawItem->m_vertices.push_back(UIVertex{ innerPositions[3], depth, innerTexCoords[3], fillColor });
-			drawItem->m_vertices.push_back(UIVertex{ innerPositions[1], depth, innerTexCoords[1], fillColor });
-#endif
-			if (textureScale == SCALE_9SCALE)
-			{
 #if defined(ZUI_USE_RECT_INSTANCING)
-				drawItem->m_instances.push_back(UIDrawInstance{ innerPositions[0], depth, { rect.m_dimension.x - smallRectDim1.x - smallRectDim2.x, rect.m_dimension.y - smallRectDim1.y - smallRectDim3.y }, 0.0f, fillColor, UIVector4{ innerTexCoords[0].x, innerTexCoords[0].y, 1.0f - left - right, 1.0f - top - bottom } });
+		drawItem->m_bUsingRectInstance = true;
+		drawItem->m_instances.push_back(UIDrawInstance{ rect.m_pos, depth, rect.m_dimension, 0.0f, fillColor, UIVector4{ 0.0f, 0.0f, 1.0f, 1.0f } });
 #else
-				// Center
-				drawItem->m_vertices.push_back(UIVertex{ innerPositions[0], depth, innerTexCoords[0], fillColor });
-				drawItem->m_vertices.push_back(UIVertex{ innerPositions[1], depth, innerTexCoords[1], fillColor });
-				drawItem->m_vertices.push_back(UIVertex{ innerPositions[3], depth, innerTexCoords[3], fillColor });
+		UIVector2 positions[4] = { rect.m_pos,
+								{ rect.m_pos.x + rect.m_dimension.x, rect.m_pos.y },
+								{ rect.m_pos.x, rect.m_pos.y + rect.m_dimension.y },
+								rect.m_pos + rect.m_dimension };
+		UIVector2 texCoords[4] = { {0.0f, 0.0f}, {1.0f, 0.0f}, {0.0f, 1.0f}, {1.0f, 1.0f} };
 
-				drawItem->m_vertices.push_back(UIVertex{ innerPositions[0], depth, innerTexCoords[0], fillColor });
-				drawItem->m_vertices.push_back(UIVertex{ innerPositions[3], depth, innerTexCoords[3], fillColor });
-				drawItem->m_vertices.push_back(UIVertex{ innerPositions[2], depth, innerTexCoords[2], fillColor });
+		// Quad corners: top left, bottom left, bottom right, top right
+		drawItem->m_vertices.push_back(UIVertex{ positions[0], depth, texCoords[0], fillColor });
+		drawItem->m_vertices.push_back(UIVertex{ positions[2], depth, texCoords[2], fillColor });
+		drawItem->m_vertices.push_back(UIVertex{ positions[3], depth, texCoords[3], fillColor });
+		drawItem->m_vertices.push_back(UIVertex{ positions[1], depth, texCoords[1], fillColor });
 #endif
-			}
-		}
 		m_currentDepth += m_step;
 	}
 
@@ -2730,6 +5543,7 @@ namespace ZE
 #endif
 
 		drawItem->m_layer = m_currentLayer;
+		ApplyScissor(drawItem);
 		Float32 depth = m_currentLayer * 0.5f + m_currentDepth;
 
 #if defined(ZUI_USE_RECT_INSTANCING)
@@ -2742,13 +5556,11 @@ namespace ZE
 			rect.m_pos + rect.m_dimension };
 		UIVector2 texCoords[4] = { { 0.0f, 0.0f },{ 1.0f, 0.0f },{ 0.0f, 1.0f },{ 1.0f, 1.0f } };
 
-		drawItem->m_vertices.push_back(UIVertex{ positions[0], depth, texCoords[0], fillColor });
-		drawItem->m_vertices.push_back(UIVertex{ positions[3], depth, texCoords[3], fillColor });
-		drawItem->m_vertices.push_back(UIVertex{ positions[1], depth, texCoords[1], fillColor });
-
+		// Quad corners: top left, bottom left, bottom right, top right
 		drawItem->m_vertices.push_back(UIVertex{ positions[0], depth, texCoords[0], fillColor });
 		drawItem->m_vertices.push_back(UIVertex{ positions[2], depth, texCoords[2], fillColor });
 		drawItem->m_vertices.push_back(UIVertex{ positions[3], depth, texCoords[3], fillColor });
+		drawItem->m_vertices.push_back(UIVertex{ positions[1], depth, texCoords[1], fillColor });
 
 		drawItem->m_roundness = rect.m_roundness;
 		drawItem->m_shapeDimension = rect.m_dimension;
@@ -2756,6 +5568,36 @@ namespace ZE
 		m_currentDepth += m_step;
 	}
 
+	void UIDrawer::DrawBorderRect(const UIRect& rect, const UIVector4& fillColor, Float32 borderThickness, const UIVector4& borderColor)
+	{
+#if defined(ZUI_USE_RECT_INSTANCING)
+		if (!UI::ShouldDrawRect(rect))
+		{
+			return;
+		}
+
+#if defined(ZUI_GROUP_PER_TEXTURE)
+		UIDrawItem* drawItem = m_currentDrawList->getTextureInstanceDrawItem(0); // Zero for non texture
+#else
+		UIDrawItem* drawItem = m_currentDrawList->getNextDrawItem();
+#endif
+
+		drawItem->m_layer = m_currentLayer;
+		ApplyScissor(drawItem);
+		Float32 depth = m_currentLayer * 0.5f + m_currentDepth;
+
+		// Border and fill in one instance, shape shader picks border color inside inset band
+		drawItem->m_instances.push_back(UIDrawInstance{ rect.m_pos, depth, rect.m_dimension, rect.m_roundness, fillColor, borderColor });
+		drawItem->setLastInstanceInsets(UIInstanceInsets(borderThickness));
+		drawItem->m_bUsingRectInstance = true;
+
+		m_currentDepth += m_step;
+#else
+		DrawRect(rect, borderColor);
+		DrawRect(UIRect(rect.m_pos + UIVector2(borderThickness), rect.m_dimension - UIVector2(2.0f * borderThickness), UIMAX(rect.m_roundness - borderThickness, 0.0f)), fillColor);
+#endif
+	}
+
 	void UIDrawer::DrawCollapseArrow(const UIVector2& pos, const UIVector2& dimension, bool bCollapsed)
 	{
 #if defined(ZUI_GROUP_PER_TEXTURE) && defined(ZUI_USE_RECT_INSTANCING)
@@ -2767,19 +5609,23 @@ namespace ZE
 #endif
 
 		drawItem->m_layer = m_currentLayer;
+		ApplyScissor(drawItem);
 		Float32 depth = m_currentLayer * 0.5f + m_currentDepth;
 
+		// Triangle as quad with repeated last corner, second triangle is degenerate
 		if (bCollapsed)
 		{
 			drawItem->m_vertices.push_back(UIVertex{ pos + UIVector2(2.0f), depth, UIVector2(), UIVector4(1.0f) });
 			drawItem->m_vertices.push_back(UIVertex{ pos + UIVector2(2.0f, dimension.y - 2.0f), depth, UIVector2(), UIVector4(1.0f) });
 			drawItem->m_vertices.push_back(UIVertex{ pos + UIVector2(dimension.x - 2.0f, dimension.y * 0.5f), depth, UIVector2(), UIVector4(1.0f) });
+			drawItem->m_vertices.push_back(UIVertex{ pos + UIVector2(dimension.x - 2.0f, dimension.y * 0.5f), depth, UIVector2(), UIVector4(1.0f) });
 		}
 		else
 		{
 			drawItem->m_vertices.push_back(UIVertex{ pos + UIVector2(2.0f), depth, UIVector2(), UIVector4(1.0f) });
 			drawItem->m_vertices.push_back(UIVertex{ pos + UIVector2(dimension.x * 0.5f, dimension.y - 2.0f), depth, UIVector2(), UIVector4(1.0f) });
 			drawItem->m_vertices.push_back(UIVertex{ pos + UIVector2(dimension.x - 2.0f, 2.0f), depth, UIVector2(), UIVector4(1.0f) });
+			drawItem->m_vertices.push_back(UIVertex{ pos + UIVector2(dimension.x - 2.0f, 2.0f), depth, UIVector2(), UIVector4(1.0f) });
 		}
 
 		m_currentDepth += m_step;
@@ -2801,6 +5647,7 @@ namespace ZE
 #endif
 
 		drawItem->m_layer = m_currentLayer;
+		ApplyScissor(drawItem);
 		Float32 depth = m_currentLayer * 0.5f + m_currentDepth;
 
 		const Float32 thickness = 2.0f;
@@ -2829,6 +5676,7 @@ namespace ZE
 #endif
 
 		drawItem->m_layer = m_currentLayer;
+		ApplyScissor(drawItem);
 		Float32 depth = m_currentLayer * 0.5f + m_currentDepth;
 
 		const Float32 thickness = 3.0f;
@@ -2840,27 +5688,37 @@ namespace ZE
 		const UIVector2 e = rect.m_pos + UIVector2(rect.m_dimension.x - padding - thickness, padding);
 		const UIVector2 f = rect.m_pos + UIVector2(rect.m_dimension.x - padding, padding);
 		
-		drawItem->m_vertices.push_back(UIVertex{ a, depth, UIVector2(), UIVector4(1.0f) });
-		drawItem->m_vertices.push_back(UIVertex{ c, depth, UIVector2(), UIVector4(1.0f) });
-		drawItem->m_vertices.push_back(UIVertex{ b, depth, UIVector2(), UIVector4(1.0f) });
-		
+		// Two quads, each split along its first to third corner diagonal
 		drawItem->m_vertices.push_back(UIVertex{ a, depth, UIVector2(), UIVector4(1.0f) });
 		drawItem->m_vertices.push_back(UIVertex{ d, depth, UIVector2(), UIVector4(1.0f) });
 		drawItem->m_vertices.push_back(UIVertex{ c, depth, UIVector2(), UIVector4(1.0f) });
-
-		drawItem->m_vertices.push_back(UIVertex{ c, depth, UIVector2(), UIVector4(1.0f) });
-		drawItem->m_vertices.push_back(UIVertex{ d, depth, UIVector2(), UIVector4(1.0f) });
-		drawItem->m_vertices.push_back(UIVertex{ e, depth, UIVector2(), UIVector4(1.0f) });
+		drawItem->m_vertices.push_back(UIVertex{ b, depth, UIVector2(), UIVector4(1.0f) });
 
 		drawItem->m_vertices.push_back(UIVertex{ d, depth, UIVector2(), UIVector4(1.0f) });
 		drawItem->m_vertices.push_back(UIVertex{ f, depth, UIVector2(), UIVector4(1.0f) });
 		drawItem->m_vertices.push_back(UIVertex{ e, depth, UIVector2(), UIVector4(1.0f) });
+		drawItem->m_vertices.push_back(UIVertex{ c, depth, UIVector2(), UIVector4(1.0f) });
 
 		m_currentDepth += m_step;
 	}
 
 	void UIDrawer::DrawText(UIVector2& pos, const UIVector4& fillColor, UIFont* font, const UIChar* text, Float32 scale /*= 1.0f*/, bool bWordWrap /*= false*/, Float32 maxWidth /*= 0*/, ETextAlign wrapTextAlign /*= TEXT_LEFT*/, const UIVector2& dim, Int32* lineCount)
 	{
+		// Text grows right and down from pos, test the sides known without measuring first
+		const Float32 boundRight = dim.x > 0.0f ? pos.x + dim.x : (bWordWrap && maxWidth > 0.0f ? pos.x + maxWidth : UI::TextUnboundedExtent);
+		const Float32 boundBottom = dim.y > 0.0f ? pos.y + dim.y : (bWordWrap ? UI::TextUnboundedExtent : pos.y + font->calculateTextHeight(scale));
+		if (UI::IsTextCulled(pos.x, pos.y, boundRight, boundBottom))
+		{
+			// Layout still needs line count of wrapped text
+			if (bWordWrap && lineCount)
+			{
+				font->calculateWordWrapTextHeight(text, scale, maxWidth, lineCount);
+				UI::MainUIState.frameStats.textMeasured++;
+			}
+			UI::MainUIState.frameStats.textCulled++;
+			return;
+		}
+
 		UIRect drawRect(pos, dim);
 		if (drawRect.m_dimension.x == 0.0f)
 		{
@@ -2872,6 +5730,11 @@ namespace ZE
 			drawRect.m_dimension.y = bWordWrap ? font->calculateWordWrapTextHeight(text, scale, maxWidth, lineCount) : font->calculateTextHeight(scale);
 		}
 
+		if (dim.x == 0.0f || (dim.y == 0.0f && bWordWrap))
+		{
+			UI::MainUIState.frameStats.textMeasured++;
+		}
+
 		if (!UI::ShouldDrawRect(drawRect))
 		{
 			return;
@@ -2882,14 +5745,18 @@ namespace ZE
 #elif defined(ZUI_USE_SINGLE_TEXT_ONLY) || !defined(ZUI_GROUP_PER_TEXTURE)
 		UIDrawItem* drawItem = m_currentDrawList->getNextDrawItem();
 		drawItem->m_textureHandle = font->getTextureHandle();
+#if !defined(ZUI_USE_FONT_INSTANCING)
 		drawItem->m_pos = pos;
 		drawItem->m_bCrop = dim.x > 0.0f && dim.y > 0.0f;
 		drawItem->m_shapeDimension = dim;
+#endif
 #else
 		UIDrawItem* drawItem = m_currentDrawList->getTextureDrawItem(font->getTextureHandle());
 #endif
 
 		drawItem->m_layer = m_currentLayer;
+		ApplyScissor(drawItem);
+		const size_t firstInstance = drawItem->m_instances.size();
 
 		if (bWordWrap)
 		{
@@ -2908,6 +5775,18 @@ namespace ZE
 #endif
 		}
 
+#if defined(ZUI_USE_FONT_INSTANCING)
+		// Crop box goes with glyphs, so cropped text can be drawn in one call with other text
+		if (dim.x > 0.0f && dim.y > 0.0f)
+		{
+			const UIVector4 clip(pos.x, pos.y, dim.x, dim.y);
+			for (size_t i = firstInstance; i < drawItem->m_instances.size(); i++)
+			{
+				drawItem->m_instances[i].clip = clip;
+			}
+		}
+#endif
+
 #if defined(ZUI_USE_SINGLE_TEXT_ONLY)
 		drawItem->m_bUsingRectInstance = true;
 #endif
@@ -2923,6 +5802,7 @@ namespace ZE
 	{
 		m_currentDrawList->reset();
 		m_currentDepth = m_step;
+		m_scissorCount = 0;
 	}
 
 	void UIDrawer::SwapBuffer()
@@ -2945,9 +5825,26 @@ namespace ZE
 			return;
 		}
 
+#if defined(ZUI_USE_SCISSOR_MASK)
+		if (rect.m_roundness == 0.0f)
+		{
+			// Nothing is drawn for axis aligned mask, items drawn inside it carry scissor rect
+			UIScissorMask scissorMask{ rect, m_currentLayer, m_scissorCount++ };
+			if (ScissorMaskStack.size() > 0 && ScissorMaskStack.back().layer == m_currentLayer)
+			{
+				scissorMask.area = ScissorMaskStack.back().area.intersect(rect);
+			}
+			ScissorMaskStack.push_back(scissorMask);
+			PushMaskDrawStack.push_back(nullptr);
+			m_currentDrawList->breakTextureGroups();
+			return;
+		}
+#endif
+
 		UIDrawItem* drawItem = m_currentDrawList->getNextDrawItem();
 
 		drawItem->m_layer = m_currentLayer;
+		ApplyScissor(drawItem);
 		drawItem->m_Mask = DRAW_MASK_PUSH;
 
 		Float32 depth = 0.1f;
@@ -2963,13 +5860,11 @@ namespace ZE
 			rect.m_pos + rect.m_dimension };
 		UIVector2 texCoords[4] = { { 0.0f, 0.0f },{ 1.0f, 0.0f },{ 0.0f, 1.0f },{ 1.0f, 1.0f } };
 
+		// Quad corners: top left, bottom left, bottom right, top right
 		drawItem->m_vertices.push_back(UIVertex{ positions[0], depth, texCoords[0], fillColor });
-		drawItem->m_vertices.push_back(UIVertex{ positions[1], depth, texCoords[1], fillColor });
-		drawItem->m_vertices.push_back(UIVertex{ positions[3], depth, texCoords[3], fillColor });
-
-		drawItem->m_vertices.push_back(UIVertex{ positions[0], depth, texCoords[0], fillColor });
-		drawItem->m_vertices.push_back(UIVertex{ positions[3], depth, texCoords[3], fillColor });
 		drawItem->m_vertices.push_back(UIVertex{ positions[2], depth, texCoords[2], fillColor });
+		drawItem->m_vertices.push_back(UIVertex{ positions[3], depth, texCoords[3], fillColor });
+		drawItem->m_vertices.push_back(UIVertex{ positions[1], depth, texCoords[1], fillColor });
 
 		drawItem->m_roundness = rect.m_roundness;
 		drawItem->m_shapeDimension = rect.m_dimension;
@@ -2986,69 +5881,418 @@ namespace ZE
 			return;
 		}
 
-		UIDrawItem* drawItem = m_currentDrawList->getNextDrawItem();
-		UIDrawItem* pushMaskDrawItem = PushMaskDrawStack.back();
+		UIDrawItem* pushMaskDrawItem = PushMaskDrawStack.back();
+		PushMaskDrawStack.pop_back();
+
+		if (!pushMaskDrawItem)
+		{
+			ScissorMaskStack.pop_back();
+			m_currentDrawList->breakTextureGroups();
+			return;
+		}
+
+		UIDrawItem* drawItem = m_currentDrawList->getNextDrawItem();
+		drawItem->m_Mask = DRAW_MASK_POP;
+		drawItem->m_layer = m_currentLayer;
+		ApplyScissor(drawItem);
+
+#if defined(ZUI_USE_RECT_INSTANCING)
+		drawItem->m_instances = pushMaskDrawItem->m_instances;
+		drawItem->m_bUsingRectInstance = true;
+#else
+		drawItem->m_roundness = pushMaskDrawItem->m_roundness;
+		drawItem->m_shapeDimension = pushMaskDrawItem->m_shapeDimension;
+		drawItem->m_vertices = pushMaskDrawItem->m_vertices;
+#endif
+	}
+
+	void UIDrawer::ApplyScissor(UIDrawItem* drawItem)
+	{
+		// Popups drawn on top of other layers aren't clipped by mask they are called in
+		if (ScissorMaskStack.size() == 0 || ScissorMaskStack.back().layer != (Int32)drawItem->m_layer)
+		{
+			return;
+		}
+
+		const UIScissorMask& scissorMask = ScissorMaskStack.back();
+		drawItem->m_bScissor = true;
+		drawItem->m_scissorArea = scissorMask.area;
+		drawItem->m_scissorIndex = scissorMask.index;
+	}
+
+	ZE::Int32 UIDrawList::itemCount() const
+	{
+		return m_count;
+	}
+
+	ZE::UIDrawItem* UIDrawList::getDrawItem(Int32 _index) const
+	{
+		return m_drawItems[_index];
+	}
+
+	ZE::UIDrawItem* UIDrawList::getNextDrawItem()
+	{
+		if (m_count >= m_drawItems.size())
+		{
+			m_drawItems.push_back(UINEW(UIDrawItem));
+		}
+
+		return m_drawItems[m_count++];
+	}
+
+	ZE::UIDrawItem* UIDrawList::getTextureInstanceDrawItem(UInt32 _index)
+	{
+		Int32 idx;
+		HashMapHasAndAssign(m_textureToInstanceDrawItem, _index, -1, idx);
+		if (idx == -1)
+		{
+			UIDrawItem* draw = getNextDrawItem();
+			draw->m_textureHandle = _index;
+			draw->m_bUsingRectInstance = true;
+			m_textureToInstanceDrawItem[_index] = m_count - 1;
+			idx = m_count - 1;
+		}
+
+		return m_drawItems[idx];
+	}
+
+	namespace UI
+	{
+		// Helper function: Hash of draw item content. Depth is left out so items drawn before it don't change its hash.
+		UInt32 ComputeDrawItemHash(const UIDrawItem* drawItem, const UIArray<UIVertex>& vertices, const UIArray<UIDrawInstance>& instances)
+		{
+			UInt32 hash = drawItem->getTextureHandle();
+			const UInt32 textureVersion = drawItem->getTextureVersion();
+			hash = ComputeHashData((void*)&textureVersion, sizeof(textureVersion), hash);
+			const UInt32 flags = (drawItem->isFont() ? 1 : 0) | (drawItem->isUsingRectInstance() ? 2 : 0) | (drawItem->isCrop() ? 4 : 0) | ((UInt32)drawItem->getDrawMask() << 3) | (drawItem->hasScissor() ? 32 : 0) | (drawItem->getLayer() << 8);
+			hash = ComputeHashData((void*)&flags, sizeof(flags), hash);
+			if (drawItem->hasScissor())
+			{
+				const UIScissorRect scissor = drawItem->getScissorRect();
+				hash = ComputeHashData((void*)&scissor, sizeof(scissor), hash);
+			}
+			const UIVector4 crop = drawItem->getCropDimension();
+			const Float32 roundness = drawItem->getRoundness();
+			hash = ComputeHashData((void*)&crop, sizeof(crop), hash);
+			hash = ComputeHashData((void*)&roundness, sizeof(roundness), hash);
+
+			for (const UIVertex& vertex : vertices)
+			{
+				hash = ComputeHashData((void*)&vertex.pos, sizeof(vertex.pos), hash);
+				hash = ComputeHashData((void*)&vertex.texCoord, sizeof(UIVertex) - offsetof(UIVertex, texCoord), hash);
+			}
+
+			for (const UIDrawInstance& instance : instances)
+			{
+				hash = ComputeHashData((void*)&instance.pos, sizeof(instance.pos), hash);
+				hash = ComputeHashData((void*)&instance.dimension, sizeof(UIDrawInstance) - offsetof(UIDrawInstance, dimension), hash);
+			}
+
+			const UIArray<UIInstanceInsets>& instanceInsets = drawItem->getInstanceInsets();
+			if (instanceInsets.size() > 0)
+			{
+				hash = ComputeHashData((void*)instanceInsets.data(), (UInt32)(sizeof(UIInstanceInsets) * instanceInsets.size()), hash);
+			}
+
+			return hash;
+		}
+
+		// Helper function: Screen bounds of draw item. Text is generated with flipped Y.
+		UIRect ComputeDrawItemBounds(const UIDrawItem* drawItem, const UIArray<UIVertex>& vertices, const UIArray<UIDrawInstance>& instances)
+		{
+			if (vertices.size() == 0 && instances.size() == 0) { return UIRect(); }
+
+			const Float32 ySign = drawItem->isFont() ? -1.0f : 1.0f;
+			UIVector2 minPos(1.0e30f);
+			UIVector2 maxPos(-1.0e30f);
+
+			for (const UIVertex& vertex : vertices)
+			{
+				const Float32 y = vertex.pos.y * ySign;
+				minPos.x = UIMIN(minPos.x, vertex.pos.x);
+				maxPos.x = UIMAX(maxPos.x, vertex.pos.x);
+				minPos.y = UIMIN(minPos.y, y);
+				maxPos.y = UIMAX(maxPos.y, y);
+			}
+
+			for (const UIDrawInstance& instance : instances)
+			{
+				const Float32 y1 = instance.pos.y * ySign;
+				const Float32 y2 = (instance.pos.y + instance.dimension.y) * ySign;
+				minPos.x = UIMIN(minPos.x, instance.pos.x);
+				maxPos.x = UIMAX(maxPos.x, instance.pos.x + instance.dimension.x);
+				minPos.y = UIMIN(minPos.y, UIMIN(y1, y2));
+				maxPos.y = UIMAX(maxPos.y, UIMAX(y1, y2));
+			}
+
+			// One pixel padding for anti-aliased edges
+			const UIRect bounds(minPos - UIVector2(1.0f), maxPos - minPos + UIVector2(2.0f));
+			if (!drawItem->hasScissor())
+			{
+				return bounds;
+			}
+
+			// Nothing outside scissor is drawn
+			const UIScissorRect scissor = drawItem->getScissorRect();
+			return bounds.intersect(UIRect(UIVector2((Float32)scissor.x, (Float32)scissor.y), UIVector2((Float32)scissor.width, (Float32)scissor.height)));
+		}
+	}
+
+	ZE::UInt32 UIDrawList::updateDamage(UIArray<UIDrawItemRecord>& records, const UIRect& screenRect, bool bFullRedraw)
+	{
+		static UIArray<UIDrawItemRecord> newRecords;
+		newRecords.resize(m_count);
+
+		UInt32 listHash = ComputeHashData((void*)&m_count, sizeof(m_count));
+		for (UInt32 i = 0; i < m_count; i++)
+		{
+			UIDrawItem* drawItem = m_drawItems[i];
+			const UInt32 itemHash = UI::ComputeDrawItemHash(drawItem, drawItem->m_vertices, drawItem->m_instances);
+			drawItem->m_bounds = UI::ComputeDrawItemBounds(drawItem, drawItem->m_vertices, drawItem->m_instances);
+			newRecords[i] = { itemHash, i, drawItem->m_bounds };
+			listHash = ComputeHashData((void*)&itemHash, sizeof(itemHash), listHash);
+		}
+
+		// Records are kept sorted by hash; items found in only one of the frames are damaged
+		std::sort(newRecords.begin(), newRecords.end(), [](const UIDrawItemRecord& record1, const UIDrawItemRecord& record2) { return record1.hash < record2.hash; });
+
+		UIVector2 minPos(1.0e30f);
+		UIVector2 maxPos(-1.0e30f);
+		auto addDamage = [&minPos, &maxPos](const UIRect& bounds)
+		{
+			if (bounds.m_dimension.x <= 0.0f || bounds.m_dimension.y <= 0.0f) { return; }
+			minPos.x = UIMIN(minPos.x, bounds.m_pos.x);
+			minPos.y = UIMIN(minPos.y, bounds.m_pos.y);
+			maxPos.x = UIMAX(maxPos.x, bounds.m_pos.x + bounds.m_dimension.x);
+			maxPos.y = UIMAX(maxPos.y, bounds.m_pos.y + bounds.m_dimension.y);
+		};
+
+		// Last frame order of items matched by content, -1 for new items
+		static UIArray<Int32> oldOrders;
+		oldOrders.assign(m_count, -1);
+
+		size_t oldIndex = 0;
+		size_t newIndex = 0;
+		while (oldIndex < records.size() && newIndex < newRecords.size())
+		{
+			if (records[oldIndex].hash == newRecords[newIndex].hash)
+			{
+				oldOrders[newRecords[newIndex].order] = (Int32)records[oldIndex].order;
+				oldIndex++;
+				newIndex++;
+			}
+			else if (records[oldIndex].hash < newRecords[newIndex].hash)
+			{
+				addDamage(records[oldIndex++].bounds);
+			}
+			else
+			{
+				addDamage(newRecords[newIndex++].bounds);
+			}
+		}
+		for (; oldIndex < records.size(); oldIndex++) { addDamage(records[oldIndex].bounds); }
+		for (; newIndex < newRecords.size(); newIndex++) { addDamage(newRecords[newIndex].bounds); }
+
+		// Matched items that swapped draw order are damaged where they overlap each other
+		Int32 lastOldOrder = -1;
+		bool bReordered = false;
+		for (UInt32 i = 0; i < m_count && !bReordered; i++)
+		{
+			if (oldOrders[i] < 0) { continue; }
+			bReordered = oldOrders[i] < lastOldOrder;
+			lastOldOrder = oldOrders[i];
+		}
+
+		if (bReordered)
+		{
+			for (UInt32 i = 0; i < m_count; i++)
+			{
+				if (oldOrders[i] < 0) { continue; }
+				const UIRect& bounds = m_drawItems[i]->m_bounds;
+				for (UInt32 j = i + 1; j < m_count; j++)
+				{
+					if (oldOrders[j] < 0 || oldOrders[j] > oldOrders[i]) { continue; }
+
+					const UIRect& otherBounds = m_drawItems[j]->m_bounds;
+					if (bounds.m_pos.x < otherBounds.m_pos.x + otherBounds.m_dimension.x && otherBounds.m_pos.x < bounds.m_pos.x + bounds.m_dimension.x
+						&& bounds.m_pos.y < otherBounds.m_pos.y + otherBounds.m_dimension.y && otherBounds.m_pos.y < bounds.m_pos.y + bounds.m_dimension.y)
+					{
+						addDamage(bounds);
+						addDamage(otherBounds);
+					}
+				}
+			}
+		}
+
+		records.swap(newRecords);
+
+		m_bFullRedraw = bFullRedraw;
+		minPos.x = UIMAX(minPos.x, screenRect.m_pos.x);
+		minPos.y = UIMAX(minPos.y, screenRect.m_pos.y);
+		maxPos.x = UIMIN(maxPos.x, screenRect.m_pos.x + screenRect.m_dimension.x);
+		maxPos.y = UIMIN(maxPos.y, screenRect.m_pos.y + screenRect.m_dimension.y);
+		m_damageRect = minPos.x < maxPos.x && minPos.y < maxPos.y ? UIRect(minPos, maxPos - minPos) : UIRect();
+
+		return listHash;
+	}
+
+	void UIDrawList::updateBounds()
+	{
+		for (UInt32 i = 0; i < m_count; i++)
+		{
+			UIDrawItem* drawItem = m_drawItems[i];
+			drawItem->m_bounds = UI::ComputeDrawItemBounds(drawItem, drawItem->m_vertices, drawItem->m_instances);
+		}
+	}
+
+	namespace UI
+	{
+		// Helper function: Shader and texture part of sort key, items with same value can share GL/Vulkan state
+		UInt64 ComputeDrawItemStateKey(const UIDrawItem* drawItem)
+		{
+			const UInt64 shaderKind = (drawItem->getTextureHandle() > 0 ? 1 : 0) | (drawItem->isFont() ? 2 : 0) | (drawItem->isUsingRectInstance() ? 4 : 0);
+			return (shaderKind << 13) | (drawItem->getTextureHandle() & 0x1FFF);
+		}
+
+		bool IsBoundsOverlap(const UIRect& bounds1, const UIRect& bounds2)
+		{
+			return bounds1.m_pos.x < bounds2.m_pos.x + bounds2.m_dimension.x && bounds2.m_pos.x < bounds1.m_pos.x + bounds1.m_dimension.x
+				&& bounds1.m_pos.y < bounds2.m_pos.y + bounds2.m_dimension.y && bounds2.m_pos.y < bounds1.m_pos.y + bounds1.m_dimension.y;
+		}
+	}
+
+	void UIDrawList::sortItems()
+	{
+		// Key bits: layer 63-60, mask scope 59-40, sequence 39-16, shader and texture 15-0
+		const UInt32 maxLayer = 0xF;
+		const UInt32 count = m_count;
+		m_sortKeys.resize(count);
+		m_sortKeysTemp.resize(count);
+		m_sortedIndices.resize(count);
+		m_sortedIndicesTemp.resize(count);
+
+		UInt64 maskScope = 0;
+		UInt64 sequence = 0;
+		UInt32 runStart = 0;
+		UInt32 runLayer = 0;
+		for (UInt32 i = 0; i < count; i++)
+		{
+			const UIDrawItem* drawItem = m_drawItems[i];
+			const UInt32 layer = UIMIN(drawItem->getLayer(), maxLayer);
+			UInt64 stateKey = 0;
+
+			if (drawItem->isDrawMask())
+			{
+				// Nothing moves across a mask push or pop
+				maskScope++;
+				sequence++;
+				runStart = i + 1;
+			}
+			else
+			{
+				// Sequence run only grows while new item overlaps none of it, items inside a run can be drawn in any order
+				bool bJoinRun = i > runStart && i - runStart < ZUI_DRAW_SORT_WINDOW && layer == runLayer;
+				for (UInt32 j = runStart; j < i && bJoinRun; j++)
+				{
+					bJoinRun = !UI::IsBoundsOverlap(drawItem->getBounds(), m_drawItems[j]->getBounds());
+				}
+
+				if (!bJoinRun)
+				{
+					sequence++;
+					runStart = i;
+					runLayer = layer;
+				}
+				stateKey = UI::ComputeDrawItemStateKey(drawItem);
+			}
+
+			m_sortKeys[i] = ((UInt64)layer << 60) | ((maskScope & 0xFFFFF) << 40) | ((sequence & 0xFFFFFF) << 16) | stateKey;
+			m_sortedIndices[i] = i;
+		}
+
+		// Bytes that are the same in every key don't need a pass
+		UInt64 diffBits = 0;
+		for (UInt32 i = 1; i < count; i++)
+		{
+			diffBits |= m_sortKeys[i] ^ m_sortKeys[0];
+		}
+
+		// LSD radix sort, 8 bits per pass, stable so equal keys keep call order
+		UInt32 histogram[256];
+		for (UInt32 shift = 0; shift < 64; shift += 8)
+		{
+			if (((diffBits >> shift) & 0xFF) == 0)
+			{
+				continue;
+			}
+
+			UIMEM_SET(histogram, 0, sizeof(histogram));
+			for (UInt32 i = 0; i < count; i++)
+			{
+				histogram[(m_sortKeys[i] >> shift) & 0xFF]++;
+			}
 
-		drawItem->m_Mask = DRAW_MASK_POP;
-		drawItem->m_layer = m_currentLayer;
+			UInt32 offset = 0;
+			for (UInt32 bucket = 0; bucket < 256; bucket++)
+			{
+				const UInt32 bucketCount = histogram[bucket];
+				histogram[bucket] = offset;
+				offset += bucketCount;
+			}
 
-#if defined(ZUI_USE_RECT_INSTANCING)
-		drawItem->m_instances = pushMaskDrawItem->m_instances;
-		drawItem->m_bUsingRectInstance = true;
-#else
-		drawItem->m_roundness = pushMaskDrawItem->m_roundness;
-		drawItem->m_shapeDimension = pushMaskDrawItem->m_shapeDimension;
-		drawItem->m_vertices = pushMaskDrawItem->m_vertices;
-#endif
+			for (UInt32 i = 0; i < count; i++)
+			{
+				const UInt32 target = histogram[(m_sortKeys[i] >> shift) & 0xFF]++;
+				m_sortKeysTemp[target] = m_sortKeys[i];
+				m_sortedIndicesTemp[target] = m_sortedIndices[i];
+			}
 
-		PushMaskDrawStack.pop_back();
+			m_sortKeys.swap(m_sortKeysTemp);
+			m_sortedIndices.swap(m_sortedIndicesTemp);
+		}
 	}
 
-	ZE::Int32 UIDrawList::itemCount() const
+	bool UIDrawList::needsRedraw(const UIDrawItem* drawItem, const UIRect& damageRect) const
 	{
-		return m_count;
-	}
+		if (m_bFullRedraw || drawItem->isDrawMask()) { return true; }
+		if (damageRect.m_dimension.x <= 0.0f || damageRect.m_dimension.y <= 0.0f) { return false; }
 
-	ZE::UIDrawItem* UIDrawList::getDrawItem(Int32 _index) const
-	{
-		return m_drawItems[_index];
+		const UIRect& bounds = drawItem->getBounds();
+		return bounds.m_pos.x < damageRect.m_pos.x + damageRect.m_dimension.x && damageRect.m_pos.x < bounds.m_pos.x + bounds.m_dimension.x
+			&& bounds.m_pos.y < damageRect.m_pos.y + damageRect.m_dimension.y && damageRect.m_pos.y < bounds.m_pos.y + bounds.m_dimension.y;
 	}
 
-	ZE::UIDrawItem* UIDrawList::getNextDrawItem()
+	void UIDrawList::reset()
 	{
-		if (m_count >= m_drawItems.size())
+		for (size_t i = 0; i < m_drawItems.size(); i++)
 		{
-			m_drawItems.push_back(UINEW(UIDrawItem));
+			m_drawItems[i]->reset();
 		}
-
-		return m_drawItems[m_count++];
+		m_count = 0;
+		m_textureToDrawItemMap.clear();
+		m_textureToInstanceDrawItem.clear();
 	}
 
-	ZE::UIDrawItem* UIDrawList::getTextureInstanceDrawItem(UInt32 _index)
+	void UIDrawList::truncate(Int32 _index)
 	{
-		Int32 idx;
-		HashMapHasAndAssign(m_textureToInstanceDrawItem, _index, -1, idx);
-		if (idx == -1)
+		for (Int32 i = _index; i < (Int32)m_count; i++)
 		{
-			UIDrawItem* draw = getNextDrawItem();
-			draw->m_textureHandle = _index;
-			draw->m_bUsingRectInstance = true;
-			m_textureToInstanceDrawItem[_index] = m_count - 1;
-			idx = m_count - 1;
+			m_drawItems[i]->reset();
 		}
-
-		return m_drawItems[idx];
+		m_count = _index;
+		m_textureToDrawItemMap.clear();
+		m_textureToInstanceDrawItem.clear();
 	}
 
-	void UIDrawList::reset()
+	void UIDrawList::moveItemsTo(UIDrawList& targetList, Int32 _index)
 	{
-		for (size_t i = 0; i < m_drawItems.size(); i++)
+		// Swap with free items of target list so both lists keep owning the same number of items
+		for (Int32 i = _index; i < (Int32)m_count; i++)
 		{
-			m_drawItems[i]->reset();
+			targetList.getNextDrawItem();
+			std::swap(m_drawItems[i], targetList.m_drawItems[targetList.m_count - 1]);
 		}
-		m_count = 0;
-		m_textureToDrawItemMap.clear();
-		m_textureToInstanceDrawItem.clear();
+		truncate(_index);
 	}
 
 	void UIDrawList::freeDrawItems()
@@ -3074,6 +6318,12 @@ namespace ZE
 		return m_drawItems[idx];
 	}
 
+	void UIDrawList::breakTextureGroups()
+	{
+		m_textureToDrawItemMap.clear();
+		m_textureToInstanceDrawItem.clear();
+	}
+
 	UIArray<ZE::UIVertex>& UIDrawItem::getVertices()
 	{
 		return m_vertices;
@@ -3084,10 +6334,101 @@ namespace ZE
 		return m_instances;
 	}
 
+	void UIDrawItem::setLastInstanceInsets(const UIInstanceInsets& instanceInsets)
+	{
+		// Instances added before have no insets
+		m_instanceInsets.resize(m_instances.size());
+		m_instanceInsets.back() = instanceInsets;
+	}
+
+	ZE::UIScissorRect UIDrawItem::getScissorRect() const
+	{
+		// Pixel is inside when its center is
+		const Int32 left = (Int32)ceilf(m_scissorArea.m_pos.x - 0.5f);
+		const Int32 top = (Int32)ceilf(m_scissorArea.m_pos.y - 0.5f);
+		const Int32 right = (Int32)ceilf(m_scissorArea.m_pos.x + m_scissorArea.m_dimension.x - 0.5f);
+		const Int32 bottom = (Int32)ceilf(m_scissorArea.m_pos.y + m_scissorArea.m_dimension.y - 0.5f);
+		const Int32 width = right - left;
+		const Int32 height = bottom - top;
+		return UIScissorRect{ left, top, UIMAX(width, 0), UIMAX(height, 0) };
+	}
+
+	void UIDrawItem::translate(const UIVector2& delta, bool bMoveScissor)
+	{
+		// Text is generated with flipped y
+		const UIVector2 offset(delta.x, m_bFont ? -delta.y : delta.y);
+
+		for (UIVertex& vertex : m_vertices)
+		{
+			vertex.pos += offset;
+		}
+
+		for (UIDrawInstance& instance : m_instances)
+		{
+			instance.pos += offset;
+			if (instance.clip.z > 0.0f)
+			{
+				instance.clip.x += delta.x;
+				instance.clip.y += delta.y;
+			}
+		}
+
+		m_pos += delta;
+
+		if (m_bScissor && bMoveScissor)
+		{
+			m_scissorArea.m_pos += delta;
+		}
+	}
+
+	void UIDrawItem::extendBottom(Float32 splitY, Float32 delta)
+	{
+		const Float32 ySign = m_bFont ? -1.0f : 1.0f;
+		bool bMoved = false;
+		bool bKept = false;
+
+		for (UIVertex& vertex : m_vertices)
+		{
+			if (vertex.pos.y * ySign > splitY)
+			{
+				vertex.pos.y += delta * ySign;
+				bMoved = true;
+			}
+			else
+			{
+				bKept = true;
+			}
+		}
+
+		for (UIDrawInstance& instance : m_instances)
+		{
+			if (instance.pos.y * ySign > splitY)
+			{
+				instance.pos.y += delta * ySign;
+			}
+			else if (!m_bFont && instance.pos.y + instance.dimension.y > splitY)
+			{
+				instance.dimension.y += delta;
+			}
+
+			if (instance.clip.z > 0.0f && instance.clip.y > splitY)
+			{
+				instance.clip.y += delta;
+			}
+		}
+
+		// Shape crossing split line got taller
+		if (bMoved && bKept)
+		{
+			m_shapeDimension.y += delta;
+		}
+	}
+
 	void UIDrawItem::reset()
 	{
 		m_vertices.clear();
 		m_instances.clear();
+		m_instanceInsets.clear();
 
 		m_textureHandle = 0;
 		m_roundness = 0.0f;
@@ -3098,6 +6439,206 @@ namespace ZE
 		m_layer = 0;
 		m_bCrop = false;
 		m_Mask = DRAW_MASK_NONE;
+		m_textureVersion = 0;
+		m_bScissor = false;
+		m_scissorIndex = -1;
+	}
+
+	void UIHeightIndex::resize(UInt32 count, Float32 estimatedHeight)
+	{
+		m_heights.resize(count, estimatedHeight);
+		m_count = count;
+
+		// Build tree in linear time
+		m_tree.assign(count + 1, 0.0);
+		for (UInt32 i = 1; i <= count; i++)
+		{
+			m_tree[i] += m_heights[i - 1];
+			UInt32 parent = i + (i & (~i + 1));
+			if (parent <= count)
+			{
+				m_tree[parent] += m_tree[i];
+			}
+		}
+	}
+
+	void UIHeightIndex::setHeight(UInt32 index, Float32 height)
+	{
+		Float64 delta = (Float64)height - m_heights[index];
+		if (delta == 0.0) { return; }
+
+		m_heights[index] = height;
+		for (UInt32 i = index + 1; i <= m_count; i += (i & (~i + 1)))
+		{
+			m_tree[i] += delta;
+		}
+	}
+
+	Float64 UIHeightIndex::getOffset(UInt32 index) const
+	{
+		Float64 sum = 0.0;
+		for (UInt32 i = UIMIN(index, m_count); i > 0; i -= (i & (~i + 1)))
+		{
+			sum += m_tree[i];
+		}
+		return sum;
+	}
+
+	UInt32 UIHeightIndex::findIndexAtOffset(Float64 offset) const
+	{
+		if (m_count == 0) { return 0; }
+
+		UInt32 step = 1;
+		while ((step << 1) <= m_count) { step <<= 1; }
+
+		// Find count of rows that fully end before offset
+		UInt32 pos = 0;
+		for (; step > 0; step >>= 1)
+		{
+			if (pos + step <= m_count && m_tree[pos + step] <= offset)
+			{
+				pos += step;
+				offset -= m_tree[pos];
+			}
+		}
+
+		return UIMIN(pos, m_count - 1);
+	}
+
+	// Helper function: lower case of ASCII character
+	inline UIChar ToLowerChar(UIChar keyChar)
+	{
+		return (keyChar >= 'A' && keyChar <= 'Z') ? keyChar - 'A' + 'a' : keyChar;
+	}
+
+	// Helper function: Compare first maxLength characters of texts, ignoring case
+	Int32 CompareTextNoCase(const UIChar* text1, const UIChar* text2, Int32 maxLength)
+	{
+		for (Int32 i = 0; i < maxLength; i++)
+		{
+			const UInt8 c1 = (UInt8)ToLowerChar(text1[i]);
+			const UInt8 c2 = (UInt8)ToLowerChar(text2[i]);
+			if (c1 != c2 || c1 == 0)
+			{
+				return (Int32)c1 - (Int32)c2;
+			}
+		}
+		return 0;
+	}
+
+	void UIOptionFilter::setOptions(const UIChar** options, Int32 optionCount)
+	{
+		if (m_options == options && m_optionCount == optionCount) { return; }
+
+		m_options = options;
+		m_optionCount = optionCount;
+
+		m_sortedOptions.resize(optionCount);
+		for (Int32 i = 0; i < optionCount; i++)
+		{
+			m_sortedOptions[i] = i;
+		}
+		std::sort(m_sortedOptions.begin(), m_sortedOptions.end(), [options](Int32 option1, Int32 option2)
+		{
+			return CompareTextNoCase(options[option1], options[option2], 0x7FFFFFFF) < 0;
+		});
+
+		m_subsequenceLevels.resize(1);
+		m_subsequenceLevels[0].resize(optionCount);
+		for (Int32 i = 0; i < optionCount; i++)
+		{
+			m_subsequenceLevels[0][i] = { i, 0 };
+		}
+
+		m_prefixStamps.assign(optionCount, 0);
+		m_currentStamp = 0;
+		m_filter.clear();
+
+		rebuildMatches();
+	}
+
+	bool UIOptionFilter::setFilter(const UIChar* filter)
+	{
+		const Int32 length = TextLength(filter);
+
+		// Keep levels of the part that is the same as previous filter
+		Int32 commonLength = 0;
+		while (commonLength < length && commonLength < (Int32)m_filter.size() && ToLowerChar(filter[commonLength]) == m_filter[commonLength])
+		{
+			commonLength++;
+		}
+
+		if (commonLength == length && commonLength == (Int32)m_filter.size()) { return false; }
+
+		m_filter.resize(commonLength);
+		m_subsequenceLevels.resize(commonLength + 1);
+
+		for (Int32 i = commonLength; i < length; i++)
+		{
+			const UIChar filterChar = ToLowerChar(filter[i]);
+			m_filter.push_back(filterChar);
+
+			// Narrow previous level matches, continue after their last matched character
+			m_subsequenceLevels.emplace_back();
+			UIArray<SubsequenceMatch>& nextLevel = m_subsequenceLevels.back();
+			const UIArray<SubsequenceMatch>& level = m_subsequenceLevels[m_subsequenceLevels.size() - 2];
+			for (const SubsequenceMatch& match : level)
+			{
+				const UIChar* text = m_options[match.option];
+				Int32 pos = match.nextChar;
+				while (text[pos] != 0 && ToLowerChar(text[pos]) != filterChar)
+				{
+					pos++;
+				}
+
+				if (text[pos] != 0)
+				{
+					nextLevel.push_back({ match.option, pos + 1 });
+				}
+			}
+		}
+
+		rebuildMatches();
+		return true;
+	}
+
+	void UIOptionFilter::rebuildMatches()
+	{
+		m_matches.clear();
+
+		const Int32 length = (Int32)m_filter.size();
+		if (length == 0)
+		{
+			m_matches.resize(m_optionCount);
+			for (Int32 i = 0; i < m_optionCount; i++)
+			{
+				m_matches[i] = i;
+			}
+			return;
+		}
+
+		m_currentStamp++;
+
+		// Prefix matches are next to each other in sorted options
+		const UIChar* filter = m_filter.data();
+		auto iter = std::lower_bound(m_sortedOptions.begin(), m_sortedOptions.end(), 0, [this, filter, length](Int32 option, Int32)
+		{
+			return CompareTextNoCase(m_options[option], filter, length) < 0;
+		});
+
+		for (; iter != m_sortedOptions.end() && CompareTextNoCase(m_options[*iter], filter, length) == 0; ++iter)
+		{
+			m_matches.push_back(*iter);
+			m_prefixStamps[*iter] = m_currentStamp;
+		}
+
+		for (const SubsequenceMatch& match : m_subsequenceLevels.back())
+		{
+			if (m_prefixStamps[match.option] != m_currentStamp)
+			{
+				m_matches.push_back(match.option);
+			}
+		}
 	}
 
 	bool UIRect::isContain(const UIVector2& pos) const
@@ -3114,11 +6655,8 @@ namespace ZE
 		UIVector2 bottomRight = m_pos + m_dimension;
 		UIVector2 otherBottomRight = inRect.m_pos + inRect.m_dimension;
 
-		if (((inRect.m_pos.x >= m_pos.x && inRect.m_pos.x <= bottomRight.x)
-			|| (otherBottomRight.x >= m_pos.x && otherBottomRight.x <= bottomRight.x))
-			&&
-			((inRect.m_pos.y >= m_pos.y && inRect.m_pos.y <= bottomRight.y)
-				|| (otherBottomRight.y >= m_pos.y && otherBottomRight.y <= bottomRight.y)))
+		// Overlap on both axes, also when one rect contains the other
+		if (hasIntersectWith(inRect))
 		{
 			result.m_pos.x = UIMAX(m_pos.x, inRect.m_pos.x);
 			result.m_pos.y = UIMAX(m_pos.y, inRect.m_pos.y);
@@ -3132,13 +6670,8 @@ namespace ZE
 
 	bool UIRect::hasIntersectWith(const UIRect& inRect) const
 	{
-		const UIVector2 bottomRight = m_pos + m_dimension;
-		const UIVector2 otherBottomRight = inRect.m_pos + inRect.m_dimension;
-		return ((inRect.m_pos.x >= m_pos.x && inRect.m_pos.x <= bottomRight.x)
-			|| (otherBottomRight.x >= m_pos.x && otherBottomRight.x <= bottomRight.x))
-			&&
-			((inRect.m_pos.y >= m_pos.y && inRect.m_pos.y <= bottomRight.y)
-				|| (otherBottomRight.y >= m_pos.y && otherBottomRight.y <= bottomRight.y));
+		return (inRect.m_pos.x <= m_pos.x + m_dimension.x) & (inRect.m_pos.x + inRect.m_dimension.x >= m_pos.x)
+			& (inRect.m_pos.y <= m_pos.y + m_dimension.y) & (inRect.m_pos.y + inRect.m_dimension.y >= m_pos.y);
 	}
 
 	ZE::UIVector2 operator+(const UIVector2& v1, const UIVector2& v2)
@@ -3409,11 +6942,9 @@ namespace ZE
 			Float32 w = charDesc.Dimension.x * scale;
 			Float32 h = charDesc.Dimension.y * scale;
 
-			result.push_back(UIVertex{ UIVector2{ xPos, yPos }, depth, UIVector2{ charDesc.TexCoord.x * 1.0f / m_fontAtlasSize, (charDesc.TexCoord.y + charDesc.Dimension.y) * 1.0f / m_fontAtlasSize }, color });
-			result.push_back(UIVertex{ UIVector2{ xPos + w, yPos }, depth, UIVector2{ (charDesc.TexCoord.x + charDesc.Dimension.x) * 1.0f / m_fontAtlasSize, (charDesc.TexCoord.y + charDesc.Dimension.y) * 1.0f / m_fontAtlasSize }, color });
-			result.push_back(UIVertex{ UIVector2{ xPos, yPos + h }, depth, UIVector2{ charDesc.TexCoord.x * 1.0f / m_fontAtlasSize, charDesc.TexCoord.y * 1.0f / m_fontAtlasSize }, color });
-
+			// Quad corners: top left, bottom left, bottom right, top right
 			result.push_back(UIVertex{ UIVector2{ xPos, yPos + h }, depth, UIVector2{ charDesc.TexCoord.x * 1.0f / m_fontAtlasSize, charDesc.TexCoord.y * 1.0f / m_fontAtlasSize }, color });
+			result.push_back(UIVertex{ UIVector2{ xPos, yPos }, depth, UIVector2{ charDesc.TexCoord.x * 1.0f / m_fontAtlasSize, (charDesc.TexCoord.y + charDesc.Dimension.y) * 1.0f / m_fontAtlasSize }, color });
 			result.push_back(UIVertex{ UIVector2{ xPos + w, yPos }, depth, UIVector2{ (charDesc.TexCoord.x + charDesc.Dimension.x) * 1.0f / m_fontAtlasSize, (charDesc.TexCoord.y + charDesc.Dimension.y) * 1.0f / m_fontAtlasSize }, color });
 			result.push_back(UIVertex{ UIVector2{ xPos + w, yPos + h }, depth, UIVector2{ (charDesc.TexCoord.x + charDesc.Dimension.x) * 1.0f / m_fontAtlasSize, charDesc.TexCoord.y * 1.0f / m_fontAtlasSize }, color });
 
@@ -3453,11 +6984,9 @@ namespace ZE
 				Float32 w = charDesc.Dimension.x * scale;
 				Float32 h = charDesc.Dimension.y * scale;
 
-				result.push_back(UIVertex{ UIVector2{ xPos, yPos }, depth, UIVector2{ charDesc.TexCoord.x * 1.0f / m_fontAtlasSize, (charDesc.TexCoord.y + charDesc.Dimension.y) * 1.0f / m_fontAtlasSize }, color });
-				result.push_back(UIVertex{ UIVector2{ xPos + w, yPos }, depth, UIVector2{ (charDesc.TexCoord.x + charDesc.Dimension.x) * 1.0f / m_fontAtlasSize, (charDesc.TexCoord.y + charDesc.Dimension.y) * 1.0f / m_fontAtlasSize }, color });
-				result.push_back(UIVertex{ UIVector2{ xPos, yPos + h }, depth, UIVector2{ charDesc.TexCoord.x * 1.0f / m_fontAtlasSize, charDesc.TexCoord.y * 1.0f / m_fontAtlasSize }, color });
-
+				// Quad corners: top left, bottom left, bottom right, top right
 				result.push_back(UIVertex{ UIVector2{ xPos, yPos + h }, depth, UIVector2{ charDesc.TexCoord.x * 1.0f / m_fontAtlasSize, charDesc.TexCoord.y * 1.0f / m_fontAtlasSize }, color });
+				result.push_back(UIVertex{ UIVector2{ xPos, yPos }, depth, UIVector2{ charDesc.TexCoord.x * 1.0f / m_fontAtlasSize, (charDesc.TexCoord.y + charDesc.Dimension.y) * 1.0f / m_fontAtlasSize }, color });
 				result.push_back(UIVertex{ UIVector2{ xPos + w, yPos }, depth, UIVector2{ (charDesc.TexCoord.x + charDesc.Dimension.x) * 1.0f / m_fontAtlasSize, (charDesc.TexCoord.y + charDesc.Dimension.y) * 1.0f / m_fontAtlasSize }, color });
 				result.push_back(UIVertex{ UIVector2{ xPos + w, yPos + h }, depth, UIVector2{ (charDesc.TexCoord.x + charDesc.Dimension.x) * 1.0f / m_fontAtlasSize, charDesc.TexCoord.y * 1.0f / m_fontAtlasSize }, color });
 
@@ -3622,6 +7151,27 @@ namespace ZE
 		int width;
 		int height;
 		int channel;
+
+#if defined(ZUI_USE_TEXTURE_ATLAS)
+		// Single and two channel textures sample differently from RGBA, they keep own texture
+		if (s_instance && !s_instance->m_bAtlasUnsupported && stbi_info(fontFilePath, &width, &height, &channel)
+			&& channel >= 3 && width <= ZUI_TEXTURE_ATLAS_MAX_IMAGE && height <= ZUI_TEXTURE_ATLAS_MAX_IMAGE)
+		{
+			stbi_uc* atlasImage = stbi_load(fontFilePath, &width, &height, &channel, 4);
+			if (atlasImage)
+			{
+				const bool bPacked = s_instance->packInAtlas(resTexture, atlasImage, width, height, renderer);
+				stbi_image_free(atlasImage);
+
+				if (bPacked)
+				{
+					s_instance->m_textures.push_back(resTexture);
+					return resTexture;
+				}
+			}
+		}
+#endif
+
 		stbi_uc* image = stbi_load(fontFilePath, &width, &height, &channel, 0);
 
 		if (image)
@@ -3647,6 +7197,87 @@ namespace ZE
 		return resTexture;
 	}
 
+	bool UITextureManager::packInAtlas(UITexture* texture, const UInt8* image, Int32 width, Int32 height, UIRenderer* renderer)
+	{
+		// One pixel border repeating image edge, so linear filtering doesn't blend in neighbour images
+		const Int32 paddedWidth = width + 2;
+		const Int32 paddedHeight = height + 2;
+		const Int32 pageSize = ZUI_TEXTURE_ATLAS_SIZE;
+
+		Int32 pageIndex = -1;
+		Int32 x = 0;
+		Int32 y = 0;
+		for (Int32 i = 0; i < (Int32)m_atlasPages.size() && pageIndex == -1; i++)
+		{
+			const UITextureAtlasPage& page = m_atlasPages[i];
+			if (page.renderer != renderer) { continue; }
+
+			if (page.shelfX + paddedWidth <= pageSize && page.shelfY + paddedHeight <= pageSize)
+			{
+				pageIndex = i;
+				x = page.shelfX;
+				y = page.shelfY;
+			}
+			else if (page.shelfY + page.shelfHeight + paddedHeight <= pageSize)
+			{
+				pageIndex = i;
+				x = 0;
+				y = page.shelfY + page.shelfHeight;
+			}
+		}
+
+		bool bNewPage = false;
+		if (pageIndex == -1)
+		{
+			UIArray<UInt8> emptyPixels(pageSize * pageSize * 4, 0);
+			UITextureAtlasPage newPage;
+			newPage.textureHandle = renderer->createRendererTexture(emptyPixels.data(), pageSize, pageSize, 4);
+			newPage.renderer = renderer;
+			m_atlasPages.push_back(newPage);
+			pageIndex = (Int32)m_atlasPages.size() - 1;
+			bNewPage = true;
+		}
+
+		UIArray<UInt8> paddedImage(paddedWidth * paddedHeight * 4);
+		for (Int32 py = 0; py < paddedHeight; py++)
+		{
+			const Int32 srcY = py == 0 ? 0 : (py > height ? height - 1 : py - 1);
+			for (Int32 px = 0; px < paddedWidth; px++)
+			{
+				const Int32 srcX = px == 0 ? 0 : (px > width ? width - 1 : px - 1);
+				memcpy(&paddedImage[(py * paddedWidth + px) * 4], &image[(srcY * width + srcX) * 4], 4);
+			}
+		}
+
+		UITextureAtlasPage& page = m_atlasPages[pageIndex];
+		if (!renderer->updateRendererTexture(page.textureHandle, paddedImage.data(), x, y, paddedWidth, paddedHeight, 4))
+		{
+			if (bNewPage)
+			{
+				renderer->destroyTexture(page.textureHandle);
+				m_atlasPages.pop_back();
+			}
+			m_bAtlasUnsupported = true;
+			return false;
+		}
+
+		if (y != page.shelfY)
+		{
+			page.shelfY = y;
+			page.shelfHeight = 0;
+		}
+		page.shelfX = x + paddedWidth;
+		page.shelfHeight = page.shelfHeight > paddedHeight ? page.shelfHeight : paddedHeight;
+
+		texture->m_textureHandle = page.textureHandle;
+		texture->m_width = width;
+		texture->m_height = height;
+		texture->m_renderer = renderer;
+		texture->m_uvRect = UIVector4((x + 1) / (Float32)pageSize, (y + 1) / (Float32)pageSize, width / (Float32)pageSize, height / (Float32)pageSize);
+		texture->m_bInAtlas = true;
+		return true;
+	}
+
 	void UITextureManager::Destroy()
 	{
 		if (s_instance)
@@ -3666,6 +7297,13 @@ namespace ZE
 
 	void UITexture::release()
 	{
+		// Atlas page is shared with other textures, area stays reserved
+		if (m_bInAtlas)
+		{
+			m_textureHandle = 0;
+			return;
+		}
+
 		if (m_textureHandle > 0)
 		{
 			m_renderer->destroyTexture(m_textureHandle);
@@ -58,6 +58,14 @@ namespace ZE
 		DIR_HORIZONTAL
 	};
 
+	enum ELayoutAlign : UInt8
+	{
+		LAYOUT_ALIGN_START,
+		LAYOUT_ALIGN_CENTER,
+		LAYOUT_ALIGN_END,
+		LAYOUT_ALIGN_STRETCH
+	};
+
 	enum EDrawMaskProcess : UInt8
 	{
 		DRAW_MASK_NONE,
@@ -165,6 +173,15 @@ namespace ZE
 
 	UIRect operator+(const UIRect& r1, const UIRect& r2);
 
+	// Screen-space min/max box of a rect, used by clip tests
+	struct UIClipBox
+	{
+		Float32 minX;
+		Float32 minY;
+		Float32 maxX;
+		Float32 maxY;
+	};
+
 	// Vertex Data Structure
 	struct UIVertex
 	{
@@ -174,6 +191,14 @@ namespace ZE
 		UIVector4 color;
 	};
 
+	// Content hash and screen bounds of a draw item from previous frame
+	struct UIDrawItemRecord
+	{
+		UInt32 hash;
+		UInt32 order; // Index in draw list
+		UIRect bounds;
+	};
+
 	// Scroll State
 	struct UIScrollState
 	{
@@ -186,8 +211,192 @@ namespace ZE
 	struct UIPanelState : UIScrollState
 	{
 		UIVector2 headerSize;
+
+		// Item activated inside panel body, body is never skipped while it is active
+		UInt32 activeChildId;
+		UInt32 bodyEntryActiveId;
+
+		// First draw item of cached panel in current frame
+		Int32 cacheFirstItem;
+
+		// First draw item of panel body, items before are panel background and header
+		Int32 bodyFirstItem;
+		Float32 bottomPadding;
+
+		// Offset of panel body from panel top: header height and top content padding
+		Float32 bodyTop;
+
 		bool bCollapsed : 1;
 		bool bAutoSize : 1;
+		bool bCached : 1;
+	};
+
+	class UIDrawList;
+
+	// Panel rendered into texture, reused while its draw items stay the same
+	struct UIPanelCache
+	{
+		UInt32 textureHandle;
+		UInt32 width;
+		UInt32 height;
+		UInt32 contentHash;
+		UInt32 interactionKey;
+		UInt32 version;
+		UInt32 lastUsedFrame;
+		UIDrawList* drawList;
+	};
+
+	// Panel rect in draw order of a frame, used for panel occlusion test
+	struct UIPanelDrawInfo
+	{
+		UInt32 id;
+		UIRect rect;
+		bool bOpaque;
+	};
+
+	// Row height index for virtualized list
+	// Fenwick tree over row heights: O(log n) row offset, row lookup at offset and height update
+	class UIHeightIndex
+	{
+	public:
+		void resize(UInt32 count, Float32 estimatedHeight);
+		void setHeight(UInt32 index, Float32 height);
+		Float32 getHeight(UInt32 index) const { return m_heights[index]; }
+
+		// Sum of heights of all rows before index
+		Float64 getOffset(UInt32 index) const;
+
+		// Index of the row that contains offset
+		UInt32 findIndexAtOffset(Float64 offset) const;
+
+		Float64 getTotalHeight() const { return getOffset(m_count); }
+		UInt32 count() const { return m_count; }
+
+	protected:
+		UInt32 m_count = 0;
+		UIArray<Float32> m_heights;
+		UIArray<Float64> m_tree; // 1-based
+	};
+
+	class UIItemListCache;
+
+	// Virtual List State
+	struct UIVirtualListState : UIScrollState
+	{
+		UIHeightIndex rowHeights;
+		Float32 rowStartPos;
+
+		// Cache for asynchronous item list provider
+		UIItemListCache* itemCache;
+	};
+
+	class UITableSortJob;
+
+	// Table State
+	struct UITableState : UIScrollState
+	{
+		UIArray<Float32> columnWidths;
+		Float32 scrollOffsetX;
+		Float32 rowHeight;
+
+		// Sorting and filtering
+		Int32 sortColumn;
+		bool bSortAscending;
+		UIArray<UIChar> filterText;
+		UInt32 dataRowCount;
+		UITableSortJob* sortJob;
+
+		// Maps view row to data row, used when bUseRowOrder is set. Otherwise view row is data row.
+		UIArray<UInt32> rowOrder;
+		bool bUseRowOrder;
+
+		// Current frame layout. Visible rows and columns are [first, last)
+		UIRect cellsRect;
+		UIArray<Float32> columnOffsets;
+		UInt32 firstRow;
+		UInt32 lastRow;
+		UInt32 firstColumn;
+		UInt32 lastColumn;
+	};
+
+	class TreeDataProvider;
+
+	// Visible row of Tree View
+	struct UITreeRow
+	{
+		UInt32 node;
+		UInt32 depth : 31;
+		UInt32 bExpanded : 1;
+	};
+
+	// Pending children of an expanded tree node, added across frames
+	struct UITreeExpandJob
+	{
+		UInt32 node;
+		UInt32 depth;
+		Int32 parentRow; // -1 for root node
+		UInt32 insertPos;
+		UInt32 nextChild;
+		UInt32 childCount;
+	};
+
+	// Tree View State
+	struct UITreeState : UIScrollState
+	{
+		TreeDataProvider* provider;
+
+		// Flattened visible rows, updated on expand and collapse
+		UIArray<UITreeRow> rows;
+		UIArray<UITreeExpandJob> expandJobs;
+	};
+
+	// Option filter for Searchable Dropdown.
+	// Prefix matches are found in an index of options sorted by text, subsequence matches are narrowed per typed character.
+	class UIOptionFilter
+	{
+	public:
+		// Rebuild index if options changed
+		void setOptions(const UIChar** options, Int32 optionCount);
+
+		// Update matches for filter, only the characters that differ from the previous filter are processed
+		// @return true if filter changed
+		bool setFilter(const UIChar* filter);
+
+		// Matching options: prefix matches first, then the other subsequence matches
+		const UIArray<Int32>& getMatches() const { return m_matches; }
+
+	protected:
+		struct SubsequenceMatch
+		{
+			Int32 option;
+			Int32 nextChar;
+		};
+
+		const UIChar** m_options = nullptr;
+		Int32 m_optionCount = 0;
+
+		// Lower case filter
+		UIArray<UIChar> m_filter;
+
+		// Options sorted by text for prefix lookup
+		UIArray<Int32> m_sortedOptions;
+
+		// Level n: options containing first n filter characters as subsequence
+		UIArray<UIArray<SubsequenceMatch>> m_subsequenceLevels;
+
+		UIArray<UInt32> m_prefixStamps;
+		UInt32 m_currentStamp = 0;
+		UIArray<Int32> m_matches;
+
+		void rebuildMatches();
+	};
+
+	// Searchable Dropdown State
+	struct UIDropdownSearchState
+	{
+		UIOptionFilter optionFilter;
+		UIArray<UIChar> filterBuffer;
+		Float32 scrollOffset;
 	};
 
 	// Menu Info
@@ -199,6 +408,324 @@ namespace ZE
 	};
 
 
+	// Per frame counters, reset on BeginFrame
+	struct UIFrameStats
+	{
+		// Text draws that scanned the text to measure it
+		UInt32 textMeasured = 0;
+
+		// Text draws skipped before any measuring
+		UInt32 textCulled = 0;
+
+		// Widget layouts reused from or recomputed into layout cache
+		UInt32 layoutCacheHits = 0;
+		UInt32 layoutCacheMisses = 0;
+	};
+
+	// Measured label of a widget, reused while inputs hash stays the same
+	struct UIWidgetLayout
+	{
+		UInt32 inputHash;
+		UIVector2 labelSize;
+	};
+
+	// Interaction rect of a widget. Topmost rect under mouse decides which widget is hovered next frame.
+	struct UIHitRect
+	{
+		UIRect rect;
+		UInt32 id;
+		Int32 layer;
+	};
+
+	// How a layout node is sized by its row or column. Grow and shrink are weights along row/column direction.
+	struct UILayoutItem
+	{
+		Float32 grow = 0.0f;
+		Float32 shrink = 0.0f;
+		UIVector2 minSize{ 0.0f, 0.0f };
+		UIVector2 maxSize{ 1.0e30f, 1.0e30f };
+	};
+
+	// Placement of children inside a row or column
+	struct UILayoutStyle
+	{
+		// left, top, right, bottom
+		UIVector4 padding;
+		Float32 spacing;
+
+		// Along row/column direction, only used when no child grows
+		ELayoutAlign mainAlign;
+		ELayoutAlign crossAlign;
+	};
+
+	// Widget or container in layout tree. Nodes of a frame are stored flat in creation order, so a subtree is a contiguous range.
+	struct UILayoutNode
+	{
+		UInt32 id;
+		Int32 root;
+		Int32 parent;
+		Int32 firstChild;
+		Int32 lastChild;
+		Int32 nextSibling;
+		Int32 childCount;
+
+		// Draw items owned by node, moved with it when arranged
+		Int32 firstItem;
+		Int32 lastItem;
+
+		// Scissor masks pushed from this index on are drawn by node, they move with its items
+		Int32 firstScissor;
+
+		// Container only: first draw item not owned by any child yet
+		Int32 nextItem;
+		Int32 nextScissor;
+
+		// Container only: depth of draw position stack its children are drawn at
+		Int32 drawStackDepth;
+
+		UILayoutItem item;
+		UILayoutStyle style;
+
+		UIVector2 measuredSize;
+
+		// Position node was drawn at, before arrange
+		UIVector2 drawPos;
+
+		// Container only: content area and position of next new child
+		UIRect contentRect;
+		UIVector2 cursor;
+
+		// Final rect after arrange, and relative to root to place the node on next frame
+		UIRect rect;
+		UIRect relativeRect;
+
+		bool bContainer : 1;
+		bool bRow : 1;
+		bool bFillCross : 1;
+	};
+
+	// Idle frame counters since Init
+	struct UIIdleStats
+	{
+		// Frames sent to renderer
+		UInt32 renderedFrames = 0;
+
+		// Frames with the same draw list as presented frame, renderer was skipped
+		UInt32 skippedFrames = 0;
+
+		// Times WaitForEvents blocked because nothing changed
+		UInt32 idleWaits = 0;
+	};
+
+	// Retained state of widgets by id. Keys are in an open addressing table (linear probing),
+	// values live in fixed size chunks so references stay valid while the table grows.
+	// Each lookup stamps the entry with current frame, collect() removes entries not used for a number of frames.
+	template<typename T>
+	class UIStateTable
+	{
+	public:
+		// State of id, default constructed if it is new. bCreated is set when state was just added.
+		T& findOrAdd(UInt32 id, bool* bCreated = nullptr);
+
+		// State of id or nullptr. Doesn't stamp the entry.
+		T* find(UInt32 id);
+
+		// Set current frame and remove states older than lifetime frames, onRemove(state) is called before each removal.
+		// Scans budget slots plus enough to go over whole table every lifetime/2 frames, continuing where last call stopped.
+		template<typename Func>
+		void collect(UInt32 frame, UInt32 lifetime, UInt32 budget, Func onRemove);
+
+		template<typename Func>
+		void forEach(Func func);
+
+		void clear();
+
+		UInt32 size() const { return m_count; }
+
+		// Allocated state values, used or free
+		UInt32 capacity() const { return (UInt32)m_chunks.size() * ChunkSize; }
+
+	protected:
+		struct Slot
+		{
+			UInt32 key;
+			UInt32 lastUsedFrame;
+			Int32 value; // -1 if slot is empty
+		};
+
+		static const UInt32 ChunkSize = 64;
+
+		UIArray<Slot> m_slots;
+		UIArray<UIArray<T>> m_chunks;
+		UIArray<Int32> m_freeValues;
+		UInt32 m_count = 0;
+		UInt32 m_collectPos = 0;
+		UInt32 m_frame = 0;
+
+		T& getValue(Int32 index) { return m_chunks[index / ChunkSize][index % ChunkSize]; }
+		UInt32 getHome(UInt32 key) const { return (key * 2654435761u) & (UInt32)(m_slots.size() - 1); }
+		Int32 allocValue();
+		void grow();
+		void removeSlot(UInt32 pos);
+	};
+
+	template<typename T>
+	T& UIStateTable<T>::findOrAdd(UInt32 id, bool* bCreated)
+	{
+		if ((m_count + 1) * 4 > m_slots.size() * 3)
+		{
+			grow();
+		}
+
+		const UInt32 mask = (UInt32)m_slots.size() - 1;
+		UInt32 pos = getHome(id);
+		while (m_slots[pos].value >= 0 && m_slots[pos].key != id)
+		{
+			pos = (pos + 1) & mask;
+		}
+
+		Slot& slot = m_slots[pos];
+		const bool bNew = slot.value < 0;
+		if (bNew)
+		{
+			slot.key = id;
+			slot.value = allocValue();
+			m_count++;
+		}
+		slot.lastUsedFrame = m_frame;
+
+		if (bCreated) { *bCreated = bNew; }
+		return getValue(slot.value);
+	}
+
+	template<typename T>
+	T* UIStateTable<T>::find(UInt32 id)
+	{
+		if (m_count == 0) { return nullptr; }
+
+		const UInt32 mask = (UInt32)m_slots.size() - 1;
+		for (UInt32 pos = getHome(id); m_slots[pos].value >= 0; pos = (pos + 1) & mask)
+		{
+			if (m_slots[pos].key == id) { return &getValue(m_slots[pos].value); }
+		}
+		return nullptr;
+	}
+
+	template<typename T>
+	template<typename Func>
+	void UIStateTable<T>::collect(UInt32 frame, UInt32 lifetime, UInt32 budget, Func onRemove)
+	{
+		m_frame = frame;
+		if (m_count == 0) { return; }
+
+		// Expired state is found at most lifetime/2 frames late, so live states stay bounded by rate of new states
+		const UInt32 slotCount = (UInt32)m_slots.size();
+		UInt32 scanCount = budget + slotCount * 2 / (lifetime > 0 ? lifetime : 1);
+		if (scanCount > slotCount) { scanCount = slotCount; }
+
+		for (UInt32 i = 0; i < scanCount; i++)
+		{
+			m_collectPos = m_collectPos < slotCount ? m_collectPos : 0;
+			Slot& slot = m_slots[m_collectPos];
+			if (slot.value >= 0 && frame - slot.lastUsedFrame > lifetime)
+			{
+				onRemove(getValue(slot.value));
+				// Slot gets the next entry of its probe chain, look at same slot again
+				removeSlot(m_collectPos);
+				continue;
+			}
+			m_collectPos++;
+		}
+	}
+
+	template<typename T>
+	template<typename Func>
+	void UIStateTable<T>::forEach(Func func)
+	{
+		for (Slot& slot : m_slots)
+		{
+			if (slot.value >= 0) { func(getValue(slot.value)); }
+		}
+	}
+
+	template<typename T>
+	void UIStateTable<T>::clear()
+	{
+		m_slots.clear();
+		m_chunks.clear();
+		m_freeValues.clear();
+		m_count = 0;
+		m_collectPos = 0;
+	}
+
+	template<typename T>
+	Int32 UIStateTable<T>::allocValue()
+	{
+		if (m_freeValues.size() > 0)
+		{
+			const Int32 index = m_freeValues.back();
+			m_freeValues.pop_back();
+			return index;
+		}
+
+		// New chunk, its values are used from the back of free list
+		const Int32 firstIndex = (Int32)(m_chunks.size() * ChunkSize);
+		m_chunks.push_back(UIArray<T>(ChunkSize));
+		for (Int32 i = ChunkSize - 1; i > 0; i--)
+		{
+			m_freeValues.push_back(firstIndex + i);
+		}
+		return firstIndex;
+	}
+
+	template<typename T>
+	void UIStateTable<T>::grow()
+	{
+		UIArray<Slot> oldSlots;
+		oldSlots.swap(m_slots);
+		m_slots.assign(oldSlots.size() > 0 ? oldSlots.size() * 2 : 64, Slot{ 0, 0, -1 });
+		m_collectPos = 0;
+
+		const UInt32 mask = (UInt32)m_slots.size() - 1;
+		for (const Slot& slot : oldSlots)
+		{
+			if (slot.value < 0) { continue; }
+
+			UInt32 pos = getHome(slot.key);
+			while (m_slots[pos].value >= 0)
+			{
+				pos = (pos + 1) & mask;
+			}
+			m_slots[pos] = slot;
+		}
+	}
+
+	template<typename T>
+	void UIStateTable<T>::removeSlot(UInt32 pos)
+	{
+		// Release state memory, value is reused by a later state
+		getValue(m_slots[pos].value) = T();
+		m_freeValues.push_back(m_slots[pos].value);
+		m_count--;
+
+		// Backward shift: move later entries of the probe chain into the hole, so lookups need no tombstones
+		const UInt32 mask = (UInt32)m_slots.size() - 1;
+		UInt32 hole = pos;
+		UInt32 next = (pos + 1) & mask;
+		while (m_slots[next].value >= 0)
+		{
+			const UInt32 home = getHome(m_slots[next].key);
+			// Entry can move to hole if hole is between its home and its current slot (cyclic)
+			if (((next - home) & mask) >= ((next - hole) & mask))
+			{
+				m_slots[hole] = m_slots[next];
+				hole = next;
+			}
+			next = (next + 1) & mask;
+		}
+		m_slots[hole].value = -1;
+	}
+
 	// Internal UIState
 	// Used for Global purposes and Render purpose
 	class UIState
@@ -259,14 +786,86 @@ namespace ZE
 		// Menu Info stack
 		UIArray<UIMenuInfo> MenuStack;
 
-		// Interaction Rect Stack
+		// Interaction Rect Stack, each entry already clipped by the one below it.
+		// Clip box stack has the same entries as min/max boxes for clip tests.
 		UIArray<UIRect> DrawRectStack;
+		UIArray<UIClipBox> ClipBoxStack;
 
 		// Panel State Map
-		UIHashMap<UInt32, UIPanelState> panelStates;
+		UIStateTable<UIPanelState> panelStates;
+
+		// Panels drawn on current and previous frame
+		UIArray<UIPanelDrawInfo> panelDrawInfos;
+		UIArray<UIPanelDrawInfo> lastPanelDrawInfos;
+
+		// Widget layout cache
+		UIStateTable<UIWidgetLayout> widgetLayouts;
+		bool bLayoutCache;
+
+		// Row/Column layout nodes of current and previous frame, open containers are on layout stack.
+		// Node arrays are only grown, count is reset every frame.
+		UIArray<UILayoutNode> layoutNodes;
+		UIArray<UILayoutNode> lastLayoutNodes;
+		Int32 layoutNodeCount;
+		Int32 lastLayoutNodeCount;
+		UIArray<Int32> layoutStack;
+		UILayoutItem nextLayoutItem;
+		bool bHasNextLayoutItem;
+		UInt32 layoutRootCount;
+
+		// Nesting of widget calls, explicit rect widgets leave layout when outermost call ends
+		Int32 widgetDepth;
+
+		// Interaction rects of current frame and uniform grid of previous frame's rects.
+		// Cell i holds hitGridEntries[hitGridCellStart[i], hitGridCellStart[i+1]), in record order.
+		UIArray<UIHitRect> hitRects;
+		UIArray<UIHitRect> lastHitRects;
+		UIArray<UInt32> hitGridCellStart;
+		UIArray<UInt32> hitGridEntries;
+		Int32 hitGridColumns;
+		Int32 hitGridRows;
+		UInt32 hoveredId;
+		Int32 hoveredLayer;
+		bool bHitGrid;
+
+		// Cached panel textures
+		UIHashMap<UInt32, UIPanelCache> panelCaches;
+		UInt32 panelCacheBytes;
+		UInt32 frameCount;
+		bool bRenderTargetUnsupported;
 
 		// Scroll State Map
-		UIHashMap<UInt32, UIScrollState> scrollStates;
+		UIStateTable<UIScrollState> scrollStates;
+
+		// Virtual List State Map
+		UIStateTable<UIVirtualListState> virtualListStates;
+
+		// Virtual List stack
+		UIArray<UIVirtualListState*> virtualListStack;
+
+		// Table State Map
+		UIStateTable<UITableState> tableStates;
+
+		// Table stack
+		UIArray<UITableState*> tableStack;
+
+		// Tree View State Map
+		UIStateTable<UITreeState> treeStates;
+
+		// Searchable Dropdown State Map
+		UIStateTable<UIDropdownSearchState> dropdownSearchStates;
+
+		// Frame Stats
+		UIFrameStats frameStats;
+
+		// Idle frame detection
+		UIIdleStats idleStats;
+		UIArray<UIDrawItemRecord> drawItemRecords;
+		bool bPartialRedraw;
+		UInt32 drawListHash;
+		bool bInputChanged;
+		bool bDrawListChanged;
+		bool bIdleFrame;
 
 	public:
 
@@ -282,6 +881,9 @@ namespace ZE
 		UIVector4 color;
 		UIVector4 uvDim;
 
+		// Screen rect (x, y, width, height) instance is cropped to, no crop when width is zero
+		UIVector4 clip;
+
 		UIDrawInstance() {}
 
 		UIDrawInstance(const UIVector2& pos, Float32 depth, const UIVector2& dimension, Float32 radius, const UIVector4& color, const UIVector4& uvDim)
@@ -304,6 +906,61 @@ namespace ZE
 		}
 	};
 
+	// Packed upload format of UIDrawInstance. Depth stays float so consecutive draws keep distinct depth values.
+	struct UIPackedDrawInstance
+	{
+		// Pixels per fixed point step of position, dimension, radius and clip
+		static constexpr Float32 PositionUnit = 0.25f;
+
+		Int16 pos[2];
+		Float32 depth;
+		Int16 dimension[4]; // width, height, radius, unused
+		UInt8 color[4];
+		Int16 uvDim[4]; // signed normalized, flipped render targets use negative height
+		Int16 clip[4];
+
+		UIPackedDrawInstance() {}
+		explicit UIPackedDrawInstance(const UIDrawInstance& instance);
+	};
+
+	// Insets of shape instance in pixels (top, bottom, left, right), expanded by shape shaders.
+	// Textured: nine slice borders keep image scale, negative radius leaves out center slice.
+	// Untextured: border thickness, border color is carried in uvDim.
+	// Only nine slice and bordered rects have them, so they are a separate stream next to instances.
+	typedef UIVector4 UIInstanceInsets;
+
+	// Packed upload format of UIInstanceInsets, same fixed point as UIPackedDrawInstance
+	struct UIPackedInstanceInsets
+	{
+		Int16 insets[4];
+
+		UIPackedInstanceInsets() {}
+		explicit UIPackedInstanceInsets(const UIInstanceInsets& instanceInsets);
+	};
+
+	// Instance format renderers upload
+#if defined(ZUI_USE_PACKED_INSTANCES)
+	typedef UIPackedDrawInstance UIRenderInstance;
+#else
+	typedef UIDrawInstance UIRenderInstance;
+#endif
+
+	// Instance insets format renderers upload
+#if defined(ZUI_USE_PACKED_INSTANCES)
+	typedef UIPackedInstanceInsets UIRenderInstanceInsets;
+#else
+	typedef UIInstanceInsets UIRenderInstanceInsets;
+#endif
+
+	// Pixel rect, top left origin
+	struct UIScissorRect
+	{
+		Int32 x;
+		Int32 y;
+		Int32 width;
+		Int32 height;
+	};
+
 	class UIDrawItem
 	{
 		friend class UIDrawer;
@@ -313,6 +970,10 @@ namespace ZE
 		UIArray<UIVertex>& getVertices();
 		UIArray<UIDrawInstance>& getInstances();
 
+		// Insets of shape instances, empty when no instance has them. Instances past the end have zero insets.
+		const UIArray<UIInstanceInsets>& getInstanceInsets() const { return m_instanceInsets; }
+		bool hasInstanceInsets() const { return m_instanceInsets.size() > 0; }
+
 		UInt32 getTextureHandle() const { return m_textureHandle; }
 
 		bool isFont() const { return m_bFont; }
@@ -328,12 +989,36 @@ namespace ZE
 		Float32 getRoundness() const { return m_roundness; }
 		UInt32 getLayer() const { return m_layer; }
 
+		// Axis aligned mask the item is clipped to, snapped to pixels the way rasterization covers them
+		bool hasScissor() const { return m_bScissor; }
+		UIScissorRect getScissorRect() const;
+		const UIRect& getScissorArea() const { return m_scissorArea; }
+
+		// Scissor masks are counted per frame, items of scissor pushed at or after an index can be told apart
+		Int32 getScissorIndex() const { return m_scissorIndex; }
+
+		// Screen area covered by this item, updated on UI::EndFrame
+		const UIRect& getBounds() const { return m_bounds; }
+
+		// Changed when content of render target texture changed
+		UInt32 getTextureVersion() const { return m_textureVersion; }
+
+		// Move everything drawn by this item, scissor too if it belongs to the moved content
+		void translate(const UIVector2& delta, bool bMoveScissor);
+
+		// Move every point below splitY down by delta, shapes crossing splitY get taller
+		void extendBottom(Float32 splitY, Float32 delta);
+
 		void reset();
 
 	protected:
+		// Set insets of last added instance
+		void setLastInstanceInsets(const UIInstanceInsets& instanceInsets);
+
 		bool m_bFont = false;
 		bool m_bUsingRectInstance = false;
 		bool m_bCrop = false;
+		bool m_bScissor = false;
 		EDrawMaskProcess m_Mask = DRAW_MASK_NONE;
 
 		UInt32 m_textureHandle = 0;
@@ -344,6 +1029,13 @@ namespace ZE
 
 		UIArray<UIVertex> m_vertices;
 		UIArray<UIDrawInstance> m_instances;
+		UIArray<UIInstanceInsets> m_instanceInsets;
+
+		UIRect m_scissorArea;
+		Int32 m_scissorIndex = -1;
+
+		UIRect m_bounds;
+		UInt32 m_textureVersion = 0;
 	};
 
 	class UIDrawList
@@ -359,11 +1051,40 @@ namespace ZE
 		UIDrawItem* getNextDrawItem();
 		void reset();
 
+		// Drop items from index to the end of list
+		void truncate(Int32 _index);
+
+		// Move items from index to the end of list into other list
+		void moveItemsTo(UIDrawList& targetList, Int32 _index);
+
+		// Compare draw items with previous frame records and compute damage rect, records are replaced with this frame ones.
+		// Return hash of all draw items, same hash means same rendered output
+		UInt32 updateDamage(UIArray<UIDrawItemRecord>& records, const UIRect& screenRect, bool bFullRedraw);
+
+		// Screen area that changed from previous frame, only valid if not full redraw
+		const UIRect& getDamageRect() const { return m_damageRect; }
+		bool isFullRedraw() const { return m_bFullRedraw; }
+
+		// Compute screen bounds of every item, done by updateDamage for main draw list
+		void updateBounds();
+
+		// Build submission order from 64 bit key per item: layer, mask scope, sequence, then shader and texture
+		// among neighbouring items that don't overlap. Keys are radix sorted, same key keeps call order.
+		void sortItems();
+		UIDrawItem* getSortedDrawItem(Int32 _index) const { return m_drawItems[m_sortedIndices[_index]]; }
+
+		// Item has to be redrawn for damage rect, masks are always needed
+		bool needsRedraw(const UIDrawItem* drawItem) const { return needsRedraw(drawItem, m_damageRect); }
+		bool needsRedraw(const UIDrawItem* drawItem, const UIRect& damageRect) const;
+
 		void freeDrawItems();
 
 		UIDrawItem* getTextureInstanceDrawItem(UInt32 _index);
 		UIDrawItem* getTextureDrawItem(UInt32 textureHandle);
 
+		// Items drawn after this get new texture groups, e.g. when clip state changes
+		void breakTextureGroups();
+
 	protected:
 		UInt32 m_count = 0;
 
@@ -371,6 +1092,15 @@ namespace ZE
 
 		UIHashMap<UInt32, UInt32> m_textureToDrawItemMap;
 		UIHashMap<UInt32, UInt32> m_textureToInstanceDrawItem;
+
+		UIRect m_damageRect;
+		bool m_bFullRedraw = true;
+
+		// Sort buffers kept between frames so sorting doesn't allocate
+		UIArray<UInt64> m_sortKeys;
+		UIArray<UInt64> m_sortKeysTemp;
+		UIArray<UInt32> m_sortedIndices;
+		UIArray<UInt32> m_sortedIndicesTemp;
 	};
 
 	struct UIFontCharDesc
@@ -444,6 +1174,14 @@ namespace ZE
 
 		UInt32 getTextureHandle() const { return m_textureHandle; }
 
+		// Area of texture handle this texture covers (offset xy, size zw). Less than 0..1 when packed in atlas page.
+		const UIVector4& getUVRect() const { return m_uvRect; }
+		bool isInAtlas() const { return m_bInAtlas; }
+
+		// Map 0..1 coordinate of this texture into coordinate of texture handle
+		UIVector2 mapUV(const UIVector2& uv) const { return UIVector2(m_uvRect.x + uv.x * m_uvRect.z, m_uvRect.y + uv.y * m_uvRect.w); }
+		UIVector4 mapUVRect(const UIVector4& uvDim) const { return UIVector4(m_uvRect.x + uvDim.x * m_uvRect.z, m_uvRect.y + uvDim.y * m_uvRect.w, uvDim.z * m_uvRect.z, uvDim.w * m_uvRect.w); }
+
 		void release();
 
 	protected:
@@ -451,6 +1189,8 @@ namespace ZE
 		Int32 m_height;
 		UInt32 m_textureHandle;
 		UIRenderer* m_renderer;
+		UIVector4 m_uvRect = UIVector4(0.0f, 0.0f, 1.0f, 1.0f);
+		bool m_bInAtlas = false;
 	};
 
 	class UITextureManager
@@ -461,10 +1201,28 @@ namespace ZE
 
 		static UITexture* LoadTexture(const UIChar* fontFilePath, UIRenderer* renderer);
 
+		// Number of shared atlas pages created so far
+		static UInt32 GetAtlasPageCount() { return s_instance ? (UInt32)s_instance->m_atlasPages.size() : 0; }
+
 	private:
+		// RGBA page texture, images are packed in rows (shelves) from top to bottom
+		struct UITextureAtlasPage
+		{
+			UInt32 textureHandle = 0;
+			UIRenderer* renderer = nullptr;
+			Int32 shelfX = 0;
+			Int32 shelfY = 0;
+			Int32 shelfHeight = 0;
+		};
+
+		// Pack RGBA image into atlas page, return false when renderer can't update textures
+		bool packInAtlas(UITexture* texture, const UInt8* image, Int32 width, Int32 height, UIRenderer* renderer);
+
 		static UITextureManager* s_instance;
 
 		UIArray<UITexture*> m_textures;
+		UIArray<UITextureAtlasPage> m_atlasPages;
+		bool m_bAtlasUnsupported = false;
 	};
 
 	class UIDrawer
@@ -476,14 +1234,17 @@ namespace ZE
 
 		void DrawTexture(const UIRect& rect, UITexture* texture, const UIVector4& fillColor, ETextureScale textureScale = SCALE_IMAGE, const UIVector4& scaleOffset = UIVector4(0.0f));
 		void DrawRect(const UIRect& rect, const UIVector4& fillColor);
+		void DrawBorderRect(const UIRect& rect, const UIVector4& fillColor, Float32 borderThickness, const UIVector4& borderColor);
 		void DrawText(UIVector2& pos, const UIVector4& fillColor, UIFont* font, const UIChar* text, Float32 scale = 1.0f, bool bWordWrap = false, Float32 maxWidth = 0, ETextAlign wrapTextAlign = TEXT_LEFT, const UIVector2& dim = UIVector2(0.0f), Int32* lineCount = nullptr);
 		void DrawCollapseArrow(const UIVector2& pos, const UIVector2& dimension, bool bCollapsed);
 		void DrawCheckboxFrame(const UIRect& rect);
 		void DrawCheckMark(const UIRect& rect);
+		void DrawRenderTarget(const UIRect& rect, UInt32 textureHandle, UInt32 version);
 
 		void Reset();
 		void SwapBuffer();
 		void SetLayer(Int32 layer) { m_currentLayer = layer; }
+		Int32 GetLayer() const { return m_currentLayer; }
 
 		// Draw Mask
 		void PushRectMask(const UIRect& rect);
@@ -492,7 +1253,20 @@ namespace ZE
 
 		UIDrawList* getCurrentDrawList() const { return m_currentDrawList; }
 
+		// Number of scissor masks pushed this frame
+		Int32 GetScissorCount() const { return m_scissorCount; }
+
 	protected:
+		struct UIScissorMask
+		{
+			UIRect area;
+			Int32 layer;
+			Int32 index;
+		};
+
+		// Clip item to innermost scissor mask of its layer
+		void ApplyScissor(UIDrawItem* drawItem);
+
 		UIDrawList m_drawLists[2]; // Double Buffer
 		UIDrawList* m_currentDrawList; // Pointer to current Drawlist
 		Float32 m_currentDepth = 0.00001f;
@@ -500,7 +1274,10 @@ namespace ZE
 		const Float32 m_step = 0.00001f;
 		Int32 m_maskIgnore = 0;
 
+		// Null entry for masks done with scissor
 		UIArray<UIDrawItem*> PushMaskDrawStack;
+		UIArray<UIScissorMask> ScissorMaskStack;
+		Int32 m_scissorCount = 0;
 	};
 
 	class StringHelper
@@ -584,6 +1361,9 @@ namespace ZE
 #endif
 		UIFontStyle headerFontStyle;
 		Float32 headerHeight;
+
+		// Space between panel and its content below header: left, top, right, bottom
+		UIVector4 contentPadding;
 	};
 
 	struct UIDropdownStyle
@@ -622,12 +1402,77 @@ namespace ZE
 		Float32 menuPadding;
 	};
 
+	struct UITableStyle
+	{
+		UIFontStyle headerFontStyle;
+		UIFontStyle cellFontStyle;
+		UIVector4 headerColor;
+		UIVector4 headerHoverColor;
+		UIVector4 rowColor;
+		UIVector4 alternateRowColor;
+		UIVector4 textColor;
+		UIVector4 resizeHandleColor;
+		Float32 cellPadding;
+		Float32 resizeHandleSize;
+		Float32 minColumnWidth;
+	};
+
+	struct UITreeStyle
+	{
+		UIFontStyle fontStyle;
+		UIVector4 textColor;
+		UIVector4 selectionColor;
+		UIVector4 hoverColor;
+		UIVector2 arrowSize;
+		Float32 indentSize;
+		Float32 rowPadding;
+	};
+
 	// ItemListProvider is used to populate item to view in ListView and SelectionListView
 	class ItemListProvider
 	{
 	public:
 		virtual const UIChar* getItemAt(UInt32 index) const = 0;
 		virtual Int32 count() const = 0;
+
+		// Fetch items [first, first + count) in one call. Override if getting items one by one is expensive.
+		virtual void fetchRange(UInt32 first, UInt32 count, const UIChar** outItems) const
+		{
+			for (UInt32 i = 0; i < count; i++)
+			{
+				outItems[i] = getItemAt(first + i);
+			}
+		}
+	};
+
+	// Block of loaded item texts, texts are copied into the block
+	class UIItemListBlock
+	{
+	public:
+		void addItem(const UIChar* text);
+		const UIChar* getItem(UInt32 index) const { return &m_text[m_offsets[index]]; }
+		UInt32 count() const { return (UInt32)m_offsets.size(); }
+		void clear() { m_text.clear(); m_offsets.clear(); }
+
+	protected:
+		UIArray<UIChar> m_text;
+		UIArray<UInt32> m_offsets;
+	};
+
+	// Item List Provider for slow data sources.
+	// Items are loaded in blocks by the background loader and cached per list view, placeholder is shown until loaded.
+	// Provider has to stay alive until UI::Destroy or until its list view is given another provider.
+	class AsyncItemListProvider : public ItemListProvider
+	{
+	public:
+		// Load items [first, first + count) into outBlock. Called from the loader thread.
+		virtual void loadRange(UInt32 first, UInt32 count, UIItemListBlock& outBlock) = 0;
+
+		// Text for items that are not loaded yet
+		virtual const UIChar* getPlaceholder() const { return "..."; }
+
+		// Synchronous access only gives placeholder, list views get items from their cache
+		virtual const UIChar* getItemAt(UInt32 /*index*/) const { return getPlaceholder(); }
 	};
 
 	class TextItemListProvider : public ItemListProvider
@@ -642,6 +1487,47 @@ namespace ZE
 		UInt32 m_count;
 	};
 
+	// Table Column
+	struct UITableColumn
+	{
+		const UIChar* label;
+		Float32 width;
+	};
+
+	// TableDataProvider is used to populate cells of Table.
+	// Sorting and filtering call it from worker thread, data mustn't change while a sort is running.
+	class TableDataProvider
+	{
+	public:
+		virtual const UIChar* getCell(UInt32 row, UInt32 column) const = 0;
+		virtual Int32 rowCount() const = 0;
+		virtual Int32 columnCount() const = 0;
+
+		// Compare rows on column for sorting. Default compares cell texts.
+		virtual bool lessThan(UInt32 rowA, UInt32 rowB, UInt32 column) const;
+
+		// Check if row should be shown for filter. Default checks if any cell text contains filter.
+		virtual bool passFilter(UInt32 row, const UIChar* filter) const;
+	};
+
+	// TreeDataProvider is used to populate nodes of Tree View. Children are only asked for when their parent is expanded.
+	class TreeDataProvider
+	{
+	public:
+		static const UInt32 InvalidNode = 0xFFFFFFFF;
+
+		// Root node isn't shown, its children are the top rows
+		virtual UInt32 getRootNode() const { return 0; }
+		virtual UInt32 getChildCount(UInt32 node) const = 0;
+
+		// Fetch children [first, first + count) of node
+		virtual void fetchChildren(UInt32 node, UInt32 first, UInt32 count, UInt32* outChildren) const = 0;
+		virtual const UIChar* getLabel(UInt32 node) const = 0;
+
+		// Used to show expand arrow. Override if child count is expensive.
+		virtual bool hasChildren(UInt32 node) const { return getChildCount(node) > 0; }
+	};
+
 	// Functions to use to draw everything
 	namespace UI
 	{
@@ -662,6 +1548,9 @@ namespace ZE
 		extern UIMenuStyle DefaultMenuStyle;
 		extern UIMenuStyle DefaultSubMenuStyle;
 		extern UIScrollBarStyle DefaultScrollBarStyle;
+		extern UITableStyle DefaultTableStyle;
+		extern UITreeStyle DefaultTreeStyle;
+		extern UILayoutStyle DefaultLayoutStyle;
 
 		// ID Stack
 		extern UIStack<UInt32> StackIDs;
@@ -672,6 +1561,27 @@ namespace ZE
 
 		UIRenderer* GetRenderer();
 
+		// Instances in upload format. Packs them into packBuffer when packed format is used.
+		const UIRenderInstance* GetRenderInstances(const UIArray<UIDrawInstance>& instances, UIArray<UIRenderInstance>& packBuffer);
+
+		// Insets of instanceCount instances in upload format, missing insets are zero. Uses packBuffer unless insets can be uploaded as they are.
+		const UIRenderInstanceInsets* GetRenderInstanceInsets(const UIArray<UIInstanceInsets>& instanceInsets, size_t instanceCount, UIArray<UIRenderInstanceInsets>& packBuffer);
+
+		// Pixels per unit of uploaded instance position, dimension and clip, for instance shaders
+		Float32 GetRenderInstanceUnit();
+
+		// Vertex path quads are 4 vertices each, drawn as triangles 0-1-2 and 0-2-3 from a shared index buffer
+		const UInt32 QuadIndexCount = 6;
+
+		// Quads covered by the shared index buffer, longer vertex lists are drawn in chunks with a base vertex
+		const UInt32 QuadIndexBufferQuads = 16384;
+
+		// Fill QuadIndexCount indices for each of quadCount quads
+		void FillQuadIndices(UInt16* indices, UInt32 quadCount);
+
+		const UIFrameStats& GetFrameStats();
+		const UIIdleStats& GetIdleStats();
+
 		UInt32 GetUIIDFromString(const UIChar* textData, UInt32 length = 255);
 		UInt32 GetUIIDFromPointer(const void* pData);
 
@@ -681,8 +1591,15 @@ namespace ZE
 		void ClearDrawRect();
 		UIRect CalculateInteractionRect(const UIRect& rect);
 		bool CheckMouseInside(const UIRect& rect);
+
+		// Record widget interaction rect and check if widget is topmost under mouse. Layer -1 uses current draw layer.
+		bool CheckMouseHover(UInt32 _id, const UIRect& rect, Int32 layer = -1);
 		bool ShouldDrawRect(const UIRect& rect);
 
+		// Test rects against current draw rect in one pass. outVisible[i] is 1 if rects[i] can be seen.
+		// @return number of visible rects
+		Int32 CullRects(const UIRect* rects, Int32 count, UInt8* outVisible);
+
 		// Function
 		void Init(Int32 width, Int32 height);
 		void ResizeWindow(Int32 width, Int32 height);
@@ -707,6 +1624,40 @@ namespace ZE
 		// Record Mouse scroll input
 		void RecordMouseScroll(Float32 yOffset);
 
+		// ==============================================
+		// Idle frame
+
+		// Block until next input event when last frame had no input and the same output as the frame before
+		// timeoutMS < 0 waits without timeout. Return true if it waited.
+		bool WaitForEvents(Float32 timeoutMS = -1.0f);
+
+		// Request a new frame to be built and fully rendered, for timers, animations or data loaded in background. Thread safe.
+		void RequestRedraw();
+
+		// Let renderer redraw only screen area that changed from previous frame
+		void SetPartialRedraw(bool bEnable);
+
+		// Reuse measured widget labels from previous frames
+		void SetLayoutCache(bool bEnable);
+
+		// Resolve hovered widget from previous frame's interaction rects, so only topmost widget under mouse reacts
+		void SetHitGrid(bool bEnable);
+
+		// ==============================================
+		// Layout
+
+		// Row/Column containers. Widgets inside are measured while drawn and moved to their arranged place when outermost container ends.
+		void BeginRow(const UILayoutStyle& style = DefaultLayoutStyle);
+		void EndRow();
+		void BeginColumn(const UILayoutStyle& style = DefaultLayoutStyle);
+		void EndColumn();
+
+		// Sizing of the next widget or container in current row/column
+		void SetNextLayoutItem(Float32 grow, Float32 shrink = 0.0f, const UIVector2& minSize = UIVector2(0.0f), const UIVector2& maxSize = UIVector2(1.0e30f));
+
+		// Move draw position after a widget of given size was drawn, widget becomes a layout node if a row/column is open
+		void AdvanceDrawPos(const UIVector2& size, Float32 spacing = 5.0f);
+
 		// ==============================================
 
 		// ==============================================
@@ -741,6 +1692,11 @@ namespace ZE
 		void DoDropDown(Int32* selectedIdx, const UIChar** textOptions, Int32 optionCount, const UIDropdownStyle& style = DefaultDropdownStyle);
 		void DoDropDownEx(const UIRect& rect, Int32* selectedIdx, const UIChar** textOptions, Int32 optionCount, const UIDropdownStyle& style = DefaultDropdownStyle);
 
+		// Searchable Dropdown: popup shows at most maxVisibleOptions rows and scrolls, only visible rows are drawn.
+		// Typing while open filters options by prefix and subsequence.
+		void DoSearchableDropDown(Int32* selectedIdx, const UIChar** textOptions, Int32 optionCount, Int32 maxVisibleOptions = 10, const UIDropdownStyle& style = DefaultDropdownStyle);
+		void DoSearchableDropDownEx(const UIRect& rect, Int32* selectedIdx, const UIChar** textOptions, Int32 optionCount, Int32 maxVisibleOptions = 10, const UIDropdownStyle& style = DefaultDropdownStyle);
+
 		// Text Input
 		void DoTextInput(UIChar* bufferChar, Int32 bufferCount, const UITextInputStyle& style = DefaultTextInputStyle);
 		void DoTextInputEx(const UIRect& rect, UIChar* bufferChar, Int32 bufferCount, const UITextInputStyle& style = DefaultTextInputStyle);
@@ -771,6 +1727,9 @@ namespace ZE
 		// @return true if panel is created and not closed
 		bool BeginPanel(const UIChar* panelLabel, const UIRect initialRect, bool bAutoSize = false, const UIPanelStyle& style = DefaultPanelStyle);
 
+		// Same as BeginPanel but panel is rendered into texture and reused until its content, size or interaction changes
+		bool BeginCachedPanel(const UIChar* panelLabel, const UIRect initialRect, bool bAutoSize = false, const UIPanelStyle& style = DefaultPanelStyle);
+
 		// End of the panel
 		void EndPanel();
 
@@ -797,6 +1756,85 @@ namespace ZE
 		// Specialize function with Item List Provider
 		void DoListView(const UIChar* listName, const UIRect& rect, ItemListProvider* itemProvider);
 
+		// Begin Virtual List View. Only rows inside the view are laid out, each row height is measured on first display.
+		// Rows not displayed yet use estimatedItemHeight.
+		// @return index of the first visible row
+		UInt32 BeginVirtualListView(const UIChar* listName, const UIRect& rect, UInt32 itemCount, Float32 estimatedItemHeight);
+
+		// Begin row of the current Virtual List View
+		// @return false if the row is out of the view or out of the item count
+		bool BeginVirtualListItem(UInt32 index);
+
+		// End row of the current Virtual List View and update its measured height
+		void EndVirtualListItem(UInt32 index);
+
+		// End Virtual List View
+		void EndVirtualListView();
+
+		template<typename Func>
+		void DoVirtualListView(const UIChar* listName, const UIRect& rect, UInt32 itemCount, Float32 estimatedItemHeight, Func func)
+		{
+			UInt32 index = BeginVirtualListView(listName, rect, itemCount, estimatedItemHeight);
+			while (BeginVirtualListItem(index))
+			{
+				func(index);
+				EndVirtualListItem(index);
+				index++;
+			}
+			EndVirtualListView();
+		}
+
+		// Specialize Virtual List View with Item List Provider, using multi line DoText
+		void DoVirtualListView(const UIChar* listName, const UIRect& rect, ItemListProvider* itemProvider, Float32 estimatedItemHeight);
+
+		// Specialize Virtual List View with Async Item List Provider. Items are loaded in background and cached in the view.
+		void DoVirtualListView(const UIChar* listName, const UIRect& rect, AsyncItemListProvider* itemProvider, Float32 estimatedItemHeight);
+
+		// Begin Table. Draws frozen header row, handles column resize and sort on header click.
+		// Rows and columns outside of the view are skipped, filter and sort are done on worker thread and swapped in when done.
+		// @return table state with the visible rows and columns of this frame
+		const UITableState& BeginTable(const UIChar* tableName, const UIRect& rect, const UITableColumn* columns, UInt32 columnCount, TableDataProvider* dataProvider, const UIChar* filter = nullptr, const UITableStyle& style = DefaultTableStyle);
+
+		// Begin Table Column: Mask cells to the column
+		void BeginTableColumn(UInt32 column);
+
+		// End Table Column
+		void EndTableColumn();
+
+		// Get Cell rect of view row and column
+		UIRect GetTableCellRect(UInt32 viewRow, UInt32 column);
+
+		// Get Data row of view row, after sort and filter
+		UInt32 GetTableDataRow(UInt32 viewRow);
+
+		// End Table
+		void EndTable();
+
+		// Table with custom cell: cellFunc(UInt32 dataRow, UInt32 column, const UIRect& cellRect)
+		template<typename Func>
+		void DoTable(const UIChar* tableName, const UIRect& rect, const UITableColumn* columns, UInt32 columnCount, TableDataProvider* dataProvider, const UIChar* filter, Func cellFunc)
+		{
+			const UITableState& tableState = BeginTable(tableName, rect, columns, columnCount, dataProvider, filter);
+			for (UInt32 column = tableState.firstColumn; column < tableState.lastColumn; column++)
+			{
+				BeginTableColumn(column);
+				for (UInt32 row = tableState.firstRow; row < tableState.lastRow; row++)
+				{
+					cellFunc(GetTableDataRow(row), column, GetTableCellRect(row, column));
+				}
+				EndTableColumn();
+			}
+			EndTable();
+		}
+
+		// Table with text cells from data provider
+		void DoTable(const UIChar* tableName, const UIRect& rect, const UITableColumn* columns, UInt32 columnCount, TableDataProvider* dataProvider, const UIChar* filter = nullptr, const UITableStyle& style = DefaultTableStyle);
+
+		// Tree View: children are pulled from provider when a node is expanded, only rows inside the view are drawn.
+		// Expanding large subtree adds up to ZUI_TREE_EXPAND_BUDGET rows per frame.
+		// @return true if selection changed
+		bool DoTreeView(const UIChar* treeName, const UIRect& rect, TreeDataProvider* dataProvider, UInt32& selectedNode, const UITreeStyle& style = DefaultTreeStyle);
+
 		// Begin Selection List View
 		void BeginSelectionListView(const UIChar* listName, const UIRect& rect, Int32& selection);
 
@@ -853,7 +1891,7 @@ namespace ZE
 
 		// =================================================
 
-		// Process all draw list and render to screen
+		// Process all draw list and render to screen, skipped if draw list is the same as presented frame
 		void ProcessDrawList();
 
 		// Texture Load
@@ -52,9 +52,72 @@
 // Rendering: Rendering group by texture
 //#define ZUI_GROUP_PER_TEXTURE
 
+// Rendering: Max previous draw items in the same layer an item is checked against for overlap before it can be
+// grouped with them by shader and texture. Zero keeps draw items in call order.
+#define ZUI_DRAW_SORT_WINDOW 16
+
+// Rendering: Renderers upload instances in 36 byte packed format instead of 72 byte float format. Position, size,
+// radius and crop box are 1/4 pixel fixed point (within +-8191 pixels), color is 8 bit, texture coordinates 16 bit and depth
+// stays float32. Nine slice and border insets are a separate UIInstanceInsets stream packed to the same fixed point.
+//#define ZUI_USE_PACKED_INSTANCES
+
+// Rendering: Masks without roundness clip with integer scissor rect carried by draw items instead of stencil mask draws
+#define ZUI_USE_SCISSOR_MASK
+
+// Rendering: Renderer only redraws screen area that changed from previous frame
+#define ZUI_USE_PARTIAL_REDRAW
+
+// Layout: Widgets keep measured label size while label, font and style stay the same
+#define ZUI_USE_LAYOUT_CACHE
+
+// Clipping: Batch rect culling against draw rect uses SSE or NEON when target has it
+#define ZUI_USE_SIMD_CLIP
+
+// Memory: Widget states (panels, lists, tables, trees...) not used for this many frames are removed
+#define ZUI_STATE_LIFETIME 600
+
+// Memory: Minimum state table slots checked for old states per frame
+#define ZUI_STATE_COLLECT_BUDGET 32
+
+// Input: Only topmost widget under mouse is hovered, found in a uniform grid of previous frame's interaction rects
+#define ZUI_USE_HIT_GRID
+
+// Input: Cell size in pixels of interaction rect grid
+#define ZUI_HIT_GRID_CELL_SIZE 64
+
+// Rendering: Memory budget of cached panel textures, least recently used panel is evicted first
+#define ZUI_PANEL_CACHE_MAX_BYTES (64 * 1024 * 1024)
+
 // Assets: No textures used for UI Frames
 #define ZUI_STYLE_USE_NO_TEXTURE
 
+// Assets: Small RGB/RGBA textures loaded by texture manager are packed into shared atlas pages,
+// so items using different images share one texture and can be drawn together
+#define ZUI_USE_TEXTURE_ATLAS
+
+// Assets: Width and height of atlas page, and largest image width or height packed into it
+#define ZUI_TEXTURE_ATLAS_SIZE 1024
+#define ZUI_TEXTURE_ATLAS_MAX_IMAGE 256
+
+// Lists: Load items of asynchronous item list providers on a background loader thread.
+// Disable to load them synchronously on the UI thread instead.
+#define ZUI_USE_ASYNC_LIST_LOADER
+
+// Lists: Number of items in one cached block of an asynchronous item list
+#define ZUI_LIST_CACHE_BLOCK_SIZE 64
+
+// Lists: Max cached blocks per list view
+#define ZUI_LIST_CACHE_MAX_BLOCKS 32
+
+// Lists: Number of blocks to prefetch ahead of scroll direction
+#define ZUI_LIST_CACHE_PREFETCH_BLOCKS 2
+
+// Tables: Sort and filter table rows on a worker thread. Disable to sort them on the UI thread instead.
+#define ZUI_USE_ASYNC_TABLE_SORT
+
+// Trees: Max children added per frame per tree view when expanding nodes. Large subtrees are expanded across frames.
+#define ZUI_TREE_EXPAND_BUDGET 8192
+
 // Assets: Main Asset Folder - Where the UI engine looking for assets to use as default
 #define RESOURCE_FOLDER "../../Resource/"
 
@@ -80,9 +143,17 @@ namespace ZE
 {
 	typedef float Float32;
 
+	typedef double Float64;
+
+	typedef std::int16_t Int16;
+
+	typedef std::uint16_t UInt16;
+
 	typedef std::int32_t Int32;
 	
 	typedef std::uint32_t UInt32;
+
+	typedef std::uint64_t UInt64;
 	
 	typedef char UIChar;
 	
@@ -0,0 +1,211 @@
+#include "GL_StateCache.h"
+
+#include <assert.h>
+
+namespace ZE
+{
+	namespace
+	{
+		// Never returned by glGen*, so first bind after invalidate always goes through
+		const GLuint UnknownHandle = 0xFFFFFFFF;
+		const GLenum UnknownEnum = 0xFFFFFFFF;
+	}
+
+	void GL_StateCache::invalidate()
+	{
+		m_program = UnknownHandle;
+		m_vao = UnknownHandle;
+		m_arrayBuffer = UnknownHandle;
+		m_uniformBuffer = UnknownHandle;
+		for (UInt32 i = 0; i < UniformBindingCount; i++)
+		{
+			m_uniformBindings[i] = UnknownHandle;
+			m_uniformOffsets[i] = -1;
+			m_uniformSizes[i] = -1;
+		}
+		m_activeTexture = UnknownEnum;
+		m_texture = UnknownHandle;
+
+		for (UInt32 i = 0; i < CAP_COUNT; i++)
+		{
+			m_capabilities[i] = 2;
+		}
+
+		m_blend[0] = m_blend[1] = m_blend[2] = m_blend[3] = UnknownEnum;
+		m_stencilFunc = UnknownEnum;
+		m_stencilRef = -1;
+		m_stencilFuncMask = 0;
+		m_stencilMask = UnknownHandle;
+		m_stencilOp[0] = m_stencilOp[1] = m_stencilOp[2] = UnknownEnum;
+		m_scissor[0] = m_scissor[1] = m_scissor[2] = m_scissor[3] = -1;
+	}
+
+	void GL_StateCache::useProgram(GLuint program)
+	{
+		if (isChanged(m_program != program))
+		{
+			m_program = program;
+			glUseProgram(program);
+		}
+	}
+
+	void GL_StateCache::bindVertexArray(GLuint vao)
+	{
+		if (isChanged(m_vao != vao))
+		{
+			m_vao = vao;
+			glBindVertexArray(vao);
+		}
+	}
+
+	void GL_StateCache::bindArrayBuffer(GLuint buffer)
+	{
+		if (isChanged(m_arrayBuffer != buffer))
+		{
+			m_arrayBuffer = buffer;
+			glBindBuffer(GL_ARRAY_BUFFER, buffer);
+		}
+	}
+
+	void GL_StateCache::bindUniformBuffer(GLuint buffer)
+	{
+		if (isChanged(m_uniformBuffer != buffer))
+		{
+			m_uniformBuffer = buffer;
+			glBindBuffer(GL_UNIFORM_BUFFER, buffer);
+		}
+	}
+
+	void GL_StateCache::bindUniformBufferBase(GLuint index, GLuint buffer)
+	{
+		assert(index < UniformBindingCount);
+		if (isChanged(m_uniformBindings[index] != buffer || m_uniformOffsets[index] != 0 || m_uniformSizes[index] != 0))
+		{
+			m_uniformBindings[index] = buffer;
+			m_uniformOffsets[index] = 0;
+			m_uniformSizes[index] = 0;
+
+			// Indexed bind also replaces generic binding
+			m_uniformBuffer = buffer;
+			glBindBufferBase(GL_UNIFORM_BUFFER, index, buffer);
+		}
+	}
+
+	void GL_StateCache::bindUniformBufferRange(GLuint index, GLuint buffer, GLintptr offset, GLsizeiptr size)
+	{
+		assert(index < UniformBindingCount);
+		if (isChanged(m_uniformBindings[index] != buffer || m_uniformOffsets[index] != offset || m_uniformSizes[index] != size))
+		{
+			m_uniformBindings[index] = buffer;
+			m_uniformOffsets[index] = offset;
+			m_uniformSizes[index] = size;
+			m_uniformBuffer = buffer;
+			glBindBufferRange(GL_UNIFORM_BUFFER, index, buffer, offset, size);
+		}
+	}
+
+	void GL_StateCache::activeTexture(GLenum unit)
+	{
+		if (isChanged(m_activeTexture != unit))
+		{
+			m_activeTexture = unit;
+
+			// Texture binding is per unit
+			m_texture = UnknownHandle;
+			glActiveTexture(unit);
+		}
+	}
+
+	void GL_StateCache::bindTexture(GLuint texture)
+	{
+		if (isChanged(m_texture != texture))
+		{
+			m_texture = texture;
+			glBindTexture(GL_TEXTURE_2D, texture);
+		}
+	}
+
+	void GL_StateCache::setEnabled(GLenum cap, bool bEnabled)
+	{
+		UInt32 index = CAP_COUNT;
+		switch (cap)
+		{
+		case GL_DEPTH_TEST: index = CAP_DEPTH_TEST; break;
+		case GL_STENCIL_TEST: index = CAP_STENCIL_TEST; break;
+		case GL_SCISSOR_TEST: index = CAP_SCISSOR_TEST; break;
+		case GL_BLEND: index = CAP_BLEND; break;
+		}
+
+		if (index == CAP_COUNT)
+		{
+			// Untracked capability
+			m_issuedCalls++;
+			if (bEnabled) { glEnable(cap); }
+			else { glDisable(cap); }
+			return;
+		}
+
+		const UInt8 value = bEnabled ? 1 : 0;
+		if (isChanged(m_capabilities[index] != value))
+		{
+			m_capabilities[index] = value;
+			if (bEnabled) { glEnable(cap); }
+			else { glDisable(cap); }
+		}
+	}
+
+	void GL_StateCache::blendFuncSeparate(GLenum srcRGB, GLenum dstRGB, GLenum srcAlpha, GLenum dstAlpha)
+	{
+		if (isChanged(m_blend[0] != srcRGB || m_blend[1] != dstRGB || m_blend[2] != srcAlpha || m_blend[3] != dstAlpha))
+		{
+			m_blend[0] = srcRGB;
+			m_blend[1] = dstRGB;
+			m_blend[2] = srcAlpha;
+			m_blend[3] = dstAlpha;
+			glBlendFuncSeparate(srcRGB, dstRGB, srcAlpha, dstAlpha);
+		}
+	}
+
+	void GL_StateCache::stencilFunc(GLenum func, GLint ref, GLuint mask)
+	{
+		if (isChanged(m_stencilFunc != func || m_stencilRef != ref || m_stencilFuncMask != mask))
+		{
+			m_stencilFunc = func;
+			m_stencilRef = ref;
+			m_stencilFuncMask = mask;
+			glStencilFunc(func, ref, mask);
+		}
+	}
+
+	void GL_StateCache::stencilMask(GLuint mask)
+	{
+		if (isChanged(m_stencilMask != mask))
+		{
+			m_stencilMask = mask;
+			glStencilMask(mask);
+		}
+	}
+
+	void GL_StateCache::stencilOp(GLenum sfail, GLenum dpfail, GLenum dppass)
+	{
+		if (isChanged(m_stencilOp[0] != sfail || m_stencilOp[1] != dpfail || m_stencilOp[2] != dppass))
+		{
+			m_stencilOp[0] = sfail;
+			m_stencilOp[1] = dpfail;
+			m_stencilOp[2] = dppass;
+			glStencilOp(sfail, dpfail, dppass);
+		}
+	}
+
+	void GL_StateCache::scissor(GLint x, GLint y, GLsizei width, GLsizei height)
+	{
+		if (isChanged(m_scissor[0] != x || m_scissor[1] != y || m_scissor[2] != width || m_scissor[3] != height))
+		{
+			m_scissor[0] = x;
+			m_scissor[1] = y;
+			m_scissor[2] = width;
+			m_scissor[3] = height;
+			glScissor(x, y, width, height);
+		}
+	}
+}
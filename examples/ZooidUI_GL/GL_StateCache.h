@@ -0,0 +1,87 @@
+#ifndef __ZE_GL_STATE_CACHE__
+#define __ZE_GL_STATE_CACHE__
+
+#include "UI/ZooidUI.h"
+
+#include <gl/glew.h>
+
+namespace ZE
+{
+	// Shadows bound GL objects and fixed function state, only calls GL when the value actually changes
+	class GL_StateCache
+	{
+	public:
+		GL_StateCache() { invalidate(); }
+
+		// Forget shadowed state, next call of each kind always reaches GL
+		void invalidate();
+
+		void useProgram(GLuint program);
+		void bindVertexArray(GLuint vao);
+		void bindArrayBuffer(GLuint buffer);
+		void bindUniformBuffer(GLuint buffer);
+		void bindUniformBufferBase(GLuint index, GLuint buffer);
+		void bindUniformBufferRange(GLuint index, GLuint buffer, GLintptr offset, GLsizeiptr size);
+		void activeTexture(GLenum unit);
+		void bindTexture(GLuint texture);
+
+		// Deleted name may be reused by next glGen*, so it can't stay shadowed as bound
+		void onTextureDeleted(GLuint texture) { if (m_texture == texture) { m_texture = 0; } }
+
+		void setEnabled(GLenum cap, bool bEnabled);
+		void blendFunc(GLenum src, GLenum dst) { blendFuncSeparate(src, dst, src, dst); }
+		void blendFuncSeparate(GLenum srcRGB, GLenum dstRGB, GLenum srcAlpha, GLenum dstAlpha);
+		void stencilFunc(GLenum func, GLint ref, GLuint mask);
+		void stencilMask(GLuint mask);
+		void stencilOp(GLenum sfail, GLenum dpfail, GLenum dppass);
+		void scissor(GLint x, GLint y, GLsizei width, GLsizei height);
+
+		// Call counters since last resetStats
+		void resetStats() { m_issuedCalls = 0; m_savedCalls = 0; }
+		UInt32 getIssuedCalls() const { return m_issuedCalls; }
+		UInt32 getSavedCalls() const { return m_savedCalls; }
+
+	protected:
+		bool isChanged(bool bChanged)
+		{
+			if (bChanged) { m_issuedCalls++; }
+			else { m_savedCalls++; }
+			return bChanged;
+		}
+
+		enum ECapability
+		{
+			CAP_DEPTH_TEST,
+			CAP_STENCIL_TEST,
+			CAP_SCISSOR_TEST,
+			CAP_BLEND,
+			CAP_COUNT
+		};
+
+		static const UInt32 UniformBindingCount = 4;
+
+		GLuint m_program;
+		GLuint m_vao;
+		GLuint m_arrayBuffer;
+		GLuint m_uniformBuffer;
+		GLuint m_uniformBindings[UniformBindingCount];
+		GLintptr m_uniformOffsets[UniformBindingCount];
+		GLsizeiptr m_uniformSizes[UniformBindingCount];
+		GLenum m_activeTexture;
+		GLuint m_texture;
+
+		// 0: disabled, 1: enabled, 2: unknown
+		UInt8 m_capabilities[CAP_COUNT];
+		GLenum m_blend[4];
+		GLenum m_stencilFunc;
+		GLint m_stencilRef;
+		GLuint m_stencilFuncMask;
+		GLuint m_stencilMask;
+		GLenum m_stencilOp[3];
+		GLint m_scissor[4];
+
+		UInt32 m_issuedCalls = 0;
+		UInt32 m_savedCalls = 0;
+	};
+}
+#endif
@@ -6,6 +6,7 @@
 
 #include <iostream>
 #include <assert.h>
+#include <math.h>
 
 #if WIN32 || WIN64
 extern "C"
@@ -17,6 +18,79 @@ extern "C"
 
 namespace ZE
 {
+	namespace
+	{
+		// Items of one multi draw share scissor state
+		bool IsSameScissor(UIDrawItem* drawItem1, UIDrawItem* drawItem2)
+		{
+			if (drawItem1->hasScissor() != drawItem2->hasScissor()) { return false; }
+			if (!drawItem1->hasScissor()) { return true; }
+
+			const UIScissorRect rect1 = drawItem1->getScissorRect();
+			const UIScissorRect rect2 = drawItem2->getScissorRect();
+			return rect1.x == rect2.x && rect1.y == rect2.y && rect1.width == rect2.width && rect1.height == rect2.height;
+		}
+
+		// Per instance attributes 3 to 8 from bound array buffer, in format instances are uploaded in.
+		// Position, dimension and clip are scaled to pixels in shaders by instanceUnit of frame data.
+		void SetInstanceAttributes()
+		{
+			const GLsizei stride = sizeof(UIRenderInstance);
+
+#if defined(ZUI_USE_PACKED_INSTANCES)
+			// Position
+			glVertexAttribPointer(3, 2, GL_SHORT, GL_FALSE, stride, (GLvoid*)offsetof(UIPackedDrawInstance, pos));
+
+			// Dimension + Radius
+			glVertexAttribPointer(4, 4, GL_SHORT, GL_FALSE, stride, (GLvoid*)offsetof(UIPackedDrawInstance, dimension));
+
+			// Color
+			glVertexAttribPointer(5, 4, GL_UNSIGNED_BYTE, GL_TRUE, stride, (GLvoid*)offsetof(UIPackedDrawInstance, color));
+
+			// UV Coord + Dimension
+			glVertexAttribPointer(6, 4, GL_SHORT, GL_TRUE, stride, (GLvoid*)offsetof(UIPackedDrawInstance, uvDim));
+
+			// Crop Box
+			glVertexAttribPointer(7, 4, GL_SHORT, GL_FALSE, stride, (GLvoid*)offsetof(UIPackedDrawInstance, clip));
+#else
+			// Position
+			glVertexAttribPointer(3, 2, GL_FLOAT, GL_FALSE, stride, (GLvoid*)offsetof(UIDrawInstance, pos));
+
+			// Dimension + Radius
+			glVertexAttribPointer(4, 3, GL_FLOAT, GL_FALSE, stride, (GLvoid*)offsetof(UIDrawInstance, dimension));
+
+			// Color
+			glVertexAttribPointer(5, 4, GL_FLOAT, GL_FALSE, stride, (GLvoid*)offsetof(UIDrawInstance, color));
+
+			// UV Coord + Dimension
+			glVertexAttribPointer(6, 4, GL_FLOAT, GL_FALSE, stride, (GLvoid*)offsetof(UIDrawInstance, uvDim));
+
+			// Crop Box
+			glVertexAttribPointer(7, 4, GL_FLOAT, GL_FALSE, stride, (GLvoid*)offsetof(UIDrawInstance, clip));
+#endif
+
+			// Depth
+			glVertexAttribPointer(8, 1, GL_FLOAT, GL_FALSE, stride, (GLvoid*)offsetof(UIRenderInstance, depth));
+
+			for (GLuint location = 3; location <= 8; location++)
+			{
+				glEnableVertexAttribArray(location);
+				glVertexAttribDivisor(location, 1);
+			}
+		}
+
+		// Per instance insets, attribute 9 from bound array buffer. Left disabled, so instances without insets read constant zero.
+		void SetInstanceInsetsAttribute()
+		{
+#if defined(ZUI_USE_PACKED_INSTANCES)
+			glVertexAttribPointer(9, 4, GL_SHORT, GL_FALSE, sizeof(UIRenderInstanceInsets), (GLvoid*)0);
+#else
+			glVertexAttribPointer(9, 4, GL_FLOAT, GL_FALSE, sizeof(UIRenderInstanceInsets), (GLvoid*)0);
+#endif
+			glVertexAttribDivisor(9, 1);
+			glVertexAttrib4f(9, 0.0f, 0.0f, 0.0f, 0.0f);
+		}
+	}
 
 	GL_UIRenderer::~GL_UIRenderer()
 	{
@@ -66,6 +140,32 @@ namespace ZE
 		m_textShader = UINEW(Shader("Shaders/BaseTextShader.vs", "Shaders/BaseTextShader.frag"));
 		m_textInstanceShader = UINEW(Shader("Shaders/BaseTextShader_Instance.vs", "Shaders/BaseTextShader_Instance.frag"));
 
+		// Uniform blocks and sampler unit never change, set them once
+		Shader* shaders[6] = { m_drawShader, m_drawInstanceShader, m_drawTexShader, m_drawInstanceTexShader, m_textShader, m_textInstanceShader };
+		for (Shader* shader : shaders)
+		{
+			shader->bindUniformBlock("FrameData", 0);
+			shader->bindUniformBlock("DrawData", 1);
+			shader->Use();
+			shader->setInt("InTexture", 0);
+		}
+		glUseProgram(0);
+
+		// Uniform Buffers
+		GLint uniformAlignment = 256;
+		glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &uniformAlignment);
+		m_drawDataStride = ((sizeof(DrawData) + uniformAlignment - 1) / uniformAlignment) * uniformAlignment;
+
+		glGenBuffers(1, &UBO_frame);
+		glBindBuffer(GL_UNIFORM_BUFFER, UBO_frame);
+		glBufferData(GL_UNIFORM_BUFFER, 4 * sizeof(GLfloat), nullptr, GL_DYNAMIC_DRAW);
+		glBindBufferBase(GL_UNIFORM_BUFFER, 0, UBO_frame);
+
+		glGenBuffers(1, &UBO_draw);
+		glBindBuffer(GL_UNIFORM_BUFFER, 0);
+
+		initMultiDrawIndirect();
+
 		// Initialize Buffer
 		
 		// Rect Buffer
@@ -101,28 +201,13 @@ namespace ZE
 		// Instance Data
 		glGenBuffers(1, &VBO_instance);
 		glBindBuffer(GL_ARRAY_BUFFER, VBO_instance);
-		glBufferData(GL_ARRAY_BUFFER, maxInstanceDraw * sizeof(UIDrawInstance), nullptr, GL_DYNAMIC_DRAW);
-		
-		// Position
-		glVertexAttribPointer(3, 3, GL_FLOAT, GL_FALSE, sizeof(UIDrawInstance), (GLvoid*)0);
-		glEnableVertexAttribArray(3);
-
-		// Dimension + Radius
-		glVertexAttribPointer(4, 3, GL_FLOAT, GL_FALSE, sizeof(UIDrawInstance), (GLvoid*)(3 * sizeof(GLfloat)));
-		glEnableVertexAttribArray(4);
+		glBufferData(GL_ARRAY_BUFFER, maxInstanceDraw * sizeof(UIRenderInstance), nullptr, GL_DYNAMIC_DRAW);
+		SetInstanceAttributes();
 
-		// Color
-		glVertexAttribPointer(5, 4, GL_FLOAT, GL_FALSE, sizeof(UIDrawInstance), (GLvoid*)(6 * sizeof(GLfloat)));
-		glEnableVertexAttribArray(5);
-
-		// UV Coord + Dimension
-		glVertexAttribPointer(6, 4, GL_FLOAT, GL_FALSE, sizeof(UIDrawInstance), (GLvoid*)(10 * sizeof(GLfloat)));
-		glEnableVertexAttribArray(6);
-		
-		glVertexAttribDivisor(3, 1);
-		glVertexAttribDivisor(4, 1);
-		glVertexAttribDivisor(5, 1);
-		glVertexAttribDivisor(6, 1);
+		glGenBuffers(1, &VBO_instanceInsets);
+		glBindBuffer(GL_ARRAY_BUFFER, VBO_instanceInsets);
+		glBufferData(GL_ARRAY_BUFFER, maxInstanceInsetsDraw * sizeof(UIRenderInstanceInsets), nullptr, GL_DYNAMIC_DRAW);
+		SetInstanceInsetsAttribute();
 
 		glBindVertexArray(0);
 		glBindBuffer(GL_ARRAY_BUFFER, 0);
@@ -157,27 +242,7 @@ namespace ZE
 
 		// Instance Data
 		glBindBuffer(GL_ARRAY_BUFFER, VBO_instance);
-
-		// Position
-		glVertexAttribPointer(3, 3, GL_FLOAT, GL_FALSE, sizeof(UIDrawInstance), (GLvoid*)0);
-		glEnableVertexAttribArray(3);
-
-		// Dimension + Radius
-		glVertexAttribPointer(4, 3, GL_FLOAT, GL_FALSE, sizeof(UIDrawInstance), (GLvoid*)(3 * sizeof(GLfloat)));
-		glEnableVertexAttribArray(4);
-
-		// Color
-		glVertexAttribPointer(5, 4, GL_FLOAT, GL_FALSE, sizeof(UIDrawInstance), (GLvoid*)(6 * sizeof(GLfloat)));
-		glEnableVertexAttribArray(5);
-
-		// UV Coord + Dimension
-		glVertexAttribPointer(6, 4, GL_FLOAT, GL_FALSE, sizeof(UIDrawInstance), (GLvoid*)(10 * sizeof(GLfloat)));
-		glEnableVertexAttribArray(6);
-
-		glVertexAttribDivisor(3, 1);
-		glVertexAttribDivisor(4, 1);
-		glVertexAttribDivisor(5, 1);
-		glVertexAttribDivisor(6, 1);
+		SetInstanceAttributes();
 
 		glBindVertexArray(0);
 		glBindBuffer(GL_ARRAY_BUFFER, 0);
@@ -225,15 +290,41 @@ namespace ZE
 		glVertexAttribPointer(2, 4, GL_FLOAT, GL_FALSE, sizeof(UIVertex), (GLvoid*)(5 * sizeof(GLfloat)));
 		glEnableVertexAttribArray(2);		
 
+		// Quad Index Buffer : shared by draw and text vertex arrays
+		UIArray<UInt16> quadIndices(UI::QuadIndexBufferQuads * UI::QuadIndexCount);
+		UI::FillQuadIndices(quadIndices.data(), UI::QuadIndexBufferQuads);
+
+		// Element array binding is vertex array state, VAO_text is still bound here
+		glGenBuffers(1, &EBO_quad);
+		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO_quad);
+		glBufferData(GL_ELEMENT_ARRAY_BUFFER, quadIndices.size() * sizeof(UInt16), quadIndices.data(), GL_STATIC_DRAW);
+
+		glBindVertexArray(VAO_draw);
+		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO_quad);
+
 		glBindVertexArray(0);
 		glBindBuffer(GL_ARRAY_BUFFER, 0);
 
+		if (m_bMultiDrawIndirectSupported)
+		{
+			createIndirectVertexArray(VAO_indirectRect, VBO_rect);
+			createIndirectVertexArray(VAO_indirectRectText, VBO_rect_text);
+		}
+
 		glfwGetFramebufferSize(m_window, &width, &height);
 
-		glEnable(GL_DEPTH_TEST);
+		// Setup above bound objects behind the cache's back
+		m_state.invalidate();
+		m_state.activeTexture(GL_TEXTURE0);
+
+		m_state.setEnabled(GL_DEPTH_TEST, true);
+#if !defined(ZUI_GROUP_PER_TEXTURE)
+		// Sorted submission order already is draw order, float depth only separates items merged per texture
+		glDepthFunc(GL_ALWAYS);
+#endif
 		glEnable(GL_MULTISAMPLE);
-		glEnable(GL_BLEND);
-		glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+		m_state.setEnabled(GL_BLEND, true);
+		m_state.blendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 		glEnable(GL_CULL_FACE);
 		glFrontFace(GL_CCW);
 		
@@ -241,68 +332,425 @@ namespace ZE
 
 		m_width = width;
 		m_height = height;
+
+		updateFrameData();
+		createFrameBuffer(width, height);
 	}
 
 	void GL_UIRenderer::ProcessCurrentDrawList()
 	{
 		glfwPollEvents();
+		m_state.resetStats();
+		m_drawCalls = 0;
+		m_instanceBytes = 0;
+
+		// Cached panels used by this frame
+		processRenderTargets();
+
+		// Redraw only damaged area on top of previous frame kept in frame buffer
+		const bool bUseFrameBuffer = FBO_frame && m_bFrameBufferSupported;
+		const bool bPartial = bUseFrameBuffer && m_bFrameBufferValid && !m_drawList->isFullRedraw();
+
+		// Nothing changed on screen, front buffer still shows previous frame
+		if (bPartial && m_drawList->getDamageRect().m_dimension.x <= 0.0f)
+		{
+			m_issuedStateCalls = m_state.getIssuedCalls();
+			m_savedStateCalls = m_state.getSavedCalls();
+			m_lastDrawCalls = m_drawCalls;
+			m_lastInstanceBytes = m_instanceBytes;
+			return;
+		}
+
+		glBindFramebuffer(GL_FRAMEBUFFER, bUseFrameBuffer ? FBO_frame : 0);
 		glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+
+		if (bPartial)
+		{
+			const UIRect& damageRect = m_drawList->getDamageRect();
+			const GLint left = (GLint)damageRect.m_pos.x;
+			const GLint top = (GLint)damageRect.m_pos.y;
+			const GLint right = (GLint)ceilf(damageRect.m_pos.x + damageRect.m_dimension.x);
+			const GLint bottom = (GLint)ceilf(damageRect.m_pos.y + damageRect.m_dimension.y);
+
+			// GL window origin is bottom left
+			m_damageScissor[0] = left;
+			m_damageScissor[1] = m_height - bottom;
+			m_damageScissor[2] = right - left;
+			m_damageScissor[3] = bottom - top;
+			m_state.scissor(m_damageScissor[0], m_damageScissor[1], m_damageScissor[2], m_damageScissor[3]);
+		}
+		m_state.setEnabled(GL_SCISSOR_TEST, bPartial);
+		m_bDamageScissor = bPartial;
+
 		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT | GL_STENCIL_BUFFER_BIT);
 
-		UIArray<UIDrawItem*> secondPass;
-		for (int i = 0; i < m_drawList->itemCount(); i++)
+		processDrawList(m_drawList, bPartial);
+
+		if (bUseFrameBuffer)
 		{
-			UIDrawItem* drawItem = m_drawList->getDrawItem(i);
-			if (drawItem->getLayer() > 0)
+			blitFrameBuffer();
+		}
+
+		glfwSwapBuffers(m_window);
+		maskCount = 0;
+
+		m_issuedStateCalls = m_state.getIssuedCalls();
+		m_savedStateCalls = m_state.getSavedCalls();
+		m_lastDrawCalls = m_drawCalls;
+		m_lastInstanceBytes = m_instanceBytes;
+	}
+
+	void GL_UIRenderer::processDrawList(UIDrawList* drawList, bool bPartial)
+	{
+		// Draw list is already in submission order
+		UIArray<UIDrawItem*>& drawItems = m_drawItemsToProcess;
+		drawItems.clear();
+		for (int i = 0; i < drawList->itemCount(); i++)
+		{
+			UIDrawItem* drawItem = drawList->getSortedDrawItem(i);
+			if (bPartial && !drawList->needsRedraw(drawItem))
 			{
-				secondPass.push_back(drawItem);
 				continue;
 			}
-			processDrawItem(drawItem);
+			drawItems.push_back(drawItem);
 		}
 
-		for (unsigned int i = 0; i < secondPass.size(); i++)
+		if (drawItems.size() == 0)
 		{
-			UIDrawItem* drawItem = secondPass[i];
-			processDrawItem(drawItem);
+			return;
+		}
+
+		uploadDrawData(drawItems);
+
+		if (m_bMultiDrawIndirect)
+		{
+			processDrawItemsIndirect(drawItems);
+			return;
+		}
+
+		// Neighbouring instanced items of same texture and clip state go in one instanced draw, crop box is per instance
+		for (unsigned int i = 0; i < drawItems.size();)
+		{
+			unsigned int runEnd = i + 1;
+			while (runEnd < drawItems.size() && canDrawInstancesTogether(drawItems[i], drawItems[runEnd]))
+			{
+				runEnd++;
+			}
+
+			if (runEnd - i == 1)
+			{
+				processDrawItem(drawItems[i], i, drawItems[i]->getInstances(), drawItems[i]->getInstanceInsets());
+			}
+			else
+			{
+				bool bRunInsets = false;
+				for (unsigned int j = i; j < runEnd; j++)
+				{
+					bRunInsets |= drawItems[j]->hasInstanceInsets();
+				}
+
+				m_runInstances.clear();
+				m_runInstanceInsets.clear();
+				for (unsigned int j = i; j < runEnd; j++)
+				{
+					const UIArray<UIDrawInstance>& instances = drawItems[j]->getInstances();
+					m_runInstances.insert(m_runInstances.end(), instances.begin(), instances.end());
+					if (bRunInsets)
+					{
+						// Keep insets aligned with instances, items without insets get zero
+						const UIArray<UIInstanceInsets>& instanceInsets = drawItems[j]->getInstanceInsets();
+						m_runInstanceInsets.insert(m_runInstanceInsets.end(), instanceInsets.begin(), instanceInsets.end());
+						m_runInstanceInsets.resize(m_runInstances.size());
+					}
+				}
+				processDrawItem(drawItems[i], i, m_runInstances, m_runInstanceInsets);
+			}
+			i = runEnd;
 		}
-		
-		glfwSwapBuffers(m_window);
-		maskCount = 0;
 	}
 
-	void GL_UIRenderer::processDrawItem(UIDrawItem* drawItem)
+	bool GL_UIRenderer::canDrawInstancesTogether(UIDrawItem* drawItem1, UIDrawItem* drawItem2)
 	{
-		bool isFont = drawItem->getTextureHandle() && drawItem->isFont();
-		bool isUsingRect = drawItem->isUsingRectInstance();
-		bool isInstance = isUsingRect;
-		GLuint VAO = isUsingRect ? VAO_rect : VAO_draw;
+		if (!drawItem1->isUsingRectInstance() || !drawItem2->isUsingRectInstance() || drawItem1->isDrawMask() || drawItem2->isDrawMask())
+		{
+			return false;
+		}
 
-		if (drawItem->isDrawMask())
+		const UInt32 textureHandle = drawItem1->getTextureHandle();
+		if (textureHandle != drawItem2->getTextureHandle() || drawItem1->isFont() != drawItem2->isFont())
 		{
-			if (drawItem->getDrawMask() == DRAW_MASK_PUSH)
+			return false;
+		}
+
+		// Render targets flip their UVs per item
+		if (textureHandle > 0 && HashMapHas(m_renderTargets, textureHandle))
+		{
+			return false;
+		}
+
+		return IsSameScissor(drawItem1, drawItem2);
+	}
+
+	void GL_UIRenderer::updateFrameData()
+	{
+		GLfloat frameData[4] = { (GLfloat)m_width, (GLfloat)m_height, UI::GetRenderInstanceUnit(), 0.0f };
+		m_state.bindUniformBuffer(UBO_frame);
+		glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(frameData), frameData);
+	}
+
+	void GL_UIRenderer::uploadDrawData(const UIArray<UIDrawItem*>& drawItems)
+	{
+		// One upload per draw list, each item then only binds its range
+		const GLsizeiptr size = drawItems.size() * m_drawDataStride;
+		if ((GLsizeiptr)m_drawDataStaging.size() < size)
+		{
+			m_drawDataStaging.resize(size);
+		}
+
+		for (unsigned int i = 0; i < drawItems.size(); i++)
+		{
+			UIDrawItem* drawItem = drawItems[i];
+			DrawData& drawData = *(DrawData*)(m_drawDataStaging.data() + i * m_drawDataStride);
+			const UIVector4& cropBox = drawItem->getCropDimension();
+			const UIVector2& dimension = drawItem->getDimension();
+			drawData.cropBox[0] = cropBox.x;
+			drawData.cropBox[1] = cropBox.y;
+			drawData.cropBox[2] = cropBox.z;
+			drawData.cropBox[3] = cropBox.w;
+			drawData.shapeDimension[0] = dimension.x;
+			drawData.shapeDimension[1] = dimension.y;
+			drawData.roundness = drawItem->getRoundness();
+			drawData.bCrop = drawItem->isCrop() ? 1 : 0;
+		}
+
+		m_state.bindUniformBuffer(UBO_draw);
+		if (size > m_drawDataSize)
+		{
+			m_drawDataSize = size;
+		}
+
+		// Orphan previous storage so driver doesn't wait on draws still reading it
+		glBufferData(GL_UNIFORM_BUFFER, m_drawDataSize, nullptr, GL_STREAM_DRAW);
+		glBufferSubData(GL_UNIFORM_BUFFER, 0, size, m_drawDataStaging.data());
+	}
+
+	void GL_UIRenderer::processRenderTargets()
+	{
+		if (m_renderTargetRequests.size() == 0)
+		{
+			return;
+		}
+
+		// Keep premultiplied alpha in target so it blends the same when composited
+		m_state.blendFuncSeparate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+		glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
+		m_bDamageScissor = false;
+
+		for (const RenderTargetRequest& request : m_renderTargetRequests)
+		{
+			auto iter = m_renderTargets.find(request.textureHandle);
+			if (iter == m_renderTargets.end())
 			{
-				pushMask();
-				glStencilFunc(GL_ALWAYS, maskCount, 0xFF);
-				glStencilMask(0xFF);
-				glDisable(GL_DEPTH_TEST);
-				glStencilOp(GL_KEEP, GL_KEEP, GL_INCR);
+				continue;
 			}
-			else
+
+			const RenderTarget& renderTarget = iter->second;
+			glBindFramebuffer(GL_FRAMEBUFFER, renderTarget.FBO);
+
+			// Screen sized viewport shifted so target rect lands on target origin
+			m_scissorOffset[0] = -(GLint)request.rect.m_pos.x;
+			m_scissorOffset[1] = (GLint)(request.rect.m_pos.y + renderTarget.height) - m_height;
+			glViewport(m_scissorOffset[0], m_scissorOffset[1], m_width, m_height);
+			m_state.setEnabled(GL_SCISSOR_TEST, false);
+			glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT | GL_STENCIL_BUFFER_BIT);
+
+			processDrawList(request.drawList, false);
+			maskCount = 0;
+		}
+		m_renderTargetRequests.clear();
+
+		glBindFramebuffer(GL_FRAMEBUFFER, 0);
+		glViewport(0, 0, m_width, m_height);
+		m_scissorOffset[0] = m_scissorOffset[1] = 0;
+		m_state.blendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+	}
+
+	ZE::UInt32 GL_UIRenderer::createRenderTarget(UInt32 width, UInt32 height)
+	{
+		RenderTarget renderTarget;
+		renderTarget.width = width;
+		renderTarget.height = height;
+
+		GLuint textureHandle;
+		glGenTextures(1, &textureHandle);
+		m_state.bindTexture(textureHandle);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+		glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+		m_state.bindTexture(0);
+
+		glGenRenderbuffers(1, &renderTarget.RBO_depthStencil);
+		glBindRenderbuffer(GL_RENDERBUFFER, renderTarget.RBO_depthStencil);
+		glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, width, height);
+		glBindRenderbuffer(GL_RENDERBUFFER, 0);
+
+		glGenFramebuffers(1, &renderTarget.FBO);
+		glBindFramebuffer(GL_FRAMEBUFFER, renderTarget.FBO);
+		glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, textureHandle, 0);
+		glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, renderTarget.RBO_depthStencil);
+		const bool bComplete = glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+		glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+		if (!bComplete)
+		{
+			glDeleteFramebuffers(1, &renderTarget.FBO);
+			glDeleteRenderbuffers(1, &renderTarget.RBO_depthStencil);
+			glDeleteTextures(1, &textureHandle);
+			m_state.onTextureDeleted(textureHandle);
+			return 0;
+		}
+
+		m_renderTargets[textureHandle] = renderTarget;
+		return textureHandle;
+	}
+
+	void GL_UIRenderer::destroyRenderTarget(UInt32 textureHandle)
+	{
+		auto iter = m_renderTargets.find(textureHandle);
+		if (iter == m_renderTargets.end())
+		{
+			return;
+		}
+
+		glDeleteFramebuffers(1, &iter->second.FBO);
+		glDeleteRenderbuffers(1, &iter->second.RBO_depthStencil);
+		glDeleteTextures(1, &textureHandle);
+		m_state.onTextureDeleted(textureHandle);
+		m_renderTargets.erase(iter);
+
+		for (size_t i = 0; i < m_renderTargetRequests.size(); i++)
+		{
+			if (m_renderTargetRequests[i].textureHandle == textureHandle)
 			{
-				glStencilFunc(GL_ALWAYS, maskCount, 0xFF);
-				glStencilMask(0xFF);
-				glDisable(GL_DEPTH_TEST);
-				glStencilOp(GL_KEEP, GL_KEEP, GL_DECR);
+				m_renderTargetRequests.erase(m_renderTargetRequests.begin() + i);
+				break;
 			}
 		}
-		else if (maskCount)
+	}
+
+	void GL_UIRenderer::renderToTarget(UInt32 textureHandle, UIDrawList* drawList, const UIRect& rect)
+	{
+		for (RenderTargetRequest& request : m_renderTargetRequests)
+		{
+			if (request.textureHandle == textureHandle)
+			{
+				request.drawList = drawList;
+				request.rect = rect;
+				return;
+			}
+		}
+
+		m_renderTargetRequests.push_back({ textureHandle, drawList, rect });
+	}
+
+	void GL_UIRenderer::createFrameBuffer(int width, int height)
+	{
+		destroyFrameBuffer();
+		if (!m_bFrameBufferSupported || width <= 0 || height <= 0)
+		{
+			return;
+		}
+
+		// Match window sample count so frame buffer can be blitted to it directly
+		GLint samples = 0;
+		glGetIntegerv(GL_SAMPLES, &samples);
+
+		glGenRenderbuffers(1, &RBO_frameColor);
+		glBindRenderbuffer(GL_RENDERBUFFER, RBO_frameColor);
+		glRenderbufferStorageMultisample(GL_RENDERBUFFER, samples, GL_RGBA8, width, height);
+
+		glGenRenderbuffers(1, &RBO_frameDepthStencil);
+		glBindRenderbuffer(GL_RENDERBUFFER, RBO_frameDepthStencil);
+		glRenderbufferStorageMultisample(GL_RENDERBUFFER, samples, GL_DEPTH24_STENCIL8, width, height);
+		glBindRenderbuffer(GL_RENDERBUFFER, 0);
+
+		glGenFramebuffers(1, &FBO_frame);
+		glBindFramebuffer(GL_FRAMEBUFFER, FBO_frame);
+		glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, RBO_frameColor);
+		glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, RBO_frameDepthStencil);
+
+		if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
 		{
-			glStencilFunc(GL_EQUAL, maskCount, 0xFF);
-			glStencilMask(0x00);
-			glEnable(GL_DEPTH_TEST);
+			std::cout << "Frame buffer incomplete, partial redraw disabled" << std::endl;
+			m_bFrameBufferSupported = false;
+			glBindFramebuffer(GL_FRAMEBUFFER, 0);
+			destroyFrameBuffer();
+			return;
 		}
 
+		glBindFramebuffer(GL_FRAMEBUFFER, 0);
+	}
+
+	void GL_UIRenderer::blitFrameBuffer()
+	{
+		// Window format only changes with frame buffer, so first blit after creation is the only one checked
+		const bool bCheckBlit = !m_bFrameBufferBlitChecked;
+		if (bCheckBlit)
+		{
+			for (GLenum error = glGetError(); error != GL_NO_ERROR; error = glGetError())
+			{
+				std::cout << "GL error before frame buffer blit: " << error << std::endl;
+			}
+		}
+
+		m_state.setEnabled(GL_SCISSOR_TEST, false);
+		glBindFramebuffer(GL_READ_FRAMEBUFFER, FBO_frame);
+		glBindFramebuffer(GL_DRAW_FRAMEBUFFER, 0);
+		glBlitFramebuffer(0, 0, m_width, m_height, 0, 0, m_width, m_height, GL_COLOR_BUFFER_BIT, GL_NEAREST);
+		glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+		if (bCheckBlit)
+		{
+			m_bFrameBufferBlitChecked = true;
+			if (glGetError() == GL_INVALID_OPERATION)
+			{
+				// Window buffer doesn't match frame buffer format, go back to drawing straight to window
+				m_bFrameBufferSupported = false;
+				destroyFrameBuffer();
+				UI::RequestRedraw();
+				return;
+			}
+		}
+
+		m_bFrameBufferValid = true;
+	}
+
+	void GL_UIRenderer::destroyFrameBuffer()
+	{
+		if (FBO_frame)
+		{
+			glDeleteFramebuffers(1, &FBO_frame);
+			glDeleteRenderbuffers(1, &RBO_frameColor);
+			glDeleteRenderbuffers(1, &RBO_frameDepthStencil);
+			FBO_frame = RBO_frameColor = RBO_frameDepthStencil = 0;
+		}
+		m_bFrameBufferValid = false;
+		m_bFrameBufferBlitChecked = false;
+	}
+
+	void GL_UIRenderer::processDrawItem(UIDrawItem* drawItem, UInt32 drawIndex, const UIArray<UIDrawInstance>& instances, const UIArray<UIInstanceInsets>& instanceInsets)
+	{
+		bool isFont = drawItem->getTextureHandle() && drawItem->isFont();
+		bool isUsingRect = drawItem->isUsingRectInstance();
+		bool isInstance = isUsingRect;
+		GLuint VAO = isUsingRect ? VAO_rect : VAO_draw;
+		bool isRenderTarget = drawItem->getTextureHandle() > 0 && HashMapHas(m_renderTargets, drawItem->getTextureHandle());
+
+		applyDrawMaskState(drawItem);
+		applyScissorState(drawItem);
+
 		Shader* shader = m_drawShader;
 		if (drawItem->getTextureHandle() > 0)
 		{
@@ -310,76 +758,392 @@ namespace ZE
 			{
 				VAO = isUsingRect ? VAO_rect_text : VAO_text;
 				shader = isUsingRect ? m_textInstanceShader : m_textShader;
-				shader->Use();
 			}
 			else
 			{
 				shader = isUsingRect ? m_drawInstanceTexShader : m_drawTexShader;
-				shader->Use();
 			}
-			shader->setInt("InTexture", 0);
-			glBindTexture(GL_TEXTURE_2D, drawItem->getTextureHandle());
-			glActiveTexture(GL_TEXTURE0);
+			m_state.bindTexture(drawItem->getTextureHandle());
 		}
 		else if (isUsingRect)
 		{
 			VAO = VAO_rect;
 			shader = m_drawInstanceShader;
-			shader->Use();
+		}
+		m_state.useProgram(shader->Program);
+
+		// Roundness, shape dimension and crop box come from this item's DrawData range
+		m_state.bindUniformBufferRange(1, UBO_draw, drawIndex * m_drawDataStride, sizeof(DrawData));
+
+		if (isRenderTarget)
+		{
+			// Render target is premultiplied and stored bottom row first
+			m_state.blendFunc(GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+
+			m_flippedVertices.assign(drawItem->getVertices().begin(), drawItem->getVertices().end());
+			for (UIVertex& vertex : m_flippedVertices)
+			{
+				vertex.texCoord.y = 1.0f - vertex.texCoord.y;
+			}
+
+			m_flippedInstances.assign(instances.begin(), instances.end());
+			for (UIDrawInstance& instance : m_flippedInstances)
+			{
+				instance.uvDim.y = 1.0f - instance.uvDim.y;
+				instance.uvDim.w = -instance.uvDim.w;
+			}
+
+			if (m_flippedVertices.size() > 0) { setDrawData(m_flippedVertices); }
+			if (m_flippedInstances.size() > 0) { setInstanceDrawData(m_flippedInstances); }
 		}
 		else
 		{
-			shader->Use();
-			shader->setFloat("roundness", drawItem->getRoundness());
-			shader->setVec2("shapeDimension", drawItem->getDimension());
+			if (drawItem->getVertices().size() > 0)
+			{
+				if (isFont)
+				{
+					setTextData(drawItem->getVertices());
+				}
+				else
+				{
+					setDrawData(drawItem->getVertices());
+				}
+			}
+
+			if (instances.size() > 0)
+			{
+				setInstanceDrawData(instances);
+			}
 		}
 
-		shader->setVec2("screenDimension", UIVector2{ (Float32)m_width, (Float32)m_height });
+		m_state.bindVertexArray(VAO);
+		if (!isInstance)
+		{
+			drawQuads(drawItem->getVertices().size());
+		}
+		else
+		{
+			// Insets are a separate stream, only uploaded and enabled for items that have them
+			const bool bInsets = instanceInsets.size() > 0;
+			if (bInsets)
+			{
+				setInstanceInsetsData(instanceInsets, instances.size());
+				glEnableVertexAttribArray(9);
+			}
 
-		shader->setBool("bCrop", drawItem->isCrop());
+			// Draw Instances
+			glDrawArraysInstanced(GL_TRIANGLES, 0, 6, instances.size());
 
-		if (drawItem->isCrop())
+			if (bInsets)
+			{
+				glDisableVertexAttribArray(9);
+			}
+		}
+		m_drawCalls++;
+
+		if (isRenderTarget)
 		{
-			shader->setVec4("CropBox", drawItem->getCropDimension());
+			m_state.blendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 		}
 
-		if (drawItem->getVertices().size() > 0)
+		if (drawItem->isDrawMask())
 		{
-			if (isFont)
+			if (drawItem->getDrawMask() == DRAW_MASK_POP)
 			{
-				setTextData(drawItem->getVertices());
+				popMask();
+			}
+		}
+	}
+
+	void GL_UIRenderer::applyDrawMaskState(UIDrawItem* drawItem)
+	{
+		if (drawItem->isDrawMask())
+		{
+			if (drawItem->getDrawMask() == DRAW_MASK_PUSH)
+			{
+				pushMask();
+				m_state.stencilFunc(GL_ALWAYS, maskCount, 0xFF);
+				m_state.stencilMask(0xFF);
+				m_state.setEnabled(GL_DEPTH_TEST, false);
+				m_state.stencilOp(GL_KEEP, GL_KEEP, GL_INCR);
 			}
 			else
 			{
-				setDrawData(drawItem->getVertices());
+				m_state.stencilFunc(GL_ALWAYS, maskCount, 0xFF);
+				m_state.stencilMask(0xFF);
+				m_state.setEnabled(GL_DEPTH_TEST, false);
+				m_state.stencilOp(GL_KEEP, GL_KEEP, GL_DECR);
 			}
 		}
+		else if (maskCount)
+		{
+			m_state.stencilFunc(GL_EQUAL, maskCount, 0xFF);
+			m_state.stencilMask(0x00);
+			m_state.setEnabled(GL_DEPTH_TEST, true);
+		}
+	}
 
-		if (drawItem->getInstances().size() > 0)
+	void GL_UIRenderer::applyScissorState(UIDrawItem* drawItem)
+	{
+		if (!drawItem->hasScissor())
 		{
-			setInstanceDrawData(drawItem->getInstances());
+			if (m_bDamageScissor)
+			{
+				m_state.scissor(m_damageScissor[0], m_damageScissor[1], m_damageScissor[2], m_damageScissor[3]);
+			}
+			m_state.setEnabled(GL_SCISSOR_TEST, m_bDamageScissor);
+			return;
 		}
 
-		if (!isInstance)
+		const UIScissorRect scissorRect = drawItem->getScissorRect();
+		GLint left = scissorRect.x + m_scissorOffset[0];
+		GLint bottom = m_height - (scissorRect.y + scissorRect.height) + m_scissorOffset[1];
+		GLint right = left + scissorRect.width;
+		GLint top = bottom + scissorRect.height;
+
+		if (m_bDamageScissor)
 		{
-			glBindVertexArray(VAO);
-			glDrawArrays(GL_TRIANGLES, 0, drawItem->getVertices().size());
-			glBindVertexArray(0);
+			const GLint damageRight = m_damageScissor[0] + m_damageScissor[2];
+			const GLint damageTop = m_damageScissor[1] + m_damageScissor[3];
+			left = left > m_damageScissor[0] ? left : m_damageScissor[0];
+			bottom = bottom > m_damageScissor[1] ? bottom : m_damageScissor[1];
+			right = right < damageRight ? right : damageRight;
+			top = top < damageTop ? top : damageTop;
 		}
-		else
+
+		const GLsizei width = right > left ? right - left : 0;
+		const GLsizei height = top > bottom ? top - bottom : 0;
+		m_state.scissor(left, bottom, width, height);
+		m_state.setEnabled(GL_SCISSOR_TEST, true);
+	}
+
+	void GL_UIRenderer::initMultiDrawIndirect()
+	{
+		// Indirect shaders are GLSL 4.30 and read gl_DrawIDARB, otherwise stay on per item draws
+		if (!GLEW_VERSION_4_3 || !GLEW_ARB_shader_draw_parameters)
 		{
-			// Draw Instances
-			glBindVertexArray(VAO);
-			glDrawArraysInstanced(GL_TRIANGLES, 0, 6, drawItem->getInstances().size());
-			glBindVertexArray(0);
+			return;
 		}
 
-		if (drawItem->isDrawMask())
+		m_drawIndirectShader = UINEW(Shader("Shaders/BaseShapeShader_Indirect.vs", "Shaders/BaseShapeShader_Color_Instance.frag"));
+		m_drawIndirectTexShader = UINEW(Shader("Shaders/BaseShapeShader_Indirect.vs", "Shaders/BaseShapeShader_Texture_Indirect.frag"));
+		m_textIndirectShader = UINEW(Shader("Shaders/BaseTextShader_Indirect.vs", "Shaders/BaseTextShader_Indirect.frag"));
+
+		Shader* shaders[3] = { m_drawIndirectShader, m_drawIndirectTexShader, m_textIndirectShader };
+		for (Shader* shader : shaders)
 		{
-			if (drawItem->getDrawMask() == DRAW_MASK_POP)
+			if (!shader->isLinked())
 			{
-				popMask();
+				UIFREE(m_drawIndirectShader);
+				UIFREE(m_drawIndirectTexShader);
+				UIFREE(m_textIndirectShader);
+				m_drawIndirectShader = m_drawIndirectTexShader = m_textIndirectShader = nullptr;
+				return;
+			}
+		}
+
+		GLint textureUnits[MaxIndirectTextures];
+		for (UInt32 i = 0; i < MaxIndirectTextures; i++)
+		{
+			textureUnits[i] = i;
+		}
+
+		for (Shader* shader : shaders)
+		{
+			shader->bindUniformBlock("FrameData", 0);
+			shader->Use();
+			glUniform1iv(shader->getUniformPosition("InTextures"), MaxIndirectTextures, textureUnits);
+		}
+		glUseProgram(0);
+
+		m_drawIndirectBaseLocation = m_drawIndirectShader->getUniformPosition("drawBase");
+		m_drawIndirectTexBaseLocation = m_drawIndirectTexShader->getUniformPosition("drawBase");
+		m_textIndirectBaseLocation = m_textIndirectShader->getUniformPosition("drawBase");
+
+		glGenBuffers(1, &VBO_indirectInstance);
+		glGenBuffers(1, &DIB_commands);
+		glGenBuffers(1, &SSBO_drawParams);
+
+		// Only indirect path binds these targets, bound once for good
+		glBindBuffer(GL_DRAW_INDIRECT_BUFFER, DIB_commands);
+		glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, SSBO_drawParams);
+
+		m_bMultiDrawIndirectSupported = true;
+		m_bMultiDrawIndirect = true;
+	}
+
+	void GL_UIRenderer::createIndirectVertexArray(GLuint& VAO, GLuint quadBuffer)
+	{
+		glGenVertexArrays(1, &VAO);
+		glBindVertexArray(VAO);
+
+		// Quad
+		glBindBuffer(GL_ARRAY_BUFFER, quadBuffer);
+		glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(UIVertex), (GLvoid*)(0 * sizeof(GLfloat)));
+		glEnableVertexAttribArray(0);
+		glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, sizeof(UIVertex), (GLvoid*)(3 * sizeof(GLfloat)));
+		glEnableVertexAttribArray(1);
+		glVertexAttribPointer(2, 4, GL_FLOAT, GL_FALSE, sizeof(UIVertex), (GLvoid*)(5 * sizeof(GLfloat)));
+		glEnableVertexAttribArray(2);
+
+		// Instances of whole frame, draw command base instance picks item's range
+		glBindBuffer(GL_ARRAY_BUFFER, VBO_indirectInstance);
+		SetInstanceAttributes();
+
+		glBindVertexArray(0);
+		glBindBuffer(GL_ARRAY_BUFFER, 0);
+	}
+
+	Shader* GL_UIRenderer::getIndirectShader(UIDrawItem* drawItem, GLuint& VAO, GLint& drawBaseLocation)
+	{
+		if (drawItem->isDrawMask() || !drawItem->isUsingRectInstance() || drawItem->getInstances().size() == 0)
+		{
+			return nullptr;
+		}
+
+		// Nine slice and bordered rects need the insets stream of instance shaders
+		if (drawItem->hasInstanceInsets())
+		{
+			return nullptr;
+		}
+
+		const UInt32 textureHandle = drawItem->getTextureHandle();
+		if (textureHandle == 0)
+		{
+			VAO = VAO_indirectRect;
+			drawBaseLocation = m_drawIndirectBaseLocation;
+			return m_drawIndirectShader;
+		}
+
+		// Render targets need flipped UVs and premultiplied blending
+		if (HashMapHas(m_renderTargets, textureHandle))
+		{
+			return nullptr;
+		}
+
+		if (drawItem->isFont())
+		{
+			VAO = VAO_indirectRectText;
+			drawBaseLocation = m_textIndirectBaseLocation;
+			return m_textIndirectShader;
+		}
+
+		VAO = VAO_indirectRect;
+		drawBaseLocation = m_drawIndirectTexBaseLocation;
+		return m_drawIndirectTexShader;
+	}
+
+	void GL_UIRenderer::processDrawItemsIndirect(const UIArray<UIDrawItem*>& drawItems)
+	{
+		m_indirectInstances.clear();
+		m_indirectCommands.clear();
+		m_indirectParams.clear();
+		m_indirectBatches.clear();
+
+		// Group consecutive items of one shader into batches, submission order stays the same
+		for (UInt32 i = 0; i < drawItems.size(); i++)
+		{
+			UIDrawItem* drawItem = drawItems[i];
+			GLuint VAO = 0;
+			GLint drawBaseLocation = -1;
+			Shader* shader = getIndirectShader(drawItem, VAO, drawBaseLocation);
+			if (!shader)
+			{
+				IndirectBatch batch;
+				batch.shader = nullptr;
+				batch.drawIndex = i;
+				m_indirectBatches.push_back(batch);
+				continue;
 			}
+
+			const UInt32 textureHandle = drawItem->getTextureHandle();
+			bool bNewBatch = m_indirectBatches.size() == 0 || m_indirectBatches.back().shader != shader
+				|| !IsSameScissor(drawItem, drawItems[m_indirectBatches.back().drawIndex]);
+			Int32 textureSlot = -1;
+			if (!bNewBatch && textureHandle > 0)
+			{
+				const IndirectBatch& batch = m_indirectBatches.back();
+				for (UInt32 slot = 0; slot < batch.textureCount; slot++)
+				{
+					if (batch.textures[slot] == textureHandle)
+					{
+						textureSlot = slot;
+						break;
+					}
+				}
+				bNewBatch = textureSlot < 0 && batch.textureCount == MaxIndirectTextures;
+			}
+
+			if (bNewBatch)
+			{
+				IndirectBatch batch;
+				batch.shader = shader;
+				batch.VAO = VAO;
+				batch.drawBaseLocation = drawBaseLocation;
+				batch.drawIndex = i;
+				batch.firstCommand = (UInt32)m_indirectCommands.size();
+				batch.commandCount = 0;
+				batch.textureCount = 0;
+				m_indirectBatches.push_back(batch);
+			}
+
+			IndirectBatch& batch = m_indirectBatches.back();
+			if (textureHandle > 0 && textureSlot < 0)
+			{
+				textureSlot = batch.textureCount;
+				batch.textures[batch.textureCount++] = textureHandle;
+			}
+
+			const UIArray<UIDrawInstance>& instances = drawItem->getInstances();
+			IndirectDrawCommand command;
+			command.count = 6;
+			command.instanceCount = (GLuint)instances.size();
+			command.first = 0;
+			command.baseInstance = (GLuint)m_indirectInstances.size();
+			m_indirectCommands.push_back(command);
+
+			IndirectDrawParams params;
+			params.textureSlot = textureSlot < 0 ? 0 : textureSlot;
+			m_indirectParams.push_back(params);
+
+			m_indirectInstances.insert(m_indirectInstances.end(), instances.begin(), instances.end());
+			batch.commandCount++;
+		}
+
+		// Whole frame goes up in three uploads
+		if (m_indirectCommands.size() > 0)
+		{
+			m_state.bindArrayBuffer(VBO_indirectInstance);
+			const GLsizeiptr instanceBytes = m_indirectInstances.size() * sizeof(UIRenderInstance);
+			glBufferData(GL_ARRAY_BUFFER, instanceBytes, UI::GetRenderInstances(m_indirectInstances, m_instancePackBuffer), GL_STREAM_DRAW);
+			m_instanceBytes += (UInt32)instanceBytes;
+			glBufferData(GL_DRAW_INDIRECT_BUFFER, m_indirectCommands.size() * sizeof(IndirectDrawCommand), m_indirectCommands.data(), GL_STREAM_DRAW);
+			glBufferData(GL_SHADER_STORAGE_BUFFER, m_indirectParams.size() * sizeof(IndirectDrawParams), m_indirectParams.data(), GL_STREAM_DRAW);
+		}
+
+		for (const IndirectBatch& batch : m_indirectBatches)
+		{
+			if (!batch.shader)
+			{
+				processDrawItem(drawItems[batch.drawIndex], batch.drawIndex, drawItems[batch.drawIndex]->getInstances(), drawItems[batch.drawIndex]->getInstanceInsets());
+				continue;
+			}
+
+			applyDrawMaskState(drawItems[batch.drawIndex]);
+			applyScissorState(drawItems[batch.drawIndex]);
+			m_state.useProgram(batch.shader->Program);
+			batch.shader->setInt(batch.drawBaseLocation, batch.firstCommand);
+
+			for (UInt32 slot = 0; slot < batch.textureCount; slot++)
+			{
+				m_state.activeTexture(GL_TEXTURE0 + slot);
+				m_state.bindTexture(batch.textures[slot]);
+			}
+			m_state.activeTexture(GL_TEXTURE0);
+
+			m_state.bindVertexArray(batch.VAO);
+			glMultiDrawArraysIndirect(GL_TRIANGLES, (const void*)(batch.firstCommand * sizeof(IndirectDrawCommand)), batch.commandCount, 0);
+			m_drawCalls++;
 		}
 	}
 
@@ -388,7 +1152,7 @@ namespace ZE
 		maskCount++;
 		if (maskCount == 1)
 		{
-			glEnable(GL_STENCIL_TEST);
+			m_state.setEnabled(GL_STENCIL_TEST, true);
 		}
 	}
 
@@ -398,7 +1162,7 @@ namespace ZE
 		maskCount--;
 		if (maskCount == 0)
 		{
-			glDisable(GL_STENCIL_TEST);
+			m_state.setEnabled(GL_STENCIL_TEST, false);
 		}
 	}
 
@@ -412,16 +1176,34 @@ namespace ZE
 		UIFREE(m_textShader);
 		UIFREE(m_textInstanceShader);
 
+		if (m_bMultiDrawIndirectSupported)
+		{
+			UIFREE(m_drawIndirectShader);
+			UIFREE(m_drawIndirectTexShader);
+			UIFREE(m_textIndirectShader);
+			glDeleteVertexArrays(1, &VAO_indirectRect);
+			glDeleteVertexArrays(1, &VAO_indirectRectText);
+			glDeleteBuffers(1, &VBO_indirectInstance);
+			glDeleteBuffers(1, &DIB_commands);
+			glDeleteBuffers(1, &SSBO_drawParams);
+		}
+
+		glDeleteBuffers(1, &UBO_frame);
+		glDeleteBuffers(1, &UBO_draw);
+
 		glDeleteVertexArrays(1, &VAO_draw);
 		glDeleteBuffers(1, &VBO_draw);
 		glDeleteVertexArrays(1, &VAO_text);
 		glDeleteBuffers(1, &VBO_text);
+		glDeleteBuffers(1, &EBO_quad);
 		glDeleteVertexArrays(1, &VAO_rect);
 		glDeleteBuffers(1, &VBO_rect);
 		glDeleteVertexArrays(1, &VAO_rect_text);
 		glDeleteBuffers(1, &VBO_rect_text);
 		glDeleteBuffers(1, &VBO_instance);
+		glDeleteBuffers(1, &VBO_instanceInsets);
 
+		destroyFrameBuffer();
 
 		glfwTerminate();
 	}
@@ -437,7 +1219,7 @@ namespace ZE
 
 		glGenTextures(1, &textureHandle);
 
-		glBindTexture(GL_TEXTURE_2D, textureHandle);
+		m_state.bindTexture(textureHandle);
 
 		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_MIRRORED_REPEAT);
 		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_MIRRORED_REPEAT);
@@ -449,17 +1231,31 @@ namespace ZE
 		glTexImage2D(GL_TEXTURE_2D, 0, imageFormat, width, height, 0, imageFormat, GL_UNSIGNED_BYTE, pAddress);
 
 		glGenerateMipmap(GL_TEXTURE_2D);
-		glBindTexture(GL_TEXTURE_2D, 0);
+		m_state.bindTexture(0);
 
 		return textureHandle;
 	}
 
+	bool GL_UIRenderer::updateRendererTexture(UInt32 textureHandle, void* pAddress, UInt32 x, UInt32 y, UInt32 width, UInt32 height, UInt32 channelCount)
+	{
+		m_state.bindTexture(textureHandle);
+
+		GLenum imageFormat = channelCount == 4 ? GL_RGBA : channelCount == 3 ? GL_RGB : channelCount == 2 ? GL_RG : GL_RED;
+		glTexSubImage2D(GL_TEXTURE_2D, 0, x, y, width, height, imageFormat, GL_UNSIGNED_BYTE, pAddress);
+
+		glGenerateMipmap(GL_TEXTURE_2D);
+		m_state.bindTexture(0);
+
+		return true;
+	}
+
 	void GL_UIRenderer::destroyTexture(UInt32 textureHandle)
 	{
 		auto iter = std::find(m_textures.begin(), m_textures.end(), textureHandle);
 		if (iter != m_textures.end())
 		{
 			glDeleteTextures(1, &textureHandle);
+			m_state.onTextureDeleted(textureHandle);
 			m_textures.erase(iter);
 		}
 	}
@@ -467,6 +1263,10 @@ namespace ZE
 	void GL_UIRenderer::destroyTextures()
 	{
 		glDeleteTextures(m_textures.size(), m_textures.data());
+		for (UInt32 textureHandle : m_textures)
+		{
+			m_state.onTextureDeleted(textureHandle);
+		}
 	}
 
 	void GL_UIRenderer::resizeWindow(int width, int height)
@@ -474,11 +1274,36 @@ namespace ZE
 		m_width = width;
 		m_height = height;
 		glViewport(0, 0, width, height);
+
+		updateFrameData();
+		createFrameBuffer(width, height);
+	}
+
+	void GL_UIRenderer::pollEvents()
+	{
+		glfwPollEvents();
+	}
+
+	void GL_UIRenderer::waitEvents(Float32 timeoutMS)
+	{
+		if (timeoutMS < 0.0f)
+		{
+			glfwWaitEvents();
+		}
+		else
+		{
+			glfwWaitEventsTimeout(timeoutMS / 1000.0);
+		}
+	}
+
+	void GL_UIRenderer::postEmptyEvent()
+	{
+		glfwPostEmptyEvent();
 	}
 
 	void GL_UIRenderer::setDrawData(const UIArray<UIVertex>& vertices)
 	{
-		glBindBuffer(GL_ARRAY_BUFFER, VBO_draw);
+		m_state.bindArrayBuffer(VBO_draw);
 		if (maxDrawSize < vertices.size())
 		{
 			while (maxDrawSize < vertices.size())
@@ -489,12 +1314,11 @@ namespace ZE
 		}
 
 		glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(Vertex) * vertices.size(), vertices.data());
-		glBindBuffer(GL_ARRAY_BUFFER, 0);
 	}
 
 	void GL_UIRenderer::setTextData(const UIArray<UIVertex>& vertices)
 	{
-		glBindBuffer(GL_ARRAY_BUFFER, VBO_text);
+		m_state.bindArrayBuffer(VBO_text);
 		if (maxTextSize < vertices.size())
 		{
 			while (maxTextSize < vertices.size())
@@ -505,23 +1329,52 @@ namespace ZE
 		}
 
 		glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(UIVertex) * vertices.size(), vertices.data());
-		glBindBuffer(GL_ARRAY_BUFFER, 0);
+	}
+
+	void GL_UIRenderer::drawQuads(UInt32 vertexCount)
+	{
+		// Index buffer only covers QuadIndexBufferQuads quads, longer lists continue from a base vertex
+		UInt32 quadCount = vertexCount / 4;
+		GLint baseVertex = 0;
+		while (quadCount > 0)
+		{
+			const UInt32 chunkQuads = quadCount < UI::QuadIndexBufferQuads ? quadCount : UI::QuadIndexBufferQuads;
+			glDrawElementsBaseVertex(GL_TRIANGLES, chunkQuads * UI::QuadIndexCount, GL_UNSIGNED_SHORT, nullptr, baseVertex);
+			baseVertex += chunkQuads * 4;
+			quadCount -= chunkQuads;
+		}
 	}
 
 	void GL_UIRenderer::setInstanceDrawData(const UIArray<UIDrawInstance>& instances)
 	{
-		glBindBuffer(GL_ARRAY_BUFFER, VBO_instance);
+		m_state.bindArrayBuffer(VBO_instance);
 		if (maxInstanceDraw < instances.size())
 		{
 			while (maxInstanceDraw < instances.size())
 			{
 				maxInstanceDraw *= 2;
 			}
-			glBufferData(GL_ARRAY_BUFFER, sizeof(UIDrawInstance) * maxInstanceDraw, nullptr, GL_DYNAMIC_DRAW);
+			glBufferData(GL_ARRAY_BUFFER, sizeof(UIRenderInstance) * maxInstanceDraw, nullptr, GL_DYNAMIC_DRAW);
 		}
 
-		glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(UIDrawInstance) * instances.size(), instances.data());
-		glBindBuffer(GL_ARRAY_BUFFER, 0);
+		glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(UIRenderInstance) * instances.size(), UI::GetRenderInstances(instances, m_instancePackBuffer));
+		m_instanceBytes += (UInt32)(sizeof(UIRenderInstance) * instances.size());
+	}
+
+	void GL_UIRenderer::setInstanceInsetsData(const UIArray<UIInstanceInsets>& instanceInsets, size_t instanceCount)
+	{
+		m_state.bindArrayBuffer(VBO_instanceInsets);
+		if (maxInstanceInsetsDraw < instanceCount)
+		{
+			while (maxInstanceInsetsDraw < instanceCount)
+			{
+				maxInstanceInsetsDraw *= 2;
+			}
+			glBufferData(GL_ARRAY_BUFFER, sizeof(UIRenderInstanceInsets) * maxInstanceInsetsDraw, nullptr, GL_DYNAMIC_DRAW);
+		}
+
+		glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(UIRenderInstanceInsets) * instanceCount, UI::GetRenderInstanceInsets(instanceInsets, instanceCount, m_instanceInsetsPackBuffer));
+		m_instanceBytes += (UInt32)(sizeof(UIRenderInstanceInsets) * instanceCount);
 	}
 
 
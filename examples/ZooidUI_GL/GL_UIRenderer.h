@@ -2,6 +2,7 @@
 #define __ZE_GL_UI_RENDERER__
 
 #include "UI/UIRenderer.h"
+#include "GL_StateCache.h"
 
 #include <gl/glew.h>
 #include <GLFW/glfw3.h>
@@ -46,18 +47,57 @@ namespace ZE
 		virtual bool requestToClose() override;
 		virtual UInt32 createRendererTexture(void* pAddress, UInt32 width, UInt32 height, UInt32 channelCount) override;
 		virtual void destroyTexture(UInt32 textureHandle);
+		virtual bool updateRendererTexture(UInt32 textureHandle, void* pAddress, UInt32 x, UInt32 y, UInt32 width, UInt32 height, UInt32 channelCount) override;
 		virtual void destroyTextures();
 		virtual void* getWindowContext() override { return m_window; }
 		virtual void resizeWindow(int width, int height);
+		virtual void pollEvents() override;
+		virtual void waitEvents(Float32 timeoutMS) override;
+		virtual void postEmptyEvent() override;
+		virtual UInt32 createRenderTarget(UInt32 width, UInt32 height) override;
+		virtual void destroyRenderTarget(UInt32 textureHandle) override;
+		virtual void renderToTarget(UInt32 textureHandle, UIDrawList* drawList, const UIRect& rect) override;
+
+		// Instanced items sharing a shader are submitted with glMultiDrawArraysIndirect, needs GL 4.3 and draw parameters
+		bool isMultiDrawIndirectSupported() const { return m_bMultiDrawIndirectSupported; }
+		void setMultiDrawIndirect(bool bEnable) { m_bMultiDrawIndirect = bEnable && m_bMultiDrawIndirectSupported; }
+
+		// GL calls issued and skipped by state cache during last frame
+		UInt32 getIssuedStateCalls() const { return m_issuedStateCalls; }
+		UInt32 getSavedStateCalls() const { return m_savedStateCalls; }
+
+		// Draw calls issued during last frame, render target passes included
+		UInt32 getDrawCalls() const { return m_lastDrawCalls; }
+
+		// Instance bytes uploaded during last frame
+		UInt32 getInstanceUploadBytes() const { return m_lastInstanceBytes; }
 
 	protected:
 
 		void setDrawData(const UIArray<UIVertex>& vertices);
 		void setTextData(const UIArray<UIVertex>& vertices);
+
+		// Draw bound vertex list of 4 vertex quads with the shared quad index buffer
+		void drawQuads(UInt32 vertexCount);
 		void setInstanceDrawData(const UIArray<UIDrawInstance>& instances);
-		void processDrawItem(UIDrawItem* drawItem);
+		void setInstanceInsetsData(const UIArray<UIInstanceInsets>& instanceInsets, size_t instanceCount);
+		void processDrawItem(UIDrawItem* drawItem, UInt32 drawIndex, const UIArray<UIDrawInstance>& instances, const UIArray<UIInstanceInsets>& instanceInsets);
+		bool canDrawInstancesTogether(UIDrawItem* drawItem1, UIDrawItem* drawItem2);
+		void applyDrawMaskState(UIDrawItem* drawItem);
+		void applyScissorState(UIDrawItem* drawItem);
+		void initMultiDrawIndirect();
+		void createIndirectVertexArray(GLuint& VAO, GLuint quadBuffer);
+		Shader* getIndirectShader(UIDrawItem* drawItem, GLuint& VAO, GLint& drawBaseLocation);
+		void processDrawItemsIndirect(const UIArray<UIDrawItem*>& drawItems);
+		void processDrawList(UIDrawList* drawList, bool bPartial);
+		void updateFrameData();
+		void uploadDrawData(const UIArray<UIDrawItem*>& drawItems);
+		void processRenderTargets();
 		void pushMask();
 		void popMask();
+		void createFrameBuffer(int width, int height);
+		void blitFrameBuffer();
+		void destroyFrameBuffer();
 
 		int m_width;
 		int m_height;
@@ -78,6 +118,10 @@ namespace ZE
 		GLuint VBO_instance;
 		size_t maxInstanceDraw = 256;
 
+		// Insets of shape instances, attribute is only enabled for items that have them
+		GLuint VBO_instanceInsets;
+		size_t maxInstanceInsetsDraw = 256;
+
 		GLuint VBO_draw;
 		GLuint VAO_draw;
 		size_t maxDrawSize = 256;
@@ -86,9 +130,131 @@ namespace ZE
 		GLuint VAO_text;
 		size_t maxTextSize = 1024;
 
+		// Static quad index buffer, bound to VAO_draw and VAO_text
+		GLuint EBO_quad;
+
 		UInt32 maskCount = 0;
 
+		// Damage area of partial redraw, item scissor rects are clamped to it. GL window origin is bottom left.
+		bool m_bDamageScissor = false;
+		GLint m_damageScissor[4];
+
+		// Window position of screen origin, render targets shift viewport to draw screen area into target
+		GLint m_scissorOffset[2] = { 0, 0 };
+
+		GL_StateCache m_state;
+		UInt32 m_issuedStateCalls = 0;
+		UInt32 m_savedStateCalls = 0;
+		UInt32 m_drawCalls = 0;
+		UInt32 m_lastDrawCalls = 0;
+		UInt32 m_instanceBytes = 0;
+		UInt32 m_lastInstanceBytes = 0;
+
+		// Matches std140 DrawData block in shaders
+		struct DrawData
+		{
+			Float32 cropBox[4];
+			Float32 shapeDimension[2];
+			Float32 roundness;
+			Int32 bCrop;
+		};
+
+		// Frame constants bound once, per draw parameters packed per draw list and bound by range
+		GLuint UBO_frame = 0;
+		GLuint UBO_draw = 0;
+		GLsizeiptr m_drawDataStride = 0;
+		GLsizeiptr m_drawDataSize = 0;
+		UIArray<UInt8> m_drawDataStaging;
+
+		// Reused each draw list so submission doesn't allocate
+		UIArray<UIDrawItem*> m_drawItemsToProcess;
+		UIArray<UIDrawInstance> m_runInstances;
+		UIArray<UIInstanceInsets> m_runInstanceInsets;
+		UIArray<UIVertex> m_flippedVertices;
+		UIArray<UIDrawInstance> m_flippedInstances;
+		UIArray<UIRenderInstance> m_instancePackBuffer;
+		UIArray<UIRenderInstanceInsets> m_instanceInsetsPackBuffer;
+
+		// Multi draw indirect path
+		static const UInt32 MaxIndirectTextures = 16;
+
+		// Matches std430 DrawParams in indirect shaders
+		struct IndirectDrawParams
+		{
+			Int32 textureSlot;
+		};
+
+		struct IndirectDrawCommand
+		{
+			GLuint count;
+			GLuint instanceCount;
+			GLuint first;
+			GLuint baseInstance;
+		};
+
+		// Consecutive commands of one shader, or a single item drawn the regular way if shader is null
+		struct IndirectBatch
+		{
+			Shader* shader;
+			GLuint VAO;
+			GLint drawBaseLocation;
+			UInt32 drawIndex;
+			UInt32 firstCommand;
+			UInt32 commandCount;
+			UInt32 textureCount;
+			GLuint textures[MaxIndirectTextures];
+		};
+
+		Shader* m_drawIndirectShader = nullptr;
+		Shader* m_drawIndirectTexShader = nullptr;
+		Shader* m_textIndirectShader = nullptr;
+
+		// "drawBase" uniform of indirect shaders, resolved once after linking
+		GLint m_drawIndirectBaseLocation = -1;
+		GLint m_drawIndirectTexBaseLocation = -1;
+		GLint m_textIndirectBaseLocation = -1;
+
+		GLuint VAO_indirectRect = 0;
+		GLuint VAO_indirectRectText = 0;
+		GLuint VBO_indirectInstance = 0;
+		GLuint DIB_commands = 0;
+		GLuint SSBO_drawParams = 0;
+		bool m_bMultiDrawIndirectSupported = false;
+		bool m_bMultiDrawIndirect = false;
+
+		UIArray<UIDrawInstance> m_indirectInstances;
+		UIArray<IndirectDrawCommand> m_indirectCommands;
+		UIArray<IndirectDrawParams> m_indirectParams;
+		UIArray<IndirectBatch> m_indirectBatches;
+
+		// Persistent frame buffer, keeps previous frame so only damaged area is redrawn
+		GLuint FBO_frame = 0;
+		GLuint RBO_frameColor = 0;
+		GLuint RBO_frameDepthStencil = 0;
+		bool m_bFrameBufferSupported = true;
+		bool m_bFrameBufferValid = false;
+		bool m_bFrameBufferBlitChecked = false;
+
 		UIArray<UInt32> m_textures;
+
+		// Offscreen render targets, keyed by color texture
+		struct RenderTarget
+		{
+			GLuint FBO;
+			GLuint RBO_depthStencil;
+			UInt32 width;
+			UInt32 height;
+		};
+
+		struct RenderTargetRequest
+		{
+			UInt32 textureHandle;
+			UIDrawList* drawList;
+			UIRect rect;
+		};
+
+		UIHashMap<UInt32, RenderTarget> m_renderTargets;
+		UIArray<RenderTargetRequest> m_renderTargetRequests;
 	};
 }
 #endif
@@ -3,6 +3,10 @@
 #include "GL_UIRenderer.h"
 #include <iostream>
 #include <cstring>
+#include <thread>
+#include <chrono>
+#include <vector>
+#include <string>
 
 double mouseX = 0.0f;
 double mouseY = 0.0f;
@@ -97,11 +101,574 @@ void windowFrameBufferSizeCallback(GLFWwindow* window, int width, int height)
 
 bool listItemChecked[5] = { false };
 
-int main()
+// Simulate slow backing store for async item list
+class SlowItemListProvider : public ZE::AsyncItemListProvider
 {
+public:
+	virtual void loadRange(ZE::UInt32 first, ZE::UInt32 count, ZE::UIItemListBlock& outBlock) override
+	{
+		std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+		char itemText[64];
+		for (ZE::UInt32 i = 0; i < count; i++)
+		{
+			sprintf_s(itemText, "Loaded Item %u", first + i);
+			outBlock.addItem(itemText);
+		}
+	}
+
+	virtual ZE::Int32 count() const override { return 1000000; }
+};
+
+// Generated table data for table sample
+class SampleTableProvider : public ZE::TableDataProvider
+{
+public:
+	SampleTableProvider(ZE::UInt32 rowCount)
+	{
+		char cellText[64];
+		for (ZE::UInt32 i = 0; i < rowCount; i++)
+		{
+			sprintf_s(cellText, "Row %u", i);
+			m_cells.push_back(cellText);
+			sprintf_s(cellText, "%u", (i * 7919) % rowCount);
+			m_cells.push_back(cellText);
+			sprintf_s(cellText, "Name %c%c", 'A' + (i % 26), 'a' + ((i / 26) % 26));
+			m_cells.push_back(cellText);
+		}
+	}
+
+	virtual const ZE::UIChar* getCell(ZE::UInt32 row, ZE::UInt32 column) const override { return m_cells[row * 3 + column].c_str(); }
+	virtual ZE::Int32 rowCount() const override { return (ZE::Int32)(m_cells.size() / 3); }
+	virtual ZE::Int32 columnCount() const override { return 3; }
+
+protected:
+	std::vector<std::string> m_cells;
+};
+
+// Generated hierarchy for tree sample: 100k top nodes with 20 children each
+class SampleTreeProvider : public ZE::TreeDataProvider
+{
+public:
+	virtual ZE::UInt32 getChildCount(ZE::UInt32 node) const override { return node == 0 ? 100000 : (node <= 100000 ? 20 : 0); }
+
+	virtual void fetchChildren(ZE::UInt32 node, ZE::UInt32 first, ZE::UInt32 count, ZE::UInt32* outChildren) const override
+	{
+		for (ZE::UInt32 i = 0; i < count; i++)
+		{
+			outChildren[i] = node == 0 ? 1 + first + i : 100001 + (node - 1) * 20 + first + i;
+		}
+	}
+
+	virtual const ZE::UIChar* getLabel(ZE::UInt32 node) const override
+	{
+		static char labelText[64];
+		sprintf_s(labelText, node <= 100000 ? "Group %u" : "Item %u", node);
+		return labelText;
+	}
+};
+
+namespace ZE
+{
+	namespace UI
+	{
+		// Tree helpers from ZooidUI.cpp, checked by --tree-test
+		void ExpandTreeNode(UITreeState& treeState, UInt32 node, UInt32 depth, Int32 parentRow, UInt32 insertPos);
+		void ProcessTreeExpandJobs(UITreeState& treeState);
+	}
+}
+
+// Two top nodes, first one has more children than one frame adds, each of them with 2 children
+class ExpandTestTreeProvider : public ZE::TreeDataProvider
+{
+public:
+	static const ZE::UInt32 ChildCount = ZUI_TREE_EXPAND_BUDGET + 10;
+
+	virtual ZE::UInt32 getChildCount(ZE::UInt32 node) const override { return node == 0 ? 2 : (node == 1 ? ChildCount : (node >= 1000 && node < 1000000 ? 2 : 0)); }
+
+	virtual void fetchChildren(ZE::UInt32 node, ZE::UInt32 first, ZE::UInt32 count, ZE::UInt32* outChildren) const override
+	{
+		for (ZE::UInt32 i = 0; i < count; i++)
+		{
+			outChildren[i] = node == 0 ? 1 + first + i : (node == 1 ? 1000 + first + i : 1000000 + (node - 1000) * 2 + first + i);
+		}
+	}
+
+	virtual const ZE::UIChar* getLabel(ZE::UInt32 node) const override { return "Node"; }
+};
+
+// Expands the last added child while its parent is still adding children, its children must follow it directly
+int runTreeExpandTest()
+{
+	ExpandTestTreeProvider treeProvider;
+	ZE::UITreeState treeState;
+	treeState.provider = &treeProvider;
+
+	ZE::UI::ExpandTreeNode(treeState, 0, 0, -1, 0);
+	ZE::UI::ProcessTreeExpandJobs(treeState);
+
+	treeState.rows[0].bExpanded = true;
+	ZE::UI::ExpandTreeNode(treeState, treeState.rows[0].node, 1, 0, 1);
+	ZE::UI::ProcessTreeExpandJobs(treeState);
+
+	const ZE::UInt32 lastRow = ZUI_TREE_EXPAND_BUDGET;
+	treeState.rows[lastRow].bExpanded = true;
+	ZE::UI::ExpandTreeNode(treeState, treeState.rows[lastRow].node, 2, lastRow, lastRow + 1);
+
+	while (treeState.expandJobs.size() > 0)
+	{
+		ZE::UI::ProcessTreeExpandJobs(treeState);
+	}
+
+	const ZE::UInt32 lastNode = 1000 + ZUI_TREE_EXPAND_BUDGET - 1;
+	const bool bPassed = treeState.rows.size() == 2 + ExpandTestTreeProvider::ChildCount + 2
+		&& treeState.rows[lastRow].node == lastNode
+		&& treeState.rows[lastRow + 1].node == 1000000 + (lastNode - 1000) * 2 && treeState.rows[lastRow + 1].depth == 2
+		&& treeState.rows[lastRow + 2].node == 1000000 + (lastNode - 1000) * 2 + 1 && treeState.rows[lastRow + 2].depth == 2
+		&& treeState.rows[lastRow + 3].node == lastNode + 1 && treeState.rows[lastRow + 3].depth == 1
+		&& treeState.rows.back().node == 2;
+
+	std::cout << "Tree expand test " << (bPassed ? "passed" : "failed") << std::endl;
+	return bPassed ? 0 : 1;
+}
+
+// Static 4K screen where only one number changes, compares partial and full redraw time
+void runDamageBenchmark(ZE::GL_UIRenderer* renderer)
+{
+	const int frameCount = 500;
+	char buffer[64];
+	char panelLabel[32];
+
+	// Unlock swap so draw time isn't hidden by vsync
+	glfwSwapInterval(0);
+
+	for (int pass = 0; pass < 2; pass++)
+	{
+		const bool bPartial = pass == 0;
+		ZE::UI::SetPartialRedraw(bPartial);
+		ZE::UI::RequestRedraw();
+
+		ZE::Timer timer;
+		double drawTime = 0.0;
+		for (int frame = 0; frame < frameCount && !renderer->requestToClose(); frame++)
+		{
+			ZE::UI::BeginFrame();
+			ZE::UI::UpdateMouseState((ZE::Float32)mouseX, (ZE::Float32)mouseY, buttonState);
+
+			for (int panel = 0; panel < 24; panel++)
+			{
+				sprintf_s(panelLabel, "Panel %d", panel);
+				if (ZE::UI::BeginPanel(panelLabel, ZE::UIRect(ZE::UIVector2(40.0f + (panel % 6) * 620.0f, 80.0f + (panel / 6) * 510.0f), ZE::UIVector2(600.0f, 490.0f))))
+				{
+					for (int button = 0; button < 10; button++)
+					{
+						sprintf_s(buffer, "Button %d-%d", panel, button);
+						ZE::UI::DoButton(buffer);
+					}
+					ZE::UI::EndPanel();
+				}
+			}
+
+			sprintf_s(buffer, "Frame %d", frame);
+			ZE::UI::DrawTextInPos(ZE::UIVector2{ 40.0f, 40.0f }, buffer, ZE::UIVector4{ 1.0f });
+
+			ZE::UI::EndFrame();
+
+			timer.Reset();
+			ZE::UI::ProcessDrawList();
+			glFinish();
+			drawTime += timer.ResetAndGetDeltaMS();
+		}
+
+		std::cout << (bPartial ? "Partial" : "Full") << " redraw: " << drawTime / frameCount << " ms/frame" << std::endl;
+	}
+
+	ZE::UI::SetPartialRedraw(true);
+}
+
+// Inspector with 5000 widgets, compares CPU frame time with and without the layout cache
+void runLayoutBenchmark(ZE::GL_UIRenderer* renderer)
+{
+	const int frameCount = 300;
+	const int rowCount = 1000;
+
+	// Labels are built once so the benchmark measures UI work only
+	std::vector<std::string> checkLabels(rowCount);
+	std::vector<std::string> buttonLabels(rowCount);
+	std::vector<std::string> radioLabels(rowCount * 2);
+	std::vector<const ZE::UIChar*> radioTexts(rowCount * 2);
+	std::vector<ZE::Float32> numbers(rowCount);
+	std::vector<ZE::Int32> selections(rowCount, 0);
+	std::vector<char> checks(rowCount, 0);
+	for (int row = 0; row < rowCount; row++)
+	{
+		checkLabels[row] = "Enabled " + std::to_string(row);
+		buttonLabels[row] = "Reset Property " + std::to_string(row);
+		radioLabels[row * 2] = "Local " + std::to_string(row);
+		radioLabels[row * 2 + 1] = "World " + std::to_string(row);
+		radioTexts[row * 2] = radioLabels[row * 2].c_str();
+		radioTexts[row * 2 + 1] = radioLabels[row * 2 + 1].c_str();
+		numbers[row] = (ZE::Float32)row;
+	}
+
+	for (int pass = 0; pass < 2; pass++)
+	{
+		const bool bLayoutCache = pass == 0;
+		ZE::UI::SetLayoutCache(bLayoutCache);
+
+		ZE::Timer timer;
+		double cpuTime = 0.0;
+		ZE::UInt32 hits = 0;
+		ZE::UInt32 misses = 0;
+		for (int frame = 0; frame < frameCount && !renderer->requestToClose(); frame++)
+		{
+			timer.Reset();
+			ZE::UI::BeginFrame();
+			ZE::UI::UpdateMouseState((ZE::Float32)mouseX, (ZE::Float32)mouseY, buttonState);
+
+			for (int row = 0; row < rowCount; row++)
+			{
+				checks[row] = ZE::UI::DoCheckBox(checkLabels[row].c_str(), checks[row] != 0);
+				ZE::UI::DoButton(buttonLabels[row].c_str());
+				ZE::UI::DoNumberStepper(&numbers[row], 1.0f, true);
+				ZE::UI::DoRadioButtons(&radioTexts[row * 2], 2, &selections[row]);
+			}
+
+			ZE::UI::EndFrame();
+			cpuTime += timer.ResetAndGetDeltaMS();
+
+			const ZE::UIFrameStats& stats = ZE::UI::GetFrameStats();
+			hits += stats.layoutCacheHits;
+			misses += stats.layoutCacheMisses;
+
+			ZE::UI::ProcessDrawList();
+		}
+
+		std::cout << (bLayoutCache ? "Layout cache on: " : "Layout cache off: ") << cpuTime / frameCount << " ms/frame";
+		if (hits + misses > 0)
+		{
+			std::cout << ", hit rate " << (100.0 * hits) / (hits + misses) << "%";
+		}
+		std::cout << std::endl;
+	}
+
+	ZE::UI::SetLayoutCache(true);
+}
+
+// Nested rows/columns built with layout containers, compared with the same widgets placed by hand
+void runFlexBenchmark(ZE::GL_UIRenderer* renderer)
+{
+	const int frameCount = 300;
+	const int groupCount = 500;
+
+	std::vector<std::string> labels(groupCount * 5);
+	std::vector<char> checks(groupCount * 2, 0);
+	for (int i = 0; i < (int)labels.size(); i++)
+	{
+		labels[i] = "Item " + std::to_string(i);
+	}
+
+	const ZE::UIRect panelRect(ZE::UIVector2(10.0f, 10.0f), ZE::UIVector2(900.0f, 780.0f));
+	const ZE::Float32 buttonHeight = ZE::UI::DefaultFont->calculateTextHeight(1.0f) + 20.0f;
+
+	for (int pass = 0; pass < 2; pass++)
+	{
+		const bool bLayout = pass == 0;
+
+		ZE::Timer timer;
+		double cpuTime = 0.0;
+		for (int frame = 0; frame < frameCount && !renderer->requestToClose(); frame++)
+		{
+			timer.Reset();
+			ZE::UI::BeginFrame();
+			ZE::UI::UpdateMouseState((ZE::Float32)mouseX, (ZE::Float32)mouseY, buttonState);
+
+			if (ZE::UI::BeginPanel("Flex Benchmark", panelRect))
+			{
+				for (int group = 0; group < groupCount; group++)
+				{
+					const std::string* groupLabels = &labels[group * 5];
+					char* groupChecks = &checks[group * 2];
+
+					if (bLayout)
+					{
+						ZE::UI::BeginRow();
+						ZE::UI::BeginColumn();
+						ZE::UI::DoButton(groupLabels[0].c_str());
+						ZE::UI::DoButton(groupLabels[1].c_str());
+						ZE::UI::EndColumn();
+						ZE::UI::BeginColumn();
+						groupChecks[0] = ZE::UI::DoCheckBox(groupLabels[2].c_str(), groupChecks[0] != 0);
+						groupChecks[1] = ZE::UI::DoCheckBox(groupLabels[3].c_str(), groupChecks[1] != 0);
+						ZE::UI::EndColumn();
+						ZE::UI::DoButton(groupLabels[4].c_str());
+						ZE::UI::EndRow();
+					}
+					else
+					{
+						// Fixed column widths, the way nested layouts are written without layout containers
+						ZE::UIVector2 pos = ZE::UI::MainUIState.drawPosDimension.m_pos;
+						ZE::UIRect rect(pos, ZE::UIVector2(120.0f, buttonHeight));
+						ZE::UI::DoButtonEx(groupLabels[0].c_str(), rect);
+						rect.m_pos.y += buttonHeight + 5.0f;
+						ZE::UI::DoButtonEx(groupLabels[1].c_str(), rect);
+
+						ZE::UIRect checkRect;
+						groupChecks[0] = ZE::UI::DoCheckBoxEx(ZE::UIVector2(pos.x + 125.0f, pos.y), groupLabels[2].c_str(), groupChecks[0] != 0, checkRect);
+						groupChecks[1] = ZE::UI::DoCheckBoxEx(ZE::UIVector2(pos.x + 125.0f, pos.y + checkRect.m_dimension.y + 5.0f), groupLabels[3].c_str(), groupChecks[1] != 0, checkRect);
+
+						rect.m_pos = ZE::UIVector2(pos.x + 250.0f, pos.y);
+						ZE::UI::DoButtonEx(groupLabels[4].c_str(), rect);
+
+						ZE::UI::AdvanceDrawPos(ZE::UIVector2(370.0f, buttonHeight * 2.0f + 5.0f));
+					}
+				}
+				ZE::UI::EndPanel();
+			}
+
+			ZE::UI::EndFrame();
+			cpuTime += timer.ResetAndGetDeltaMS();
+
+			ZE::UI::ProcessDrawList();
+		}
+
+		std::cout << (bLayout ? "Layout containers: " : "Manual placement: ") << cpuTime / frameCount << " ms/frame" << std::endl;
+	}
+}
+
+// 10k buttons under stacked panels, compares CPU frame time with and without the hit grid
+void runHitBenchmark(ZE::GL_UIRenderer* renderer)
+{
+	const int frameCount = 300;
+	const int buttonCount = 10000;
+	const int panelCount = 4;
+
+	std::vector<std::string> buttonLabels(buttonCount);
+	std::vector<std::string> panelLabels(panelCount);
+	for (int i = 0; i < buttonCount; i++)
+	{
+		buttonLabels[i] = "B" + std::to_string(i);
+	}
+	for (int i = 0; i < panelCount; i++)
+	{
+		panelLabels[i] = "Hit Panel " + std::to_string(i);
+	}
+
+	for (int pass = 0; pass < 2; pass++)
+	{
+		const bool bHitGrid = pass == 0;
+		ZE::UI::SetHitGrid(bHitGrid);
+
+		ZE::Timer timer;
+		double cpuTime = 0.0;
+		for (int frame = 0; frame < frameCount && !renderer->requestToClose(); frame++)
+		{
+			timer.Reset();
+			ZE::UI::BeginFrame();
+			ZE::UI::UpdateMouseState((ZE::Float32)mouseX, (ZE::Float32)mouseY, buttonState);
+
+			// Panels overlap each other, later panel is on top
+			const int buttonsPerPanel = buttonCount / panelCount;
+			for (int panel = 0; panel < panelCount; panel++)
+			{
+				const ZE::UIRect panelRect(ZE::UIVector2(20.0f + panel * 60.0f, 20.0f + panel * 60.0f), ZE::UIVector2(600.0f, 600.0f));
+				if (!ZE::UI::BeginPanel(panelLabels[panel].c_str(), panelRect))
+				{
+					continue;
+				}
+
+				for (int i = panel * buttonsPerPanel; i < (panel + 1) * buttonsPerPanel; i++)
+				{
+					const int local = i - panel * buttonsPerPanel;
+					ZE::UIRect rect(panelRect.m_pos + ZE::UIVector2(10.0f + (local % 50) * 11.0f, 40.0f + (local / 50) * 11.0f), ZE::UIVector2(10.0f, 10.0f));
+					ZE::UI::DoButtonEx(buttonLabels[i].c_str(), rect);
+				}
+				ZE::UI::EndPanel();
+			}
+
+			ZE::UI::EndFrame();
+			cpuTime += timer.ResetAndGetDeltaMS();
+
+			ZE::UI::ProcessDrawList();
+		}
+
+		std::cout << (bHitGrid ? "Hit grid on: " : "Hit grid off: ") << cpuTime / frameCount << " ms/frame" << std::endl;
+	}
+
+	ZE::UI::SetHitGrid(true);
+}
+
+// Full redraw of a dense widget screen, reports CPU time spent submitting each draw item to the driver
+void runDrawBenchmark(ZE::GL_UIRenderer* renderer)
+{
+	const int frameCount = 500;
+	const int buttonCount = 2000;
+
+	std::vector<std::string> buttonLabels(buttonCount);
+	for (int i = 0; i < buttonCount; i++)
+	{
+		buttonLabels[i] = "B" + std::to_string(i);
+	}
+
+	// Unlock swap so submit time isn't hidden by vsync
+	glfwSwapInterval(0);
+	ZE::UI::SetPartialRedraw(false);
+
+	// Per item draws, then multi draw indirect if driver has it
+	const int passCount = renderer->isMultiDrawIndirectSupported() ? 2 : 1;
+	for (int pass = 0; pass < passCount; pass++)
+	{
+		const bool bIndirect = pass == 1;
+		renderer->setMultiDrawIndirect(bIndirect);
+
+		ZE::Timer timer;
+		double submitTime = 0.0;
+		double itemCount = 0.0;
+		double issuedStateCalls = 0.0;
+		double savedStateCalls = 0.0;
+		double drawCalls = 0.0;
+		for (int frame = 0; frame < frameCount && !renderer->requestToClose(); frame++)
+		{
+			ZE::UI::BeginFrame();
+			ZE::UI::UpdateMouseState((ZE::Float32)mouseX, (ZE::Float32)mouseY, buttonState);
+
+			for (int i = 0; i < buttonCount; i++)
+			{
+				ZE::UIRect rect(ZE::UIVector2(10.0f + (i % 40) * 24.0f, 10.0f + (i / 40) * 15.0f), ZE::UIVector2(22.0f, 13.0f));
+				ZE::UI::DoButtonEx(buttonLabels[i].c_str(), rect);
+			}
+
+			// Same list every frame, force it through the renderer anyway
+			ZE::UI::RequestRedraw();
+			ZE::UI::EndFrame();
+			itemCount += renderer->getDrawList()->itemCount();
+
+			// GPU work is finished outside the timer so only driver CPU time is counted
+			timer.Reset();
+			ZE::UI::ProcessDrawList();
+			submitTime += timer.ResetAndGetDeltaMS();
+			glFinish();
+			issuedStateCalls += renderer->getIssuedStateCalls();
+			savedStateCalls += renderer->getSavedStateCalls();
+			drawCalls += renderer->getDrawCalls();
+		}
+
+		std::cout << (bIndirect ? "Multi draw indirect" : "Per item draws") << " submit: " << submitTime / frameCount << " ms/frame, " << submitTime * 1000.0 / itemCount << " us/item" << std::endl;
+		std::cout << "State calls: " << issuedStateCalls / frameCount << " issued, " << savedStateCalls / frameCount << " skipped per frame" << std::endl;
+		std::cout << "Draw calls: " << drawCalls / frameCount << " per frame for " << itemCount / frameCount << " items" << std::endl;
+	}
+
+	renderer->setMultiDrawIndirect(true);
+	ZE::UI::SetPartialRedraw(true);
+}
+
+// Screen full of text lines, reports instance bytes uploaded and frame time
+void runTextBenchmark(ZE::GL_UIRenderer* renderer)
+{
+	const int frameCount = 500;
+	const int lineCount = 45;
+
+	std::vector<std::string> lines(lineCount);
+	for (int i = 0; i < lineCount; i++)
+	{
+		lines[i] = "Line " + std::to_string(i) + ": The quick brown fox jumps over the lazy dog 0123456789 the quick brown fox";
+	}
+
+	glfwSwapInterval(0);
+	ZE::UI::SetPartialRedraw(false);
+
+	ZE::Timer timer;
+	double frameTime = 0.0;
+	double instanceBytes = 0.0;
+	for (int frame = 0; frame < frameCount && !renderer->requestToClose(); frame++)
+	{
+		timer.Reset();
+		ZE::UI::BeginFrame();
+		ZE::UI::UpdateMouseState((ZE::Float32)mouseX, (ZE::Float32)mouseY, buttonState);
+
+		for (int i = 0; i < lineCount; i++)
+		{
+			ZE::UIVector2 pos(10.0f, 10.0f + i * 17.0f);
+			ZE::UI::DrawTextInPos(pos, lines[i].c_str(), ZE::UIVector4(1.0f));
+		}
+
+		ZE::UI::RequestRedraw();
+		ZE::UI::EndFrame();
+		ZE::UI::ProcessDrawList();
+		glFinish();
+		frameTime += timer.ResetAndGetDeltaMS();
+		instanceBytes += renderer->getInstanceUploadBytes();
+	}
+
+	std::cout << "Instance format: " << sizeof(ZE::UIRenderInstance) << " bytes" << std::endl;
+	std::cout << "Instance upload: " << instanceBytes / frameCount << " bytes/frame, frame time: " << frameTime / frameCount << " ms" << std::endl;
+
+	ZE::UI::SetPartialRedraw(true);
+}
+
+// 100k list views that live for one frame each, state memory should stop growing once old states are collected
+void runStateBenchmark(ZE::GL_UIRenderer* renderer)
+{
+	const int frameCount = 2000;
+	const int listsPerFrame = 50;
+
+	const ZE::UIRect panelRect(ZE::UIVector2(10.0f, 10.0f), ZE::UIVector2(400.0f, 400.0f));
+	const ZE::UIRect listRect(ZE::UIVector2(20.0f, 50.0f), ZE::UIVector2(200.0f, 100.0f));
+	std::string listName;
+
+	for (int frame = 0; frame < frameCount && !renderer->requestToClose(); frame++)
+	{
+		ZE::UI::BeginFrame();
+		ZE::UI::UpdateMouseState((ZE::Float32)mouseX, (ZE::Float32)mouseY, buttonState);
+
+		if (ZE::UI::BeginPanel("State Benchmark", panelRect))
+		{
+			for (int i = 0; i < listsPerFrame; i++)
+			{
+				listName = "Transient List " + std::to_string(frame * listsPerFrame + i);
+				ZE::UI::BeginListView(listName.c_str(), listRect);
+				ZE::UI::EndListView();
+			}
+			ZE::UI::EndPanel();
+		}
+
+		ZE::UI::EndFrame();
+		ZE::UI::ProcessDrawList();
+
+		if (frame % 250 == 0 || frame == frameCount - 1)
+		{
+			std::cout << "Frame " << frame << ": " << ZE::UI::MainUIState.scrollStates.size() << " list states, "
+				<< ZE::UI::MainUIState.scrollStates.capacity() << " allocated" << std::endl;
+		}
+	}
+}
+
+int main(int argc, char** argv)
+{
+	// Checks tree rows without opening a window
+	if (argc > 1 && strcmp(argv[1], "--tree-test") == 0)
+	{
+		return runTreeExpandTest();
+	}
+
 	ZE::GL_UIRenderer* renderer;
 
-	ZE::UI::Init(1000, 800);
+	const bool bDamageBenchmark = argc > 1 && strcmp(argv[1], "--damage-benchmark") == 0;
+	const bool bLayoutBenchmark = argc > 1 && strcmp(argv[1], "--layout-benchmark") == 0;
+	const bool bFlexBenchmark = argc > 1 && strcmp(argv[1], "--flex-benchmark") == 0;
+	const bool bHitBenchmark = argc > 1 && strcmp(argv[1], "--hit-benchmark") == 0;
+	const bool bStateBenchmark = argc > 1 && strcmp(argv[1], "--state-benchmark") == 0;
+	const bool bDrawBenchmark = argc > 1 && strcmp(argv[1], "--draw-benchmark") == 0;
+	const bool bTextBenchmark = argc > 1 && strcmp(argv[1], "--text-benchmark") == 0;
+
+	if (bDamageBenchmark)
+	{
+		ZE::UI::Init(3840, 2160);
+	}
+	else
+	{
+		ZE::UI::Init(1000, 800);
+	}
 
 	renderer = (ZE::GL_UIRenderer*) ZE::UI::GetRenderer();
 
@@ -112,6 +679,55 @@ int main()
 	glfwSetCharCallback((GLFWwindow*)renderer->getWindowContext(), charInputCallback);
 	glfwSetScrollCallback((GLFWwindow*)renderer->getWindowContext(), scrollCallback);
 
+	if (bDamageBenchmark)
+	{
+		runDamageBenchmark(renderer);
+		ZE::UI::Destroy();
+		return 0;
+	}
+
+	if (bLayoutBenchmark)
+	{
+		runLayoutBenchmark(renderer);
+		ZE::UI::Destroy();
+		return 0;
+	}
+
+	if (bFlexBenchmark)
+	{
+		runFlexBenchmark(renderer);
+		ZE::UI::Destroy();
+		return 0;
+	}
+
+	if (bHitBenchmark)
+	{
+		runHitBenchmark(renderer);
+		ZE::UI::Destroy();
+		return 0;
+	}
+
+	if (bStateBenchmark)
+	{
+		runStateBenchmark(renderer);
+		ZE::UI::Destroy();
+		return 0;
+	}
+
+	if (bDrawBenchmark)
+	{
+		runDrawBenchmark(renderer);
+		ZE::UI::Destroy();
+		return 0;
+	}
+
+	if (bTextBenchmark)
+	{
+		runTextBenchmark(renderer);
+		ZE::UI::Destroy();
+		return 0;
+	}
+
 	ZE::UITexture* panelBg = ZE::UI::LoadTexture("../../Resource/Textures/PanelBg.png");
 
 	bool bChecked = false;
@@ -129,6 +745,16 @@ int main()
 	const char* dropdownText[5] = { "Option 1", "Option 2", "Option 3", "Option 4", "Option 5" };
 	ZE::Int32 dropdownIndex = 1;
 
+	std::vector<std::string> searchOptionStrings;
+	std::vector<const char*> searchOptions;
+	searchOptionStrings.reserve(20000);
+	for (int i = 0; i < 20000; i++)
+	{
+		searchOptionStrings.push_back("Search Option " + std::to_string(i));
+		searchOptions.push_back(searchOptionStrings.back().c_str());
+	}
+	ZE::Int32 searchDropdownIndex = 0;
+
 	ZE::UIChar bufferInput[256];
 	bufferInput[0] = 0;
 
@@ -142,8 +768,27 @@ int main()
 	const char* listItems[5] = { "List Item 1", "List Item 2", "List Item 3", "List Item 4", "List Item 5" };
 	ZE::Int32 selectionIndex = 1;
 
+	SlowItemListProvider slowItemProvider;
+
+	SampleTableProvider tableProvider(100000);
+	ZE::UITableColumn tableColumns[3] = { { "Row", 100.0f }, { "Value", 80.0f }, { "Name", 120.0f } };
+	ZE::UIChar tableFilter[256];
+	tableFilter[0] = 0;
+
+	SampleTreeProvider treeProvider;
+	ZE::UInt32 selectedTreeNode = ZE::TreeDataProvider::InvalidNode;
+
+	ZE::UIFrameStats lastFrameStats;
+	bool bWaitForEvents = false;
+
 	while (!renderer->requestToClose())
 	{
+		// Sleep while window is idle
+		if (bWaitForEvents)
+		{
+			ZE::UI::WaitForEvents();
+		}
+
 		timer.Reset();
 
 		// Immediate UI Logic
@@ -152,17 +797,30 @@ int main()
 		// Update State
 		ZE::UI::UpdateMouseState((ZE::Float32)mouseX, (ZE::Float32)mouseY, buttonState);
 
-		sprintf_s(buffer, "CPU Time: %.2f ms", cpuTime);
-		ZE::UI::DrawTextInPos(ZE::UIVector2{ 0.0f, ZE::UI::GetScreenHeight() - 4.0f * ZE::UI::DefaultFont->calculateTextHeight(1.0f) }, buffer, ZE::UIVector4{ 1.0f });
+		// Timing text changes every frame, hide it so frames can become idle
+		if (!bWaitForEvents)
+		{
+			sprintf_s(buffer, "Draw Calls/Items: %u/%d", renderer->getDrawCalls(), renderer->getDrawList() ? renderer->getDrawList()->itemCount() : 0);
+			ZE::UI::DrawTextInPos(ZE::UIVector2{ 0.0f, ZE::UI::GetScreenHeight() - 7.0f * ZE::UI::DefaultFont->calculateTextHeight(1.0f) }, buffer, ZE::UIVector4{ 1.0f });
+
+			sprintf_s(buffer, "Layout Cache Hits/Misses: %u/%u", lastFrameStats.layoutCacheHits, lastFrameStats.layoutCacheMisses);
+			ZE::UI::DrawTextInPos(ZE::UIVector2{ 0.0f, ZE::UI::GetScreenHeight() - 6.0f * ZE::UI::DefaultFont->calculateTextHeight(1.0f) }, buffer, ZE::UIVector4{ 1.0f });
+
+			sprintf_s(buffer, "Text Measured/Culled: %u/%u", lastFrameStats.textMeasured, lastFrameStats.textCulled);
+			ZE::UI::DrawTextInPos(ZE::UIVector2{ 0.0f, ZE::UI::GetScreenHeight() - 5.0f * ZE::UI::DefaultFont->calculateTextHeight(1.0f) }, buffer, ZE::UIVector4{ 1.0f });
+
+			sprintf_s(buffer, "CPU Time: %.2f ms", cpuTime);
+			ZE::UI::DrawTextInPos(ZE::UIVector2{ 0.0f, ZE::UI::GetScreenHeight() - 4.0f * ZE::UI::DefaultFont->calculateTextHeight(1.0f) }, buffer, ZE::UIVector4{ 1.0f });
 
-		sprintf_s(buffer, "Draw Time: %.2f ms", drawTime);
-		ZE::UI::DrawTextInPos(ZE::UIVector2{ 0.0f, ZE::UI::GetScreenHeight() - 3.0f * ZE::UI::DefaultFont->calculateTextHeight(1.0f) }, buffer, ZE::UIVector4{ 1.0f });
+			sprintf_s(buffer, "Draw Time: %.2f ms", drawTime);
+			ZE::UI::DrawTextInPos(ZE::UIVector2{ 0.0f, ZE::UI::GetScreenHeight() - 3.0f * ZE::UI::DefaultFont->calculateTextHeight(1.0f) }, buffer, ZE::UIVector4{ 1.0f });
 
-		sprintf_s(buffer, "Total Time: %.2f ms", totalTime);
-		ZE::UI::DrawTextInPos(ZE::UIVector2{ 0.0f, ZE::UI::GetScreenHeight() - 2.0f * ZE::UI::DefaultFont->calculateTextHeight(1.0f) }, buffer, ZE::UIVector4{ 1.0f });
+			sprintf_s(buffer, "Total Time: %.2f ms", totalTime);
+			ZE::UI::DrawTextInPos(ZE::UIVector2{ 0.0f, ZE::UI::GetScreenHeight() - 2.0f * ZE::UI::DefaultFont->calculateTextHeight(1.0f) }, buffer, ZE::UIVector4{ 1.0f });
 
-		sprintf_s(buffer, "FPS: %.1f", 1.0f / (totalTime / 1000.0f));
-		ZE::UI::DrawTextInPos(ZE::UIVector2{ 0.0f, ZE::UI::GetScreenHeight() - 1.0f * ZE::UI::DefaultFont->calculateTextHeight(1.0f) }, buffer, ZE::UIVector4{ 1.0f });
+			sprintf_s(buffer, "FPS: %.1f", 1.0f / (totalTime / 1000.0f));
+			ZE::UI::DrawTextInPos(ZE::UIVector2{ 0.0f, ZE::UI::GetScreenHeight() - 1.0f * ZE::UI::DefaultFont->calculateTextHeight(1.0f) }, buffer, ZE::UIVector4{ 1.0f });
+		}
 
 		if (ZE::UI::BeginPanel("Text Panel...", ZE::UIRect(ZE::UIVector2(150.0f, 100.f), ZE::UIVector2(300.0f, 200.0f)), false))
 		{
@@ -172,9 +830,11 @@ int main()
 				std::cout << "Button Clicked" << std::endl;
 			}
 			bChecked = ZE::UI::DoCheckBox("Checkbox", bChecked);
+			bWaitForEvents = ZE::UI::DoCheckBox("Wait For Events", bWaitForEvents);
 			ZE::UI::DoRadioButtons(radioTexts, 5, &selectedRadioButton);
 			ZE::UI::DoSlider(&sliderPercent);
 			ZE::UI::DoDropDown(&dropdownIndex, dropdownText, 5);
+			ZE::UI::DoSearchableDropDown(&searchDropdownIndex, searchOptions.data(), (ZE::Int32)searchOptions.size());
 			ZE::UI::DoTextInput(bufferInput, 256);
 			ZE::UI::DoNumberStepper(&number, 1.0f, true);
 			ZE::UI::DoNumberInput(&number2);
@@ -216,8 +876,17 @@ int main()
 			ZE::UI::EndPanel();
 		}
 
+		if (ZE::UI::BeginPanel("Table Sample...", ZE::UIRect(ZE::UIVector2(150.0f, 450.f), ZE::UIVector2(300.0f, 500.0f)), false))
+		{
+			ZE::UI::DoTextInput(tableFilter, 256);
+			ZE::UI::DoTable("TableTest", ZE::UIRect(ZE::UIVector2(0.0f, 0.0f), ZE::UIVector2(280.0f, 200.0f)), tableColumns, 3, &tableProvider, tableFilter);
+			ZE::UI::DoTreeView("TreeTest", ZE::UIRect(ZE::UIVector2(0.0f, 0.0f), ZE::UIVector2(280.0f, 200.0f)), &treeProvider, selectedTreeNode);
+			ZE::UI::EndPanel();
+		}
+
 #if 1
-		if (ZE::UI::BeginPanel("Image Scaling...", ZE::UIRect(ZE::UIVector2(350.0f, 100.f), ZE::UIVector2(250.0f, 500.0f)), true))
+		// Static panel, rendered once into texture and reused
+		if (ZE::UI::BeginCachedPanel("Image Scaling...", ZE::UIRect(ZE::UIVector2(350.0f, 100.f), ZE::UIVector2(250.0f, 500.0f)), true))
 		{
 			ZE::UI::DrawTexture({ 200, 70 }, panelBg, ZE::UIVector4{ 1.0f });
 			ZE::UI::DrawTexture({ 200, 70 }, panelBg, ZE::UIVector4{ 1.0f }, ZE::SCALE_9SCALE, ZE::UIVector4{ 0.40f, 0.15f, 0.15f, 0.15f });
@@ -230,6 +899,30 @@ int main()
 			ZE::UI::DrawMultiLineText("Text Align Left.\nLorem Ipsum Dolor Sit Amet. Lorem Ipsum Dolor Sit Amet.\nLorem Ipsum Dolor Sit Amet. Anpan. Anpan. Anpan. Anpan. Anpan. Anpan.", ZE::UIVector4{ 1.0f, 1.0f, 1.0f, 1.0f });
 			ZE::UI::DrawMultiLineText("Text Align Center.\nLorem Ipsum Dolor Sit Amet. Lorem Ipsum Dolor Sit Amet.\nLorem Ipsum Dolor Sit Amet. Anpan. Anpan. Anpan. Anpan. Anpan. Anpan.", ZE::UIVector4{ 1.0f, 1.0f, 1.0f, 1.0f }, ZE::TEXT_CENTER);
 			ZE::UI::DrawMultiLineText("Text Align Right.\nLorem Ipsum Dolor Sit Amet. Lorem Ipsum Dolor Sit Amet.\nLorem Ipsum Dolor Sit Amet. Anpan. Anpan. Anpan. Anpan. Anpan. Anpan.", ZE::UIVector4{ 1.0f, 1.0f, 1.0f, 1.0f }, ZE::TEXT_RIGHT);
+
+			ZE::UI::DoText("Virtual List", ZE::UIVector4(1.0f, 0.0f, 0.0f, 1.0f));
+			ZE::UI::DoVirtualListView("VirtualListTest",
+				ZE::UIRect(ZE::UIVector2(0.0f, 0.0f), ZE::UIVector2(230.0f, 150.0f)),
+				100000, 20.0f,
+				[](ZE::UInt32 idx)
+				{
+					char rowText[128];
+					if (idx % 3 == 0)
+					{
+						sprintf_s(rowText, "Row %u. Lorem Ipsum Dolor Sit Amet. Lorem Ipsum Dolor Sit Amet.", idx);
+					}
+					else
+					{
+						sprintf_s(rowText, "Row %u", idx);
+					}
+					ZE::UI::DoText(rowText);
+				}
+			);
+
+			ZE::UI::DoText("Async List", ZE::UIVector4(1.0f, 0.0f, 0.0f, 1.0f));
+			ZE::UI::DoVirtualListView("AsyncListTest",
+				ZE::UIRect(ZE::UIVector2(0.0f, 0.0f), ZE::UIVector2(230.0f, 150.0f)),
+				&slowItemProvider, 20.0f);
 			ZE::UI::EndPanel();
 		}
 #endif
@@ -264,6 +957,7 @@ int main()
 		ZE::UI::EndMenu();
 
 		ZE::UI::EndFrame();
+		lastFrameStats = ZE::UI::GetFrameStats();
 		cpuTime = ZE::UI::Lerp( cpuTime, timer.ResetAndGetDeltaMS(), cpuTime == 0.0f ? 1.0f : .01f);
 		
 		ZE::UI::ProcessDrawList();
@@ -272,6 +966,9 @@ int main()
 		totalTime = cpuTime + drawTime;
 	}
 
+	const ZE::UIIdleStats& idleStats = ZE::UI::GetIdleStats();
+	std::cout << "Rendered: " << idleStats.renderedFrames << " Skipped: " << idleStats.skippedFrames << " Idle Waits: " << idleStats.idleWaits << std::endl;
+
 	ZE::UI::Destroy();
 
 	return 0;
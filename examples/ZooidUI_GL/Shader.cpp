@@ -121,6 +121,10 @@ namespace ZE
 			glGetProgramInfoLog(this->Program, 512, NULL, infoLog);
 			std::cout << "ERROR::SHADER::PROGRAM::LINKING_FAILED\n" << std::endl;
 		}
+		else
+		{
+			m_bLinked = true;
+		}
 
 		if (geometryPath)
 		{
@@ -141,6 +145,15 @@ namespace ZE
 		return glGetUniformLocation(Program, _varName);
 	}
 
+	void Shader::bindUniformBlock(const char* _blockName, GLuint _binding)
+	{
+		GLuint blockIndex = glGetUniformBlockIndex(Program, _blockName);
+		if (blockIndex != GL_INVALID_INDEX)
+		{
+			glUniformBlockBinding(Program, blockIndex, _binding);
+		}
+	}
+
 
 	void Shader::setVec2(const char* _varName, UIVector2 _value)
 	{
@@ -167,6 +180,31 @@ namespace ZE
 		glUniform1i(getUniformPosition(_varName), _value);
 	}
 
+	void Shader::setVec2(GLint _location, UIVector2 _value)
+	{
+		glUniform2f(_location, _value.x, _value.y);
+	}
+
+	void Shader::setFloat(GLint _location, float _value)
+	{
+		glUniform1f(_location, _value);
+	}
+
+	void Shader::setInt(GLint _location, int _value)
+	{
+		glUniform1i(_location, _value);
+	}
+
+	void Shader::setVec4(GLint _location, UIVector4 _value)
+	{
+		glUniform4f(_location, _value.x, _value.y, _value.z, _value.w);
+	}
+
+	void Shader::setBool(GLint _location, bool _value)
+	{
+		glUniform1i(_location, _value);
+	}
+
 	void Shader::Use()
 	{
 		glUseProgram(this->Program);
@@ -24,14 +24,30 @@ namespace ZE
 
 		GLint getUniformPosition(const char* _varName);
 
+		// False if any stage failed to compile or program failed to link
+		bool isLinked() const { return m_bLinked; }
+
+		// Bind named uniform block to buffer binding point, does nothing if program doesn't use it
+		void bindUniformBlock(const char* _blockName, GLuint _binding);
+
 		void setVec2(const char* _varName, UIVector2 _value);
 		void setFloat(const char* _varName, float _value);
 		void setInt(const char* _varName, int _value);
 		void setVec4(const char* _varName, UIVector4 _value);
 		void setBool(const char* _varName, bool _value);
 
+		// Setters for locations resolved once with getUniformPosition, for uniforms set per draw
+		void setVec2(GLint _location, UIVector2 _value);
+		void setFloat(GLint _location, float _value);
+		void setInt(GLint _location, int _value);
+		void setVec4(GLint _location, UIVector4 _value);
+		void setBool(GLint _location, bool _value);
+
 		// Use the program
 		void Use();
+
+	protected:
+		bool m_bLinked = false;
 	};
 }
 #endif
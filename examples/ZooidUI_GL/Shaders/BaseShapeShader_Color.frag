@@ -5,8 +5,14 @@ in vec2 TexCoord;
 
 out vec4 FragColor;
 
-uniform float roundness;
-uniform vec2 shapeDimension;
+// Per draw item parameters, binding 1
+layout(std140) uniform DrawData
+{
+	vec4 CropBox;
+	vec2 shapeDimension;
+	float roundness;
+	bool bCrop;
+};
 
 void main()
 {
@@ -4,20 +4,29 @@ in vec4 OutColor;
 in vec2 TexCoord;
 in float Roundness;
 in vec2 ShapeDimension;
+flat in vec4 Slice;
+flat in vec4 BorderColor;
 
 out vec4 FragColor;
 
+// Outside of the rounded corners of a rect from origin to dimension
+bool isOutsideCorner(vec2 coords, vec2 dimension, float roundness)
+{
+	vec2 center = clamp(coords, vec2(roundness), max(dimension - vec2(roundness), vec2(roundness)));
+	return length(center - coords) > roundness;
+}
+
 void main()
 {
 	vec2 coords = TexCoord * ShapeDimension;
-	bool toDiscard = (coords.x < Roundness && coords.y < Roundness && length(vec2(Roundness) - coords) > Roundness ) ||
-		( coords.x > ShapeDimension.x - Roundness && coords.y < Roundness && length(vec2(ShapeDimension.x - Roundness, Roundness) - coords) > Roundness ) ||
-		( coords.y > ShapeDimension.y - Roundness && coords.x < Roundness && length(vec2(Roundness, ShapeDimension.y - Roundness) - coords) > Roundness ) ||
-		( coords.x > ShapeDimension.x - Roundness && coords.y > ShapeDimension.y - Roundness && length(vec2(ShapeDimension.x - Roundness, ShapeDimension.y - Roundness) - coords) > Roundness );
-	
-	float alpha = toDiscard ? 0.0 : 1.0;
-	
-	if( toDiscard ) { discard; }
+	if( isOutsideCorner(coords, ShapeDimension, Roundness) ) { discard; }
+
+	// Border is the band outside of rect inset by Slice (top, bottom, left, right)
+	vec2 innerMin = Slice.zx;
+	vec2 innerMax = ShapeDimension - Slice.wy;
+	float innerRoundness = max(Roundness - max(max(Slice.x, Slice.y), max(Slice.z, Slice.w)), 0.0);
+	bool isBorder = any(lessThan(coords, innerMin)) || any(greaterThan(coords, innerMax)) ||
+		isOutsideCorner(coords - innerMin, innerMax - innerMin, innerRoundness);
 
-	FragColor = OutColor * vec4( 1.0f, 1.0f, 1.0f, alpha );	
+	FragColor = isBorder ? BorderColor : OutColor;
 }
\ No newline at end of file
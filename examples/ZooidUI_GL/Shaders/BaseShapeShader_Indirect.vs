@@ -0,0 +1,69 @@
+#version 430
+#extension GL_ARB_shader_draw_parameters : enable
+layout (location = 0) in vec3 position;
+layout (location = 1) in vec2 texCoord;
+layout (location = 2) in vec4 color;
+layout (location = 3) in vec2 instancePos;
+layout (location = 4) in vec3 dimension;
+layout (location = 5) in vec4 instanceColor;
+layout (location = 6) in vec4 uvDim;
+layout (location = 8) in float instanceDepth;
+
+out vec4 OutColor;
+out vec2 TexCoord;
+out float Roundness;
+out vec2 ShapeDimension;
+flat out vec4 Slice;
+flat out vec4 UVDim;
+flat out vec4 BorderColor;
+flat out int TextureSlot;
+
+// Per frame constants, binding 0
+layout(std140) uniform FrameData
+{
+	vec2 screenDimension;
+
+	// Pixels per unit of instance position, dimension and clip
+	float instanceUnit;
+};
+
+// Per draw command parameters, indexed by draw id
+struct DrawParams
+{
+	int textureSlot;
+};
+
+layout(std430, binding = 0) readonly buffer DrawParamsBuffer
+{
+	DrawParams drawParams[];
+};
+
+// Index of first command of this multi draw in drawParams
+uniform int drawBase;
+
+#ifdef GL_ARB_shader_draw_parameters
+#define DRAW_ID gl_DrawIDARB
+#else
+#define DRAW_ID gl_DrawID
+#endif
+
+void main()
+{
+	vec2 instanceDim = dimension.xy * instanceUnit;
+	vec3 pos = vec3(position.xy * instanceDim + instancePos * instanceUnit, 0.0);
+	pos.x = 2.0 * ( pos.x / screenDimension.x) - 1.0;
+	pos.y = 1.0 - 2.0 * ( pos.y / screenDimension.y);
+	pos.z = 1.0 - instanceDepth;
+	ShapeDimension = instanceDim;
+	Roundness = dimension.z * instanceUnit;
+
+	// Items with insets are drawn by instance shaders
+	Slice = vec4(0.0);
+	UVDim = uvDim;
+	BorderColor = uvDim;
+
+	gl_Position = vec4( pos, 1.0 );
+	OutColor = color * instanceColor;
+	TexCoord = texCoord;
+	TextureSlot = drawParams[drawBase + DRAW_ID].textureSlot;
+}
\ No newline at end of file
@@ -0,0 +1,18 @@
+#version 430
+
+in vec4 OutColor;
+in vec2 TexCoord;
+flat in vec4 UVDim;
+flat in int TextureSlot;
+
+out vec4 FragColor;
+
+// Textures of one multi draw, slot comes from draw parameters so it's the same for whole draw
+uniform sampler2D InTextures[16];
+
+void main()
+{
+	// Nine slice items are drawn by instance shaders, texture coordinate is plain quad coordinate
+	vec4 sampled = texture(InTextures[TextureSlot], TexCoord * UVDim.zw + UVDim.xy);
+	FragColor = OutColor * sampled;
+}
\ No newline at end of file
@@ -2,28 +2,42 @@
 layout (location = 0) in vec3 position;
 layout (location = 1) in vec2 texCoord;
 layout (location = 2) in vec4 color;
-layout (location = 3) in vec3 instancePos;
+layout (location = 3) in vec2 instancePos;
 layout (location = 4) in vec3 dimension;
 layout (location = 5) in vec4 instanceColor;
 layout (location = 6) in vec4 uvDim;
+layout (location = 8) in float instanceDepth;
+layout (location = 9) in vec4 slice;
 
 out vec4 OutColor;
 out vec2 TexCoord;
 out float Roundness;
 out vec2 ShapeDimension;
+flat out vec4 Slice;
+flat out vec4 UVDim;
 
-uniform vec2 screenDimension;
+// Per frame constants, binding 0
+layout(std140) uniform FrameData
+{
+	vec2 screenDimension;
+
+	// Pixels per unit of instance position, dimension and clip
+	float instanceUnit;
+};
 
 void main()
 {
-	vec3 pos = position * dimension + instancePos;
+	vec2 instanceDim = dimension.xy * instanceUnit;
+	vec3 pos = vec3(position.xy * instanceDim + instancePos * instanceUnit, 0.0);
 	pos.x = 2.0 * ( pos.x / screenDimension.x) - 1.0;
 	pos.y = 1.0 - 2.0 * ( pos.y / screenDimension.y);
-	pos.z = 1.0 - instancePos.z;
-	ShapeDimension = dimension.xy;
-	Roundness = dimension.z;
+	pos.z = 1.0 - instanceDepth;
+	ShapeDimension = instanceDim;
+	Roundness = dimension.z * instanceUnit;
+	Slice = slice * instanceUnit;
+	UVDim = uvDim;
 
 	gl_Position = vec4( pos, 1.0 );
 	OutColor = color * instanceColor;
-	TexCoord = texCoord * uvDim.zw + uvDim.xy;
+	TexCoord = texCoord;
 }
\ No newline at end of file
@@ -6,7 +6,11 @@ layout (location = 2) in vec4 color;
 out vec4 OutColor;
 out vec2 TexCoord;
 
-uniform vec2 screenDimension;
+// Per frame constants, binding 0
+layout(std140) uniform FrameData
+{
+	vec2 screenDimension;
+};
 
 void main()
 {
@@ -0,0 +1,29 @@
+#version 430
+
+in vec4 OutColor;
+in vec2 TexCoord;
+in vec4 FragPos;
+in vec4 NormalizedCropBox;
+flat in int bCrop;
+flat in int TextureSlot;
+
+out vec4 FragColor;
+
+// Textures of one multi draw, slot comes from draw parameters so it's the same for whole draw
+uniform sampler2D InTextures[16];
+
+void main()
+{
+	float sampled = texture(InTextures[TextureSlot], TexCoord).r;
+	if(sampled <= 0.0) { discard; }
+	if( bCrop != 0 && 
+		( FragPos.x < NormalizedCropBox.x ||
+			FragPos.x > NormalizedCropBox.x + NormalizedCropBox.z ||
+			FragPos.y > NormalizedCropBox.y ||
+			FragPos.y < NormalizedCropBox.y - NormalizedCropBox.w ) )
+	{
+		discard;
+	}
+	
+	FragColor = vec4(OutColor.xyz, OutColor.w * sampled);
+}
\ No newline at end of file
@@ -0,0 +1,72 @@
+#version 430
+#extension GL_ARB_shader_draw_parameters : enable
+layout (location = 0) in vec3 position;
+layout (location = 1) in vec2 texCoord;
+layout (location = 2) in vec4 color;
+layout (location = 3) in vec2 instancePos;
+layout (location = 4) in vec3 dimension;
+layout (location = 5) in vec4 instanceColor;
+layout (location = 6) in vec4 uvDim;
+layout (location = 7) in vec4 clip;
+layout (location = 8) in float instanceDepth;
+
+out vec4 OutColor;
+out vec2 TexCoord;
+out vec4 FragPos;
+out vec4 NormalizedCropBox;
+flat out int bCrop;
+flat out int TextureSlot;
+
+// Per frame constants, binding 0
+layout(std140) uniform FrameData
+{
+	vec2 screenDimension;
+
+	// Pixels per unit of instance position, dimension and clip
+	float instanceUnit;
+};
+
+// Per draw command parameters, indexed by draw id
+struct DrawParams
+{
+	int textureSlot;
+};
+
+layout(std430, binding = 0) readonly buffer DrawParamsBuffer
+{
+	DrawParams drawParams[];
+};
+
+// Index of first command of this multi draw in drawParams
+uniform int drawBase;
+
+#ifdef GL_ARB_shader_draw_parameters
+#define DRAW_ID gl_DrawIDARB
+#else
+#define DRAW_ID gl_DrawID
+#endif
+
+void main()
+{
+	DrawParams params = drawParams[drawBase + DRAW_ID];
+
+	vec2 instanceDim = dimension.xy * instanceUnit;
+	vec3 pos = vec3(position.xy * instanceDim + instancePos * instanceUnit, 0.0);
+	pos.x = 2.0 * (( pos.x ) / screenDimension.x) - 1.0;
+	pos.y = 2.0 * ((pos.y + screenDimension.y) / screenDimension.y) - 1.0;
+	pos.z = 1.0 - instanceDepth;
+
+	OutColor = color * instanceColor;
+	TexCoord = texCoord * uvDim.zw + uvDim.xy;
+	FragPos = vec4( pos, 1.0 );
+	gl_Position = vec4( pos, 1.0 );
+
+	// Crop box comes with each glyph, zero width means no crop
+	vec4 cropBox = clip * instanceUnit;
+	NormalizedCropBox.x = 2.0 * (( cropBox.x ) / screenDimension.x) - 1.0;
+	NormalizedCropBox.y = 2.0 * (( -cropBox.y + screenDimension.y) / screenDimension.y) - 1.0;
+	NormalizedCropBox.z = cropBox.z * 2.0 / screenDimension.x;
+	NormalizedCropBox.w = cropBox.w * 2.0 / screenDimension.y;
+	bCrop = cropBox.z > 0.0 ? 1 : 0;
+	TextureSlot = params.textureSlot;
+}
\ No newline at end of file
@@ -4,18 +4,17 @@ in vec4 OutColor;
 in vec2 TexCoord;
 in vec4 FragPos;
 in vec4 NormalizedCropBox;
+flat in int bCrop;
 
 out vec4 FragColor;
 
 uniform sampler2D InTexture;
 
-uniform bool bCrop;
-
 void main()
 {
 	float sampled = texture(InTexture, TexCoord).r;
 	if(sampled <= 0.0) { discard; }
-	if( bCrop && 
+	if( bCrop != 0 && 
 		( FragPos.x < NormalizedCropBox.x ||
 			FragPos.x > NormalizedCropBox.x + NormalizedCropBox.z ||
 			FragPos.y > NormalizedCropBox.y ||
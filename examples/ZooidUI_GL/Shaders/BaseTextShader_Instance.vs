@@ -2,33 +2,46 @@
 layout (location = 0) in vec3 position;
 layout (location = 1) in vec2 texCoord;
 layout (location = 2) in vec4 color;
-layout (location = 3) in vec3 instancePos;
+layout (location = 3) in vec2 instancePos;
 layout (location = 4) in vec3 dimension;
 layout (location = 5) in vec4 instanceColor;
 layout (location = 6) in vec4 uvDim;
+layout (location = 7) in vec4 clip;
+layout (location = 8) in float instanceDepth;
 
 out vec4 OutColor;
 out vec2 TexCoord;
 out vec4 FragPos;
 out vec4 NormalizedCropBox;
+flat out int bCrop;
 
-uniform vec2 screenDimension;
-uniform vec4 CropBox;
+// Per frame constants, binding 0
+layout(std140) uniform FrameData
+{
+	vec2 screenDimension;
+
+	// Pixels per unit of instance position, dimension and clip
+	float instanceUnit;
+};
 
 void main()
 {
-	vec3 pos = position * dimension + instancePos;
+	vec2 instanceDim = dimension.xy * instanceUnit;
+	vec3 pos = vec3(position.xy * instanceDim + instancePos * instanceUnit, 0.0);
 	pos.x = 2.0 * (( pos.x ) / screenDimension.x) - 1.0;
 	pos.y = 2.0 * ((pos.y + screenDimension.y) / screenDimension.y) - 1.0;
-	pos.z = 1.0 - instancePos.z;
+	pos.z = 1.0 - instanceDepth;
 
 	OutColor = color * instanceColor;
 	TexCoord = texCoord * uvDim.zw + uvDim.xy;
 	FragPos = vec4( pos, 1.0 );
 	gl_Position = vec4( pos, 1.0 );
 
-	NormalizedCropBox.x = 2.0 * (( CropBox.x ) / screenDimension.x) - 1.0;
-	NormalizedCropBox.y = 2.0 * (( -CropBox.y + screenDimension.y) / screenDimension.y) - 1.0;
-	NormalizedCropBox.z = CropBox.z * 2.0 / screenDimension.x;
-	NormalizedCropBox.w = CropBox.w * 2.0 / screenDimension.y;
+	// Crop box comes with each glyph, zero width means no crop
+	vec4 cropBox = clip * instanceUnit;
+	NormalizedCropBox.x = 2.0 * (( cropBox.x ) / screenDimension.x) - 1.0;
+	NormalizedCropBox.y = 2.0 * (( -cropBox.y + screenDimension.y) / screenDimension.y) - 1.0;
+	NormalizedCropBox.z = cropBox.z * 2.0 / screenDimension.x;
+	NormalizedCropBox.w = cropBox.w * 2.0 / screenDimension.y;
+	bCrop = cropBox.z > 0.0 ? 1 : 0;
 }
\ No newline at end of file
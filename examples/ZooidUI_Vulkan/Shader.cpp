@@ -282,7 +282,12 @@ namespace ZE
 		depthStencil.sType = VK_STRUCTURE_TYPE_PIPELINE_DEPTH_STENCIL_STATE_CREATE_INFO;
 		depthStencil.depthTestEnable = VK_TRUE;
 		depthStencil.depthWriteEnable = VK_TRUE;
+#if defined(ZUI_GROUP_PER_TEXTURE)
 		depthStencil.depthCompareOp = VK_COMPARE_OP_LESS;
+#else
+		// Sorted submission order already is draw order, same as GL renderer
+		depthStencil.depthCompareOp = VK_COMPARE_OP_ALWAYS;
+#endif
 		depthStencil.depthBoundsTestEnable = VK_FALSE;
 		depthStencil.minDepthBounds = 0.0f;
 		depthStencil.maxDepthBounds = 1.0f;
@@ -330,7 +335,7 @@ namespace ZE
 		pipelineInfo.pMultisampleState = &multisampling;
 		pipelineInfo.pDepthStencilState = &depthStencil;
 		pipelineInfo.pColorBlendState = &colorBlending;
-		pipelineInfo.pDynamicState = nullptr;
+		pipelineInfo.pDynamicState = &dynamicState;
 		pipelineInfo.layout = m_pipelineLayout;
 		pipelineInfo.renderPass = renderPass;
 		pipelineInfo.subpass = 0;
@@ -4,31 +4,40 @@
 layout (location = 0) in vec3 position;
 layout (location = 1) in vec2 texCoord;
 layout (location = 2) in vec4 color;
-layout (location = 3) in vec3 instancePos;
+layout (location = 3) in vec2 instancePos;
 layout (location = 4) in vec3 dimension;
 layout (location = 5) in vec4 instanceColor;
 layout (location = 6) in vec4 uvDim;
+layout (location = 8) in float instanceDepth;
+layout (location = 9) in vec4 slice;
 
 layout (location=0) out vec4 OutColor;
 layout (location=1) out vec2 TexCoord;
 layout (location=2) out float Roundness;
 layout (location=3) out vec2 ShapeDimension;
+layout (location=4) flat out vec4 Slice;
+layout (location=5) flat out vec4 UVDim;
 
 layout(binding=0) uniform UniformBufferObject {
 	vec2 screenDimension;
+	float instanceUnit;
 } params;
 
 void main()
 {
 	vec2 screenDimension = params.screenDimension;
-	vec3 pos = position * dimension + instancePos;
+	float instanceUnit = params.instanceUnit;
+	vec2 instanceDim = dimension.xy * instanceUnit;
+	vec3 pos = vec3(position.xy * instanceDim + instancePos * instanceUnit, 0.0);
 	pos.x = 2.0 * ( pos.x / screenDimension.x) - 1.0;
 	pos.y = 1.0 - 2.0 * ( pos.y / screenDimension.y);
-	pos.z = 1.0 - instancePos.z;
-	ShapeDimension = dimension.xy;
-	Roundness = dimension.z;
+	pos.z = 1.0 - instanceDepth;
+	ShapeDimension = instanceDim;
+	Roundness = dimension.z * instanceUnit;
+	Slice = slice * instanceUnit;
+	UVDim = uvDim;
 
 	gl_Position = vec4( pos, 1.0 );
 	OutColor = color * instanceColor;
-	TexCoord = texCoord * uvDim.zw + uvDim.xy;
+	TexCoord = texCoord;
 }
\ No newline at end of file
@@ -5,13 +5,40 @@ layout (location=0) in vec4 OutColor;
 layout (location=1) in vec2 TexCoord;
 layout (location=2) in float Roundness;
 layout (location=3) in vec2 ShapeDimension;
+layout (location=4) flat in vec4 Slice;
+layout (location=5) flat in vec4 UVDim;
 
 layout (location=0) out vec4 FragColor;
 
 layout (binding=3) uniform sampler2D InTexture;
 
+// Image coordinate along one axis. Insets keep image scale, middle stretches over the rest.
+float sliceAxis(float coord, float size, float inset0, float inset1, float imageSize)
+{
+	if( coord < inset0 ) { return coord / imageSize; }
+	if( coord > size - inset1 ) { return 1.0 - (size - coord) / imageSize; }
+	float middle = max(size - inset0 - inset1, 0.0001);
+	return (inset0 + (coord - inset0) / middle * (imageSize - inset0 - inset1)) / imageSize;
+}
+
 void main()
 {
-	vec4 sampled = texture(InTexture, TexCoord);
+	vec2 imageCoords = TexCoord;
+	bool isCenter = false;
+	if( Slice != vec4(0.0) )
+	{
+		// Nine slice: Slice holds insets (top, bottom, left, right) in pixels
+		vec2 coords = TexCoord * ShapeDimension;
+		vec2 imageSize = vec2(textureSize(InTexture, 0)) * abs(UVDim.zw);
+		imageCoords.x = sliceAxis(coords.x, ShapeDimension.x, Slice.z, Slice.w, imageSize.x);
+		imageCoords.y = sliceAxis(coords.y, ShapeDimension.y, Slice.x, Slice.y, imageSize.y);
+		isCenter = all(greaterThanEqual(coords, Slice.zx)) && all(lessThanEqual(coords, ShapeDimension - Slice.wy));
+	}
+
+	vec4 sampled = texture(InTexture, imageCoords * UVDim.zw + UVDim.xy);
+
+	// Negative roundness marks border scale, center slice is not drawn
+	if( isCenter && Roundness < 0.0 ) { discard; }
+
 	FragColor = OutColor * sampled;
 }
\ No newline at end of file
@@ -4,32 +4,34 @@
 layout (location = 0) in vec3 position;
 layout (location = 1) in vec2 texCoord;
 layout (location = 2) in vec4 color;
-layout (location = 3) in vec3 instancePos;
+layout (location = 3) in vec2 instancePos;
 layout (location = 4) in vec3 dimension;
 layout (location = 5) in vec4 instanceColor;
 layout (location = 6) in vec4 uvDim;
+layout (location = 7) in vec4 clip;
+layout (location = 8) in float instanceDepth;
 
 layout (location=0) out vec4 OutColor;
 layout (location=1) out vec2 TexCoord;
 layout (location=2) out vec4 FragPos;
 layout (location=3) out vec4 NormalizedCropBox;
+layout (location=4) flat out int bCrop;
 
 layout(binding=0) uniform SharedBufferObject {
 	vec2 screenDimension;
+	float instanceUnit;
 } sharedParams;
 
-layout(binding=1) uniform UniformBufferObject {
-	vec4 CropBox;
-} params;
-
 void main()
 {
 	vec2 screenDimension = sharedParams.screenDimension;
-	vec4 CropBox = params.CropBox;
-	vec3 pos = position * dimension + instancePos;
+	float instanceUnit = sharedParams.instanceUnit;
+	vec4 CropBox = clip * instanceUnit;
+	vec2 instanceDim = dimension.xy * instanceUnit;
+	vec3 pos = vec3(position.xy * instanceDim + instancePos * instanceUnit, 0.0);
 	pos.x = 2.0 * (( pos.x ) / screenDimension.x) - 1.0;
 	pos.y = 2.0 * ((pos.y + screenDimension.y) / screenDimension.y) - 1.0;
-	pos.z = 1.0 - instancePos.z;
+	pos.z = 1.0 - instanceDepth;
 
 	OutColor = color * instanceColor;
 	TexCoord = texCoord * uvDim.zw + uvDim.xy;
@@ -40,4 +42,5 @@ void main()
 	NormalizedCropBox.y = 2.0 * (( -CropBox.y + screenDimension.y) / screenDimension.y) - 1.0;
 	NormalizedCropBox.z = CropBox.z * 2.0 / screenDimension.x;
 	NormalizedCropBox.w = CropBox.w * 2.0 / screenDimension.y;
+	bCrop = CropBox.z > 0.0 ? 1 : 0;
 }
\ No newline at end of file
@@ -10,6 +10,7 @@
 #include <array>
 #include <iostream>
 #include <assert.h>
+#include <math.h>
 #include <algorithm>
 
 #if WIN32 || WIN64
@@ -612,6 +613,11 @@ namespace ZE
 		renderPassInfo.pDependencies = nullptr;
 
 		VK_CHECK_SUCCESS(vkCreateRenderPass(m_device, &renderPassInfo, nullptr, &m_renderPass), "Failed to create render pass!");
+
+		// Compatible render pass keeping previous content of presented image
+		attachments[0].loadOp = VK_ATTACHMENT_LOAD_OP_LOAD;
+		attachments[0].initialLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
+		VK_CHECK_SUCCESS(vkCreateRenderPass(m_device, &renderPassInfo, nullptr, &m_renderPassLoad), "Failed to create load render pass!");
 	}
 
 	void Vulkan_UIRenderer::createCommandPool()
@@ -754,6 +760,7 @@ namespace ZE
 		{
 			SharedUniformBuffer::SharedUniformBufferData& bufferData = m_globalUniformBuffer.getBufferData();
 			bufferData.screenDimension = UIVector2((Float32)m_width, (Float32)m_height);
+			bufferData.instanceUnit = UI::GetRenderInstanceUnit();
 			m_globalUniformBuffer.flush();
 		}
 
@@ -761,6 +768,9 @@ namespace ZE
 		createSwapChainImageViews();
 		createDepthResource();
 		createFrameBuffers();
+
+		// New images have undefined content
+		m_swapChainImageFrames.assign(m_swapChainImages.size(), 0);
 	}
 
 	void Vulkan_UIRenderer::cleanupSwapChain()
@@ -818,10 +828,12 @@ namespace ZE
 		beginInfo.pInheritanceInfo = nullptr;
 		VK_CHECK_SUCCESS(vkBeginCommandBuffer(m_commandBuffers[m_currentSwapChainIndex], &beginInfo), "Failed to begin command buffer!");
 
+		m_bPartialRender = computeImageDamage(m_renderDamageRect);
+
 		// Begin Render Pass
 		VkRenderPassBeginInfo renderPassInfo{};
 		renderPassInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
-		renderPassInfo.renderPass = m_renderPass;
+		renderPassInfo.renderPass = m_bPartialRender ? m_renderPassLoad : m_renderPass;
 		renderPassInfo.framebuffer = m_swapChainFrameBuffers[m_currentSwapChainIndex];
 		renderPassInfo.renderArea.offset = { 0,0 };
 		renderPassInfo.renderArea.extent = m_swapChainExtent;
@@ -835,11 +847,86 @@ namespace ZE
 
 		vkCmdBeginRenderPass(m_commandBuffers[m_currentSwapChainIndex], &renderPassInfo, VK_SUBPASS_CONTENTS_INLINE);
 
+		m_scissor.offset = { 0, 0 };
+		m_scissor.extent = m_swapChainExtent;
+
+		if (m_bPartialRender)
+		{
+			const Int32 left = (Int32)m_renderDamageRect.m_pos.x;
+			const Int32 top = (Int32)m_renderDamageRect.m_pos.y;
+			const Int32 right = (Int32)ceilf(m_renderDamageRect.m_pos.x + m_renderDamageRect.m_dimension.x);
+			const Int32 bottom = (Int32)ceilf(m_renderDamageRect.m_pos.y + m_renderDamageRect.m_dimension.y);
+			m_scissor.offset = { left, top };
+			m_scissor.extent = { (uint32_t)(right - left), (uint32_t)(bottom - top) };
+
+			if (m_scissor.extent.width > 0 && m_scissor.extent.height > 0)
+			{
+				VkClearAttachment clearAttachment{};
+				clearAttachment.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+				clearAttachment.colorAttachment = 0;
+				clearAttachment.clearValue = clearValues[0];
+
+				VkClearRect clearRect{};
+				clearRect.rect = m_scissor;
+				clearRect.baseArrayLayer = 0;
+				clearRect.layerCount = 1;
+				vkCmdClearAttachments(m_commandBuffers[m_currentSwapChainIndex], 1, &clearAttachment, 1, &clearRect);
+			}
+		}
+
 		m_currentBufferIndex = 0;
+		m_bZeroInsetsUsed = false;
 		m_currentVertexUBOIndex = 0;
 		m_currentFragmentUBOIndex = 0;
 		maskCount = 0;
 		m_currentShader = nullptr;
+		m_boundScissor.offset = { -1, -1 };
+		m_boundScissor.extent = { 0, 0 };
+	}
+
+	bool Vulkan_UIRenderer::computeImageDamage(UIRect& outDamageRect)
+	{
+		const UIRect screenRect(UIVector2(0.0f), UIVector2((Float32)m_swapChainExtent.width, (Float32)m_swapChainExtent.height));
+
+		m_frameNumber++;
+		m_damageHistory[m_frameNumber % DamageHistoryCount] = m_drawList->isFullRedraw() ? screenRect : m_drawList->getDamageRect();
+
+		if (m_swapChainImageFrames.size() != m_swapChainImages.size())
+		{
+			m_swapChainImageFrames.assign(m_swapChainImages.size(), 0);
+		}
+
+		// Image still holds the frame it was last rendered with, redraw everything damaged since then
+		const uint64_t imageFrame = m_swapChainImageFrames[m_currentSwapChainIndex];
+		m_swapChainImageFrames[m_currentSwapChainIndex] = m_frameNumber;
+		if (imageFrame == 0 || m_frameNumber - imageFrame > DamageHistoryCount)
+		{
+			return false;
+		}
+
+		UIVector2 minPos(1.0e30f);
+		UIVector2 maxPos(-1.0e30f);
+		for (uint64_t frame = imageFrame + 1; frame <= m_frameNumber; frame++)
+		{
+			const UIRect& damageRect = m_damageHistory[frame % DamageHistoryCount];
+			if (damageRect.m_dimension.x <= 0.0f || damageRect.m_dimension.y <= 0.0f) { continue; }
+
+			minPos.x = UIMIN(minPos.x, damageRect.m_pos.x);
+			minPos.y = UIMIN(minPos.y, damageRect.m_pos.y);
+			maxPos.x = UIMAX(maxPos.x, damageRect.m_pos.x + damageRect.m_dimension.x);
+			maxPos.y = UIMAX(maxPos.y, damageRect.m_pos.y + damageRect.m_dimension.y);
+		}
+
+		if (minPos.x >= maxPos.x)
+		{
+			outDamageRect = UIRect();
+			return true;
+		}
+
+		outDamageRect = UIRect(minPos, maxPos - minPos);
+
+		// Not worth it if almost whole screen has to be redrawn anyway
+		return outDamageRect.m_dimension.x * outDamageRect.m_dimension.y < 0.75f * screenRect.m_dimension.x * screenRect.m_dimension.y;
 	}
 
 	void Vulkan_UIRenderer::endRender()
@@ -978,6 +1065,14 @@ namespace ZE
 			sourceStage = VK_PIPELINE_STAGE_TRANSFER_BIT;
 			destinationStage = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
 		}
+		else if (oldLayout == VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL && newLayout == VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL)
+		{
+			barrier.srcAccessMask = VK_ACCESS_SHADER_READ_BIT;
+			barrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+
+			sourceStage = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
+			destinationStage = VK_PIPELINE_STAGE_TRANSFER_BIT;
+		}
 		else if (oldLayout == VK_IMAGE_LAYOUT_UNDEFINED && newLayout == VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL)
 		{
 			barrier.srcAccessMask = 0;
@@ -1042,7 +1137,7 @@ namespace ZE
 		endSingleTimeCommands(commandBuffer);
 	}
 
-	void Vulkan_UIRenderer::copyBufferToImage(VkBuffer srcBuffer, VkImage dstImage, UInt32 width, UInt32 height)
+	void Vulkan_UIRenderer::copyBufferToImage(VkBuffer srcBuffer, VkImage dstImage, UInt32 width, UInt32 height, Int32 offsetX, Int32 offsetY)
 	{
 		VkCommandBuffer commandBuffer = beginSingleTimeCommands();
 
@@ -1056,7 +1151,7 @@ namespace ZE
 		region.imageSubresource.baseArrayLayer = 0;
 		region.imageSubresource.layerCount = 1;
 
-		region.imageOffset = { 0, 0 };
+		region.imageOffset = { offsetX, offsetY, 0 };
 		region.imageExtent = { width, height, 1 };
 
 		vkCmdCopyBufferToImage(commandBuffer, srcBuffer, dstImage, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region);
@@ -1091,6 +1186,12 @@ namespace ZE
 			}
 		}
 		m_buffers.clear();
+
+		for (VertexBuffer& buffer : m_zeroInsetsBuffers)
+		{
+			buffer.Destroy();
+		}
+		m_zeroInsetsBuffers.clear();
 	}
 
 	VkDescriptorSet Vulkan_UIRenderer::createDescriptorSet(VkDescriptorSetLayout layout)
@@ -1151,9 +1252,16 @@ namespace ZE
 			viewPort.maxDepth = 1.0f;
 			vkCmdSetViewport(commandBuffer, 0, 1, &viewPort);
 
-			VkRect2D scissor{};
-			scissor.offset = { 0, 0 };
-			scissor.extent = m_swapChainExtent;
+			setScissor(commandBuffer, m_scissor);
+		}
+	}
+
+	void Vulkan_UIRenderer::setScissor(VkCommandBuffer commandBuffer, const VkRect2D& scissor)
+	{
+		if (scissor.offset.x != m_boundScissor.offset.x || scissor.offset.y != m_boundScissor.offset.y
+			|| scissor.extent.width != m_boundScissor.extent.width || scissor.extent.height != m_boundScissor.extent.height)
+		{
+			m_boundScissor = scissor;
 			vkCmdSetScissor(commandBuffer, 0, 1, &scissor);
 		}
 	}
@@ -1248,6 +1356,7 @@ namespace ZE
 		
 		// Buffers Pools
 		m_buffers.resize(m_swapChainImageViews.size());
+		m_zeroInsetsBuffers.resize(m_swapChainImageViews.size());
 
 		{
 			UIVertex rectTextArray[6] = { { UIVector2{ 0.0f, 0.0f }, 0.0f, UIVector2{ 0.0f, 1.0f }, UIVector4{ 1.0f, 1.0f, 1.0f, 1.0f } },
@@ -1276,6 +1385,30 @@ namespace ZE
 			vkFreeMemory(m_device, stagingMemory, nullptr);
 		}
 
+		// Quad Index Buffer
+		{
+			UIArray<UInt16> quadIndices(UI::QuadIndexBufferQuads * UI::QuadIndexCount);
+			UI::FillQuadIndices(quadIndices.data(), UI::QuadIndexBufferQuads);
+
+			VkDeviceSize bufferSize = quadIndices.size() * sizeof(UInt16);
+			VkBuffer stagingBuffer;
+			VkDeviceMemory stagingMemory;
+
+			createBuffer(bufferSize, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, stagingBuffer, stagingMemory);
+
+			void *data;
+			vkMapMemory(m_device, stagingMemory, 0, bufferSize, 0, &data);
+			memcpy(data, quadIndices.data(), bufferSize);
+			vkUnmapMemory(m_device, stagingMemory);
+
+			createBuffer(bufferSize, VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, m_quadIndexBuffer, m_quadIndexBufferMemory);
+
+			copyBuffer(stagingBuffer, m_quadIndexBuffer, bufferSize);
+
+			vkDestroyBuffer(m_device, stagingBuffer, nullptr);
+			vkFreeMemory(m_device, stagingMemory, nullptr);
+		}
+
  		glfwGetFramebufferSize(m_window, &width, &height);
 
 		m_width = width;
@@ -1285,6 +1418,7 @@ namespace ZE
 			m_globalUniformBuffer.Init();
 			SharedUniformBuffer::SharedUniformBufferData& bufferData = m_globalUniformBuffer.getBufferData();
 			bufferData.screenDimension = UIVector2((Float32)width, (Float32)height);
+			bufferData.instanceUnit = UI::GetRenderInstanceUnit();
 			m_globalUniformBuffer.flush();
 		}
 
@@ -1312,24 +1446,18 @@ namespace ZE
  		glfwPollEvents();
 		beginRender();
 
-		UIArray<UIDrawItem*> secondPass;
-		for (int i = 0; i < m_drawList->itemCount(); i++)
+		// Draw list is already in submission order
+		const bool bEmptyDamage = m_bPartialRender && (m_scissor.extent.width == 0 || m_scissor.extent.height == 0);
+		for (int i = 0; i < m_drawList->itemCount() && !bEmptyDamage; i++)
 		{
-			UIDrawItem* drawItem = m_drawList->getDrawItem(i);
-			if (drawItem->getLayer() > 0)
+			UIDrawItem* drawItem = m_drawList->getSortedDrawItem(i);
+			if (m_bPartialRender && !m_drawList->needsRedraw(drawItem, m_renderDamageRect))
 			{
-				secondPass.push_back(drawItem);
 				continue;
 			}
 			processDrawItem(drawItem);
 		}
 
-		for (unsigned int i = 0; i < secondPass.size(); i++)
-		{
-			UIDrawItem* drawItem = secondPass[i];
-			processDrawItem(drawItem);
-		}
-
 		endRender();
 		present();
 	}
@@ -1362,6 +1490,22 @@ namespace ZE
 		shader->Use(commandBuffer);
 		BindShader(commandBuffer, shader);
 
+		// Axis aligned mask is item's scissor rect, kept inside damage area
+		VkRect2D scissor = m_scissor;
+		if (drawItem->hasScissor())
+		{
+			const UIScissorRect scissorRect = drawItem->getScissorRect();
+			const Int32 damageRight = m_scissor.offset.x + (Int32)m_scissor.extent.width;
+			const Int32 damageBottom = m_scissor.offset.y + (Int32)m_scissor.extent.height;
+			const Int32 left = scissorRect.x > m_scissor.offset.x ? scissorRect.x : m_scissor.offset.x;
+			const Int32 top = scissorRect.y > m_scissor.offset.y ? scissorRect.y : m_scissor.offset.y;
+			const Int32 right = scissorRect.x + scissorRect.width < damageRight ? scissorRect.x + scissorRect.width : damageRight;
+			const Int32 bottom = scissorRect.y + scissorRect.height < damageBottom ? scissorRect.y + scissorRect.height : damageBottom;
+			scissor.offset = { left, top };
+			scissor.extent = { (uint32_t)(right > left ? right - left : 0), (uint32_t)(bottom > top ? bottom - top : 0) };
+		}
+		setScissor(commandBuffer, scissor);
+
 		if (drawItem->isDrawMask())
 		{
 			VulkanFunctions::vkCmdSetStencilTestEnableEXT(commandBuffer, VK_TRUE);
@@ -1409,8 +1553,8 @@ namespace ZE
 			m_nullVertexUBO.bind(descriptorSet, 1);
 		}
 
-		// Bind fragment UBO
-		if ((drawItem->getTextureHandle() == 0 && !isUsingRect) || (isFont && isUsingRect))
+		// Bind fragment UBO, instanced text has crop box per glyph
+		if (drawItem->getTextureHandle() == 0 && !isUsingRect)
 		{
 			FragmentUniformBuffer* fragmentUbo = getOrCreateNextFragmentUniformBuffer();
 			FragmentUniformBuffer::FragmentUniformBufferData& data = fragmentUbo->getBufferData();
@@ -1437,6 +1581,7 @@ namespace ZE
 		if (isInstance)
 		{
 			VertexBuffer* instanceBuffer = setInstanceDrawData(drawItem->getInstances());
+			VertexBuffer* instanceInsetsBuffer = setInstanceInsetsData(drawItem->getInstanceInsets(), drawItem->getInstances().size());
 			if (isFont)
 			{
 				vkCmdBindVertexBuffers(commandBuffer, 0, 1, &m_rectTextBuffer, offsets);
@@ -1446,6 +1591,7 @@ namespace ZE
 				vkCmdBindVertexBuffers(commandBuffer, 0, 1, &m_rectBuffer, offsets);
 			}
 			instanceBuffer->bindForRendering(commandBuffer, 1);
+			instanceInsetsBuffer->bindForRendering(commandBuffer, 2);
 
 			vkCmdDraw(commandBuffer, 6, static_cast<uint32_t>(drawItem->getInstances().size()), 0, 0);
 		}
@@ -1453,7 +1599,18 @@ namespace ZE
 		{
 			VertexBuffer* vertexBuffer = setDrawData(drawItem->getVertices());
 			vertexBuffer->bindForRendering(commandBuffer, 0);
-			vkCmdDraw(commandBuffer, static_cast<uint32_t>(drawItem->getVertices().size()), 1, 0, 0);
+			vkCmdBindIndexBuffer(commandBuffer, m_quadIndexBuffer, 0, VK_INDEX_TYPE_UINT16);
+
+			// Index buffer only covers QuadIndexBufferQuads quads, longer lists continue from a vertex offset
+			UInt32 quadCount = static_cast<UInt32>(drawItem->getVertices().size() / 4);
+			int32_t vertexOffset = 0;
+			while (quadCount > 0)
+			{
+				const UInt32 chunkQuads = quadCount < UI::QuadIndexBufferQuads ? quadCount : UI::QuadIndexBufferQuads;
+				vkCmdDrawIndexed(commandBuffer, chunkQuads * UI::QuadIndexCount, 1, 0, vertexOffset, 0);
+				vertexOffset += chunkQuads * 4;
+				quadCount -= chunkQuads;
+			}
 		}
 
 		if (drawItem->isDrawMask())
@@ -1544,6 +1701,9 @@ namespace ZE
 		vkDestroyBuffer(m_device, m_rectBuffer, nullptr);
 		vkFreeMemory(m_device, m_rectBufferMemory, nullptr);
 
+		vkDestroyBuffer(m_device, m_quadIndexBuffer, nullptr);
+		vkFreeMemory(m_device, m_quadIndexBufferMemory, nullptr);
+
 		destroyAllInstanceBuffers();
 
 		cleanupSwapChain();
@@ -1551,6 +1711,7 @@ namespace ZE
 		vkDestroyCommandPool(m_device, m_commandPool, nullptr);
 
 		vkDestroyRenderPass(m_device, m_renderPass, nullptr);
+		vkDestroyRenderPass(m_device, m_renderPassLoad, nullptr);
 
 		vkDestroyDevice(m_device, nullptr);
 
@@ -1590,6 +1751,12 @@ namespace ZE
 		return idx+1;
 	}
 
+	bool Vulkan_UIRenderer::updateRendererTexture(UInt32 textureHandle, void* pAddress, UInt32 x, UInt32 y, UInt32 width, UInt32 height, UInt32 channelCount)
+	{
+		m_textures[textureHandle-1]->Update(pAddress, x, y, width, height, channelCount);
+		return true;
+	}
+
 	void Vulkan_UIRenderer::destroyTexture(UInt32 textureHandle)
 	{
 		m_textures[textureHandle-1]->Destroy();
@@ -1613,6 +1780,28 @@ namespace ZE
 		recreateSwapChain();
 	}
 
+	void Vulkan_UIRenderer::pollEvents()
+	{
+		glfwPollEvents();
+	}
+
+	void Vulkan_UIRenderer::waitEvents(Float32 timeoutMS)
+	{
+		if (timeoutMS < 0.0f)
+		{
+			glfwWaitEvents();
+		}
+		else
+		{
+			glfwWaitEventsTimeout(timeoutMS / 1000.0);
+		}
+	}
+
+	void Vulkan_UIRenderer::postEmptyEvent()
+	{
+		glfwPostEmptyEvent();
+	}
+
 	VertexBuffer* Vulkan_UIRenderer::setDrawData(const UIArray<UIVertex>& vertices)
 	{
 		VkDeviceSize bufferSize = sizeof(UIVertex) * vertices.size();
@@ -1631,9 +1820,37 @@ namespace ZE
 
 	VertexBuffer* Vulkan_UIRenderer::setInstanceDrawData(const UIArray<UIDrawInstance>& instances)
 	{
-		VkDeviceSize bufferSize = sizeof(UIDrawInstance) * instances.size();
+		VkDeviceSize bufferSize = sizeof(UIRenderInstance) * instances.size();
+		VertexBuffer* vertexBuffer = getOrCreateNextVertexBuffer(bufferSize);
+		vertexBuffer->copyData((void*)UI::GetRenderInstances(instances, m_instancePackBuffer), bufferSize);
+		return vertexBuffer;
+	}
+
+	VertexBuffer* Vulkan_UIRenderer::setInstanceInsetsData(const UIArray<UIInstanceInsets>& instanceInsets, size_t instanceCount)
+	{
+		VkDeviceSize bufferSize = sizeof(UIRenderInstanceInsets) * instanceCount;
+		if (instanceInsets.size() == 0)
+		{
+			// Most items have no insets, they share zeroed buffer sized for largest item seen
+			m_zeroInsetsCount = instanceCount > m_zeroInsetsCount ? instanceCount : m_zeroInsetsCount;
+			VertexBuffer& zeroBuffer = m_zeroInsetsBuffers[m_currentSwapChainIndex];
+			const VkDeviceSize zeroBufferSize = sizeof(UIRenderInstanceInsets) * m_zeroInsetsCount;
+			if (!m_bZeroInsetsUsed && zeroBuffer.getSize() < zeroBufferSize)
+			{
+				zeroBuffer.Init(zeroBufferSize);
+				zeroBuffer.copyData((void*)UI::GetRenderInstanceInsets(instanceInsets, m_zeroInsetsCount, m_instanceInsetsPackBuffer), zeroBufferSize);
+			}
+
+			m_bZeroInsetsUsed = true;
+			if (zeroBuffer.getSize() >= bufferSize)
+			{
+				return &zeroBuffer;
+			}
+		}
+
+		// Zero insets of items larger than shared buffer go in per draw buffer too
 		VertexBuffer* vertexBuffer = getOrCreateNextVertexBuffer(bufferSize);
-		vertexBuffer->copyData((void*)instances.data(), bufferSize);
+		vertexBuffer->copyData((void*)UI::GetRenderInstanceInsets(instanceInsets, instanceCount, m_instanceInsetsPackBuffer), bufferSize);
 		return vertexBuffer;
 	}
 
@@ -1673,23 +1890,27 @@ namespace ZE
 		return attributeDescriptions;
 	}
 
-	std::array<VkVertexInputBindingDescription, 2> DrawInstanceHelper::GetBindingDescriptions()
+	std::array<VkVertexInputBindingDescription, 3> DrawInstanceHelper::GetBindingDescriptions()
 	{
-		std::array<VkVertexInputBindingDescription, 2> bindingDescriptons;
+		std::array<VkVertexInputBindingDescription, 3> bindingDescriptons;
 		// Vertex binding
 		bindingDescriptons[0].binding = 0;
 		bindingDescriptons[0].stride = sizeof(UIVertex);
 		bindingDescriptons[0].inputRate = VK_VERTEX_INPUT_RATE_VERTEX;
 		// Instance binding
 		bindingDescriptons[1].binding = 1;
-		bindingDescriptons[1].stride = sizeof(UIDrawInstance);
+		bindingDescriptons[1].stride = sizeof(UIRenderInstance);
 		bindingDescriptons[1].inputRate = VK_VERTEX_INPUT_RATE_INSTANCE;
+		// Instance insets binding, separate so plain instances stay small
+		bindingDescriptons[2].binding = 2;
+		bindingDescriptons[2].stride = sizeof(UIRenderInstanceInsets);
+		bindingDescriptons[2].inputRate = VK_VERTEX_INPUT_RATE_INSTANCE;
 		return bindingDescriptons;
 	}
 
-	std::array<VkVertexInputAttributeDescription, 7> DrawInstanceHelper::GetAttributeDescriptions()
+	std::array<VkVertexInputAttributeDescription, 10> DrawInstanceHelper::GetAttributeDescriptions()
 	{
-		std::array<VkVertexInputAttributeDescription, 7> attributeDescriptions;
+		std::array<VkVertexInputAttributeDescription, 10> attributeDescriptions;
 		// Pos
 		attributeDescriptions[0].binding = 0;
 		attributeDescriptions[0].location = 0;
@@ -1705,26 +1926,57 @@ namespace ZE
 		attributeDescriptions[2].location = 2;
 		attributeDescriptions[2].format = VK_FORMAT_R32G32B32_SFLOAT;
 		attributeDescriptions[2].offset = offsetof(UIVertex, color);
+#if defined(ZUI_USE_PACKED_INSTANCES)
+		// Packed instance: scaled ints become floats in instance unit, shaders multiply by instanceUnit
+		const VkFormat posFormat = VK_FORMAT_R16G16_SSCALED;
+		const VkFormat dimensionFormat = VK_FORMAT_R16G16B16A16_SSCALED;
+		const VkFormat colorFormat = VK_FORMAT_R8G8B8A8_UNORM;
+		const VkFormat uvFormat = VK_FORMAT_R16G16B16A16_SNORM;
+		const VkFormat clipFormat = VK_FORMAT_R16G16B16A16_SSCALED;
+		const VkFormat insetsFormat = VK_FORMAT_R16G16B16A16_SSCALED;
+#else
+		const VkFormat posFormat = VK_FORMAT_R32G32_SFLOAT;
+		const VkFormat dimensionFormat = VK_FORMAT_R32G32B32_SFLOAT;
+		const VkFormat colorFormat = VK_FORMAT_R32G32B32A32_SFLOAT;
+		const VkFormat uvFormat = VK_FORMAT_R32G32B32A32_SFLOAT;
+		const VkFormat clipFormat = VK_FORMAT_R32G32B32A32_SFLOAT;
+		const VkFormat insetsFormat = VK_FORMAT_R32G32B32A32_SFLOAT;
+#endif
 		// instancePos
 		attributeDescriptions[3].binding = 1;
 		attributeDescriptions[3].location = 3;
-		attributeDescriptions[3].format = VK_FORMAT_R32G32B32_SFLOAT;
-		attributeDescriptions[3].offset = offsetof(UIDrawInstance, pos);
+		attributeDescriptions[3].format = posFormat;
+		attributeDescriptions[3].offset = offsetof(UIRenderInstance, pos);
 		// dimension
 		attributeDescriptions[4].binding = 1;
 		attributeDescriptions[4].location = 4;
-		attributeDescriptions[4].format = VK_FORMAT_R32G32B32_SFLOAT;
-		attributeDescriptions[4].offset = offsetof(UIDrawInstance, dimension);
+		attributeDescriptions[4].format = dimensionFormat;
+		attributeDescriptions[4].offset = offsetof(UIRenderInstance, dimension);
 		// instanceColor
 		attributeDescriptions[5].binding = 1;
 		attributeDescriptions[5].location = 5;
-		attributeDescriptions[5].format = VK_FORMAT_R32G32B32A32_SFLOAT;
-		attributeDescriptions[5].offset = offsetof(UIDrawInstance, color);
+		attributeDescriptions[5].format = colorFormat;
+		attributeDescriptions[5].offset = offsetof(UIRenderInstance, color);
 		// uvDim
 		attributeDescriptions[6].binding = 1;
 		attributeDescriptions[6].location = 6;
-		attributeDescriptions[6].format = VK_FORMAT_R32G32B32A32_SFLOAT;
-		attributeDescriptions[6].offset = offsetof(UIDrawInstance, uvDim);
+		attributeDescriptions[6].format = uvFormat;
+		attributeDescriptions[6].offset = offsetof(UIRenderInstance, uvDim);
+		// clip
+		attributeDescriptions[7].binding = 1;
+		attributeDescriptions[7].location = 7;
+		attributeDescriptions[7].format = clipFormat;
+		attributeDescriptions[7].offset = offsetof(UIRenderInstance, clip);
+		// instanceDepth
+		attributeDescriptions[8].binding = 1;
+		attributeDescriptions[8].location = 8;
+		attributeDescriptions[8].format = VK_FORMAT_R32_SFLOAT;
+		attributeDescriptions[8].offset = offsetof(UIRenderInstance, depth);
+		// instanceInsets
+		attributeDescriptions[9].binding = 2;
+		attributeDescriptions[9].location = 9;
+		attributeDescriptions[9].format = insetsFormat;
+		attributeDescriptions[9].offset = 0;
 		return attributeDescriptions;
 	}
 
@@ -1833,6 +2085,7 @@ namespace ZE
 			imageFormat = VK_FORMAT_R8G8B8A8_UNORM;
 			break;
 		}
+		m_format = imageFormat;
 		gVulkanRenderer->createImage(width, height, 1, VK_SAMPLE_COUNT_1_BIT, imageFormat,
 			VK_IMAGE_TILING_OPTIMAL, VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, m_image, m_imageMemory);
 
@@ -1846,6 +2099,29 @@ namespace ZE
 		m_imageView = gVulkanRenderer->createImageView(m_image, imageFormat, VK_IMAGE_ASPECT_COLOR_BIT, 1);
 	}
 
+	void VulkanTexture::Update(void* pData, UInt32 x, UInt32 y, UInt32 width, UInt32 height, UInt32 channelCount)
+	{
+		VkDeviceSize imageSize = width * height * channelCount;
+
+		VkBuffer stagingBuffer;
+		VkDeviceMemory stagingMemory;
+
+		gVulkanRenderer->createBuffer(imageSize, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, stagingBuffer, stagingMemory);
+
+		void* data;
+		vkMapMemory(gVulkanRenderer->m_device, stagingMemory, 0, imageSize, 0, &data);
+		memcpy(data, pData, imageSize);
+		vkUnmapMemory(gVulkanRenderer->m_device, stagingMemory);
+
+		// Barrier is on the same queue as submitted frames, so their reads finish before the copy
+		gVulkanRenderer->transitionImageLayout(m_image, m_format, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1);
+		gVulkanRenderer->copyBufferToImage(stagingBuffer, m_image, width, height, x, y);
+		gVulkanRenderer->transitionImageLayout(m_image, m_format, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, 1);
+
+		vkDestroyBuffer(gVulkanRenderer->m_device, stagingBuffer, nullptr);
+		vkFreeMemory(gVulkanRenderer->m_device, stagingMemory, nullptr);
+	}
+
 	void VulkanTexture::Destroy()
 	{
 		vkDestroyImageView(gVulkanRenderer->m_device, m_imageView, nullptr);
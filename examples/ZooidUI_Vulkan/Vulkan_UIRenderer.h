@@ -33,8 +33,8 @@ namespace ZE
 
 	namespace DrawInstanceHelper
 	{
-		std::array<VkVertexInputBindingDescription, 2> GetBindingDescriptions();
-		std::array<VkVertexInputAttributeDescription, 7> GetAttributeDescriptions();
+		std::array<VkVertexInputBindingDescription, 3> GetBindingDescriptions();
+		std::array<VkVertexInputAttributeDescription, 10> GetAttributeDescriptions();
 	}
 
 	class VertexBuffer
@@ -77,7 +77,8 @@ namespace ZE
 		struct SharedUniformBufferData
 		{
 			UIVector2 screenDimension;
-			UIVector2 pad;
+			Float32 instanceUnit;
+			Float32 pad;
 		};
 
 		virtual void* getData() const { return (void*)(&m_data); }
@@ -126,6 +127,7 @@ namespace ZE
 	{
 	public:
 		void Init(void* pData, UInt32 width, UInt32 height, UInt32 channelCount);
+		void Update(void* pData, UInt32 x, UInt32 y, UInt32 width, UInt32 height, UInt32 channelCount);
 		void Destroy();
 
 		void bind(VkDescriptorSet descriptorSet, uint32_t binding);
@@ -134,6 +136,7 @@ namespace ZE
 		VkImage m_image = VK_NULL_HANDLE;
 		VkDeviceMemory m_imageMemory;
 		VkImageView m_imageView;
+		VkFormat m_format;
 	};
 
 	class Vulkan_UIRenderer : public UIRenderer
@@ -152,9 +155,13 @@ namespace ZE
 		virtual bool requestToClose() override;
 		virtual UInt32 createRendererTexture(void* pAddress, UInt32 width, UInt32 height, UInt32 channelCount) override;
 		virtual void destroyTexture(UInt32 textureHandle);
+		virtual bool updateRendererTexture(UInt32 textureHandle, void* pAddress, UInt32 x, UInt32 y, UInt32 width, UInt32 height, UInt32 channelCount) override;
 		virtual void destroyTextures();
 		virtual void* getWindowContext() override { return m_window; }
 		virtual void resizeWindow(int width, int height);
+		virtual void pollEvents() override;
+		virtual void waitEvents(Float32 timeoutMS) override;
+		virtual void postEmptyEvent() override;
 
 	private:
 		void createVulkanInstance();
@@ -175,6 +182,7 @@ namespace ZE
 		void cleanupSwapChain();
 
 		void beginRender();
+		bool computeImageDamage(UIRect& outDamageRect);
 		void endRender();
 		void present();
 
@@ -194,7 +202,7 @@ namespace ZE
 
 		void createBuffer(VkDeviceSize size, VkBufferUsageFlags usage, VkMemoryPropertyFlags properties, VkBuffer& buffer, VkDeviceMemory& bufferMemory);
 		void copyBuffer(VkBuffer srcBuffer, VkBuffer dstBuffer, VkDeviceSize size);
-		void copyBufferToImage(VkBuffer srcBuffer, VkImage dstImage, UInt32 width, UInt32 height);
+		void copyBufferToImage(VkBuffer srcBuffer, VkImage dstImage, UInt32 width, UInt32 height, Int32 offsetX = 0, Int32 offsetY = 0);
 
 
 		VertexBuffer* getOrCreateNextVertexBuffer(VkDeviceSize size);
@@ -208,9 +216,13 @@ namespace ZE
 
 	protected:
 
+		// Only records scissor command when rect is different from bound one
+		void setScissor(VkCommandBuffer commandBuffer, const VkRect2D& scissor);
+
 		VertexBuffer* setDrawData(const UIArray<UIVertex>& vertices);
 		VertexBuffer* setTextData(const UIArray<UIVertex>& vertices);
 		VertexBuffer* setInstanceDrawData(const UIArray<UIDrawInstance>& instances);
+		VertexBuffer* setInstanceInsetsData(const UIArray<UIInstanceInsets>& instanceInsets, size_t instanceCount);
 		void processDrawItem(UIDrawItem* drawItem);
 		void pushMask();
 		void popMask();
@@ -245,6 +257,9 @@ namespace ZE
 
 		VkRenderPass m_renderPass;
 
+		// Same as m_renderPass but keeps swap chain image content, for partial redraw
+		VkRenderPass m_renderPassLoad;
+
 		VkCommandPool m_commandPool;
 
 		VkImage m_depthImage;
@@ -262,16 +277,39 @@ namespace ZE
 
 		Shader* m_currentShader;
 
+		// Partial redraw: damage of recent frames, so swap chain image rendered few frames ago can be brought up to date
+		static const UInt32 DamageHistoryCount = 8;
+		UIRect m_damageHistory[DamageHistoryCount];
+		uint64_t m_frameNumber = 0;
+		std::vector<uint64_t> m_swapChainImageFrames;
+		bool m_bPartialRender = false;
+		UIRect m_renderDamageRect;
+		VkRect2D m_scissor;
+		VkRect2D m_boundScissor;
+
 		VkBuffer m_rectBuffer;
 		VkDeviceMemory m_rectBufferMemory;
 
 		VkBuffer m_rectTextBuffer;
 		VkDeviceMemory m_rectTextBufferMemory;
 
+		// Static quad index buffer for vertex path draws
+		VkBuffer m_quadIndexBuffer;
+		VkDeviceMemory m_quadIndexBufferMemory;
+
 		// VertexBuffers
 		size_t m_currentBufferIndex = 0;
 		std::vector<std::vector<VertexBuffer>> m_buffers;
 
+		// Instances converted to upload format, reused every draw
+		UIArray<UIRenderInstance> m_instancePackBuffer;
+		UIArray<UIRenderInstanceInsets> m_instanceInsetsPackBuffer;
+
+		// Zero insets per swap chain image, bound for instances without insets. Only grows before its first use in a frame.
+		std::vector<VertexBuffer> m_zeroInsetsBuffers;
+		size_t m_zeroInsetsCount = 0;
+		bool m_bZeroInsetsUsed = false;
+
 		// UniformBuffers
 		SharedUniformBuffer m_globalUniformBuffer;
 		VertexUniformBuffer m_nullVertexUBO;